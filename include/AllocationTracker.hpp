@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Heap allocation accounting.
+ *
+ * Configure with -DGREEDY_TANGLE_TRACK_ALLOCATIONS=ON to replace the global
+ * operator new / delete with counting versions. Every allocation is then
+ * charged to the innermost AllocScope on the calling thread (and to each
+ * enclosing scope), and to that scope's tag in a process-wide table.
+ *
+ * Off by default: the counting allocator adds a header to every block and
+ * a few atomic adds to every new / delete. With tracking compiled out,
+ * AllocScope is an empty object and every counter reads zero.
+ */
+#ifndef GREEDY_TANGLE_ALLOC_TRACKING
+#define GREEDY_TANGLE_ALLOC_TRACKING 0
+#endif
+
+namespace GreedyTangle {
+
+enum class AllocTag : uint8_t {
+  UNTAGGED,
+  SOLVER_SEARCH,  // Inside FindBestMove
+  FRAME_UPDATE,   // Input, CPU race and game-state updates
+  FRAME_RENDER,   // Render()
+  BACKGROUND_JOB, // Thread pool tasks outside any solver search
+  COUNT
+};
+
+const char *AllocTagName(AllocTag tag);
+
+/**
+ * AllocCounters - Plain copy of a scope's or tag's counters
+ *
+ * peakBytes is the high-water mark of bytes allocated minus bytes freed
+ * inside the scope, so memory handed out and released within one search
+ * shows up even though nothing is live when it returns.
+ */
+struct AllocCounters {
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+  uint64_t bytes = 0; // Total requested, not net
+  uint64_t peakBytes = 0;
+
+  AllocCounters operator-(const AllocCounters &other) const {
+    AllocCounters d;
+    d.allocations = allocations - other.allocations;
+    d.frees = frees - other.frees;
+    d.bytes = bytes - other.bytes;
+    d.peakBytes = peakBytes; // A high-water mark does not subtract
+    return d;
+  }
+};
+
+class AllocationTracker {
+public:
+  static constexpr bool IsEnabled() { return GREEDY_TANGLE_ALLOC_TRACKING; }
+
+  // Process-wide totals for one tag since startup; frees are charged to
+  // the tag open when they happen, and peakBytes is not tracked per tag
+  static AllocCounters TagTotals(AllocTag tag);
+
+  // Allocations made by the calling thread since it started
+  static uint64_t ThreadAllocations();
+};
+
+#if GREEDY_TANGLE_ALLOC_TRACKING
+
+/**
+ * AllocScope - Charges allocations on this thread to a tag for its lifetime
+ *
+ * Scopes nest; an allocation counts toward every open scope on the thread.
+ * Counters are atomic because AllocScopeAdopt lets pool workers charge a
+ * scope that lives on another thread.
+ */
+class AllocScope {
+public:
+  explicit AllocScope(AllocTag tag);
+  ~AllocScope();
+
+  AllocScope(const AllocScope &) = delete;
+  AllocScope &operator=(const AllocScope &) = delete;
+
+  AllocCounters Counters() const;
+  AllocTag Tag() const { return tag_; }
+
+  // Innermost open scope on the calling thread, or null
+  static AllocScope *Current();
+
+private:
+  friend struct AllocationHooks;
+
+  void RecordAllocation(uint64_t size);
+  void RecordFree(uint64_t size);
+
+  AllocTag tag_;
+  AllocScope *parent_;
+  std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> frees_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<int64_t> liveBytes_{0};
+  std::atomic<uint64_t> peakBytes_{0};
+};
+
+/**
+ * AllocScopeAdopt - Makes another thread's scope current for a lifetime
+ *
+ * For work run on behalf of a caller that blocks until it finishes, such
+ * as ThreadPool::ParallelFor helpers. The adopted scope must outlive this.
+ */
+class AllocScopeAdopt {
+public:
+  explicit AllocScopeAdopt(AllocScope *scope);
+  ~AllocScopeAdopt();
+
+  AllocScopeAdopt(const AllocScopeAdopt &) = delete;
+  AllocScopeAdopt &operator=(const AllocScopeAdopt &) = delete;
+
+private:
+  AllocScope *previous_;
+};
+
+#else
+
+class AllocScope {
+public:
+  explicit AllocScope(AllocTag) {}
+
+  AllocCounters Counters() const { return {}; }
+  AllocTag Tag() const { return AllocTag::UNTAGGED; }
+  static AllocScope *Current() { return nullptr; }
+};
+
+class AllocScopeAdopt {
+public:
+  explicit AllocScopeAdopt(AllocScope *) {}
+};
+
+#endif
+
+} // namespace GreedyTangle
+
+#if GREEDY_TANGLE_ALLOC_TRACKING
+#define GT_ALLOC_CONCAT_INNER(a, b) a##b
+#define GT_ALLOC_CONCAT(a, b) GT_ALLOC_CONCAT_INNER(a, b)
+#define GT_ALLOC_SCOPE(tag)                                                   \
+  ::GreedyTangle::AllocScope GT_ALLOC_CONCAT(gtAllocScope_, __LINE__)(tag)
+#else
+#define GT_ALLOC_SCOPE(tag) ((void)0)
+#endif
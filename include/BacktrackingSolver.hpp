@@ -2,6 +2,7 @@
 
 #include "ICPUSolver.hpp"
 #include "CPUController.hpp"
+#include <memory_resource>
 #include <vector>
 
 namespace GreedyTangle {
@@ -10,10 +11,9 @@ class BacktrackingSolver : public ICPUSolver {
 public:
   static constexpr float GRID_SPACING = 50.0f;
   static constexpr float MARGIN = 60.0f;
-  static constexpr float WINDOW_WIDTH = 1024.0f;
-  static constexpr float WINDOW_HEIGHT = 768.0f;
   static constexpr int MAX_DEPTH = 3;
   static constexpr int MAX_EVALUATIONS = 100000;
+  static constexpr int PROGRESS_INTERVAL = 256; // Candidates between updates
 
   BacktrackingSolver() = default;
 
@@ -32,17 +32,27 @@ private:
     Vec2 position;
   };
 
-  std::vector<Vec2> GenerateCandidatePositions(int node_id,
-                                               const std::vector<Node> &nodes);
+  // One reusable candidate list per search depth, plus one for the fallback
+  using CandidateBuffers = std::pmr::vector<std::pmr::vector<Vec2>>;
+
+  // Replaces the contents of candidates
+  void GenerateCandidatePositions(int node_id, const std::vector<Node> &nodes,
+                                  std::pmr::vector<Vec2> &candidates);
 
   void Backtrack(std::vector<Node> &nodes,
                  const std::vector<Edge> &edges,
                  int depth,
                  int currentIntersections,
                  int &bestIntersections,
-                 MoveCandidate &bestFirstMove);
+                 MoveCandidate &bestFirstMove,
+                 CandidateBuffers &buffers);
 
   int lastCandidatesEvaluated_ = 0;
+  Rect canvas_ = DEFAULT_CANVAS; // From the graph at the start of a search
+  float gridSpacing_ = GRID_SPACING;
+
+  // Kernel-level entry points for greedy_tangle_microbench
+  friend struct MicrobenchAccess;
 };
 
 }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "ICPUSolver.hpp"
+#include "PuzzleGenerator.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * Distribution - mean / median / p95 summary of one metric over trials
+ */
+struct Distribution {
+  int samples = 0;
+  double mean = 0.0;
+  double median = 0.0;
+  double p95 = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+
+  static Distribution From(std::vector<double> values);
+
+  // {"samples": n, "mean": ..., "median": ..., "p95": ..., "min": ..., "max": ...}
+  void WriteJSON(std::ostream &out) const;
+};
+
+/**
+ * BenchmarkTrial - One solver run to completion on one generated puzzle
+ */
+struct BenchmarkTrial {
+  SolverMode mode = SolverMode::GREEDY;
+  std::string solverName;
+  PuzzleFamily family = PuzzleFamily::CYCLE_CHORDS;
+  uint32_t seed = 0;
+  int nodeCount = 0;
+  int edgeCount = 0;
+  bool completed = false; // False if the sweep deadline passed before it ran
+  bool cutOff = false;    // Stopped by a time limit or cancellation
+  int moves = 0;
+  int searches = 0;       // Completed FindBestMove calls, fruitless ones too
+  double timeMs = 0.0;
+  double searchMs = 0.0;  // Wall time inside those completed searches
+  int initialIntersections = 0;
+  int finalIntersections = 0;
+  bool solved = false;
+  uint64_t candidatesEvaluated = 0;
+  uint64_t pairTests = 0;
+  double evalsPerSecond = 0.0;
+  double pairTestsPerSecond = 0.0;
+  uint64_t allocations = 0;    // Heap allocations inside the searches
+  uint64_t allocatedBytes = 0; // (zero unless allocation tracking is on)
+  uint64_t peakBytes = 0;      // Largest single-search high-water mark
+  std::vector<int> intersectionHistory; // Crossings after each move
+
+  double MsPerSearch() const {
+    return searches > 0 ? searchMs / searches : 0.0;
+  }
+
+  double AllocationsPerSearch() const {
+    return searches > 0 ? static_cast<double>(allocations) / searches : 0.0;
+  }
+};
+
+/**
+ * BenchmarkAggregate - Per-solver summary across every completed trial
+ */
+struct BenchmarkAggregate {
+  SolverMode mode = SolverMode::GREEDY;
+  std::string solverName;
+  int trials = 0;
+  int solvedTrials = 0;
+  Distribution timeMs;
+  Distribution moves;
+  Distribution finalIntersections;
+  Distribution evalsPerSecond;
+  Distribution pairTestsPerSecond;
+  Distribution allocationsPerSearch;
+  uint64_t candidatesEvaluated = 0; // Summed over trials
+  uint64_t pairTests = 0;
+  uint64_t peakBytes = 0; // Largest over trials
+};
+
+struct BenchmarkConfig {
+  std::vector<SolverMode> modes = {SolverMode::GREEDY, SolverMode::BACKTRACKING,
+                                   SolverMode::DIVIDE_AND_CONQUER_DP};
+  std::vector<PuzzleFamily> families = {PuzzleFamily::CYCLE_CHORDS,
+                                        PuzzleFamily::GRID_MESH,
+                                        PuzzleFamily::TRIANGULATION};
+  std::vector<uint32_t> seeds = {1, 2, 3, 4, 5};
+  int nodeCount = 15;
+  int maxMoves = 100;
+  float trialTimeLimit = 10.0f; // Seconds per trial
+  float sweepTimeLimit = 30.0f; // Seconds for the whole sweep; 0 = none
+  std::atomic<bool> *cancelFlag = nullptr;
+  ThreadPool *solverPool = nullptr; // Lets each search fan out; null = serial
+};
+
+/**
+ * BenchmarkRunner - Runs solver x seed x family trials concurrently
+ *
+ * Every trial owns its solver and a private copy of a shared, read-only
+ * puzzle, so trials run as independent pool tasks. Trials are queued
+ * seed-major, so if the sweep deadline cuts the run short every solver and
+ * family still has the same number of samples (give or take one seed).
+ */
+class BenchmarkRunner {
+public:
+  explicit BenchmarkRunner(ThreadPool &pool) : pool_(pool) {}
+
+  std::vector<BenchmarkTrial> Run(const BenchmarkConfig &config);
+
+  /**
+   * Summarize completed trials per solver, in config.modes order
+   */
+  static std::vector<BenchmarkAggregate>
+  Aggregate(const std::vector<BenchmarkTrial> &trials,
+            const std::vector<SolverMode> &modes);
+
+  /**
+   * Solve one puzzle greedily move by move until solved, stuck, or out of
+   * moves/time. deadlineNs is an absolute steady_clock time (0 = none).
+   */
+  static BenchmarkTrial RunTrial(SolverMode mode, const Puzzle &puzzle,
+                                 const BenchmarkConfig &config,
+                                 int64_t deadlineNs = 0);
+
+  // One row per trial, skipped trials included
+  static bool WriteCSV(const std::vector<BenchmarkTrial> &trials,
+                       std::ostream &out);
+  // Config, per-solver aggregates and every trial
+  static bool WriteJSON(const BenchmarkConfig &config,
+                        const std::vector<BenchmarkTrial> &trials,
+                        const std::vector<BenchmarkAggregate> &aggregates,
+                        std::ostream &out);
+
+private:
+  ThreadPool &pool_;
+};
+
+} // namespace GreedyTangle
@@ -30,9 +30,18 @@ struct CPUMove {
  *
  * Stores all moves made by the CPU so the game can be replayed
  * step-by-step using Next/Back/Play controls.
+ *
+ * Every KEYFRAME_INTERVAL moves form a block, and each block keeps a
+ * delta keyframe: the nodes its moves touched with their positions at
+ * the block's start and end. Seek() crosses whole blocks through those
+ * deltas and replays single moves only inside the first and last block,
+ * so scrubbing costs O(KEYFRAME_INTERVAL + nodes moved in the blocks
+ * crossed) instead of replaying the match from its start.
  */
 class ReplayLogger {
 public:
+  static constexpr int KEYFRAME_INTERVAL = 64; // Moves per keyframe block
+
   ReplayLogger() = default;
 
   /**
@@ -51,6 +60,12 @@ public:
    */
   const CPUMove &GetMoveAt(int step) const;
 
+  /**
+   * Move nodes from their positions after step `from` to those after
+   * step `to` (0 = initial layout), writing positions only
+   */
+  void Seek(std::vector<Node> &nodes, int from, int to) const;
+
   /**
    * Get total number of moves recorded
    */
@@ -86,10 +101,24 @@ public:
   int GetInitialIntersections() const { return initialIntersections_; }
 
 private:
+  struct Keyframe {
+    std::vector<int> nodes;   // Nodes the block's moves touched
+    std::vector<Vec2> before; // Their positions at the block's start
+    std::vector<Vec2> after;  // And at its end
+  };
+
+  void ApplyMoves(std::vector<Node> &nodes, int first, int last) const;
+  static void ApplyDelta(std::vector<Node> &nodes, const Keyframe &keyframe,
+                         const std::vector<Vec2> &positions);
+
   std::vector<Vec2> initialPositions_;
   std::vector<std::pair<int, int>> edges_; // Edge pairs for JSON export
   int initialIntersections_ = 0;
   std::vector<CPUMove> moves_;
+
+  std::vector<Keyframe> keyframes_; // Block b holds moves bK+1..(b+1)K
+  std::vector<Vec2> positions_;     // Layout after the last recorded move
+  std::vector<int> slotOf_; // Node -> its entry in the open block, or -1
 };
 
 } // namespace GreedyTangle
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "GraphData.hpp"
+
+namespace GreedyTangle {
+
+/**
+ * Camera - Maps world coordinates to window pixels
+ *
+ * screen = (world - origin) * zoom, so origin is the world point shown
+ * at the window's top-left corner. Nodes, edges and solver moves live in
+ * world coordinates; only drawing and mouse input go through the camera.
+ */
+class Camera {
+public:
+  static constexpr float MIN_ZOOM = 0.02f;
+  static constexpr float MAX_ZOOM = 8.0f;
+
+  Vec2 WorldToScreen(const Vec2 &world) const {
+    return (world - origin_) * zoom_;
+  }
+  Vec2 ScreenToWorld(const Vec2 &screen) const {
+    return origin_ + screen * (1.0f / zoom_);
+  }
+
+  // World area covered by a window of the given size
+  Rect Viewport(int screenWidth, int screenHeight) const;
+
+  // Drag the view by a mouse movement in pixels
+  void Pan(const Vec2 &screenDelta);
+
+  // Scale by factor, keeping the world point under screenAnchor in place
+  void ZoomAt(const Vec2 &screenAnchor, float factor);
+
+  // Center area in the window at the largest zoom that shows all of it
+  void Fit(const Rect &area, int screenWidth, int screenHeight);
+
+  float Zoom() const { return zoom_; }
+  const Vec2 &Origin() const { return origin_; }
+
+  bool operator==(const Camera &other) const {
+    return zoom_ == other.zoom_ && origin_.x == other.origin_.x &&
+           origin_.y == other.origin_.y;
+  }
+  bool operator!=(const Camera &other) const { return !(*this == other); }
+
+private:
+  Vec2 origin_;
+  float zoom_ = 1.0f;
+};
+
+} // namespace GreedyTangle
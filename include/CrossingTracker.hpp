@@ -0,0 +1,76 @@
+#pragma once
+
+#include "GraphData.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * CrossingTracker - Keeps the crossing count of a live layout up to date
+ *
+ * Holds how many other edges cross each edge. Update() compares node
+ * positions with the ones it saw last time, and only retests the edges
+ * incident to nodes that moved against the rest of the graph, adjusting
+ * both edges of every pair whose state changed. Dragging one node of
+ * degree d costs about 2 * d * E segment tests instead of E² / 2.
+ *
+ * A new graph (different edge list) or a move touching more than
+ * FULL_RECOUNT_FRACTION of the edges falls back to a full recount.
+ */
+class CrossingTracker {
+public:
+  static constexpr float FULL_RECOUNT_FRACTION = 0.25f;
+
+  /**
+   * Bring the counts up to date with nodes and edges, set every
+   * Edge::isIntersecting from them, and return the crossing total.
+   */
+  int Update(const std::vector<Node> &nodes, std::vector<Edge> &edges);
+
+  // Force a full recount on the next Update
+  void Invalidate() { valid_ = false; }
+
+  int Total() const { return total_; }
+
+  // Number of edges crossing edges[edgeIndex] as of the last Update
+  int EdgeCrossings(size_t edgeIndex) const {
+    return edgeCrossings_[edgeIndex];
+  }
+
+  // Segment tests done by the last Update (full recounts included)
+  uint64_t LastPairTests() const { return lastPairTests_; }
+
+  // True if the last Update recounted every edge from scratch
+  bool LastRecounted() const { return recounted_; }
+
+  /**
+   * Edges the last Update moved or flipped the crossing state of, unless
+   * it recounted from scratch. May hold an edge more than once.
+   */
+  const std::vector<int> &ChangedEdges() const { return changedEdges_; }
+
+private:
+  bool SameGraph(const std::vector<Node> &nodes,
+                 const std::vector<Edge> &edges) const;
+  void Rebuild(const std::vector<Node> &nodes, const std::vector<Edge> &edges);
+  void UpdateMoved(const std::vector<Node> &nodes,
+                   const std::vector<Edge> &edges);
+
+  std::vector<Vec2> positions_;              // Node positions last counted
+  std::vector<Edge> endpoints_;              // Edge list last counted
+  std::vector<std::vector<int>> incident_;   // Node -> indices of its edges
+  std::vector<int> edgeCrossings_;           // Per edge crossing counters
+  int total_ = 0;
+  bool valid_ = false;
+  uint64_t lastPairTests_ = 0;
+  bool recounted_ = false;
+  std::vector<int> changedEdges_;
+
+  // Scratch reused between updates
+  std::vector<int> movedNodes_;
+  std::vector<int> affectedEdges_;
+  std::vector<uint8_t> affected_;
+};
+
+} // namespace GreedyTangle
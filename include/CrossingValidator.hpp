@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CPUController.hpp"
+#include "GraphData.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Differential checking of crossing-count backends.
+ *
+ * Every fast way of counting crossings is run side by side with the
+ * reference CountIntersections on the same layouts, and any layout where
+ * the two disagree is shrunk to a small reproducer. The bench runs this
+ * with --validate; configuring with -DGREEDY_TANGLE_VALIDATE_CROSSINGS=ON
+ * also cross-checks the fast paths the solvers take during real play.
+ */
+#ifndef GREEDY_TANGLE_CROSSING_VALIDATION
+#define GREEDY_TANGLE_CROSSING_VALIDATION 0
+#endif
+
+namespace GreedyTangle {
+
+/**
+ * CrossingCase - A layout and one node move to count crossings after
+ *
+ * movedId is -1 for the layout as it stands.
+ */
+struct CrossingCase {
+  std::vector<Node> nodes;
+  std::vector<Edge> edges;
+  int movedId = -1;
+  Vec2 movedPosition;
+  std::string source; // Generator or replay the case came from
+};
+
+/**
+ * CrossingBackend - One way of counting the crossings of a case
+ *
+ * Backends()[0] is the reference; new fast paths register in Backends()
+ * so that --validate covers them before any solver switches over.
+ */
+struct CrossingBackend {
+  const char *key;
+  const char *description;
+  int (*count)(const CrossingCase &testCase);
+};
+
+struct ValidationConfig {
+  std::vector<uint32_t> seeds = {1, 2, 3, 4, 5};
+  int randomCases = 200;      // Per seed
+  int adversarialCases = 400; // Per seed, spread over the adversarial kinds
+  bool replaySessions = true; // Record solver sessions on seeded puzzles
+  std::vector<std::string> backends; // Keys to check; empty = all
+};
+
+/**
+ * Disagreement - A case where a backend and the reference differ
+ *
+ * minimized is the smallest sub-layout (edges dropped one at a time, then
+ * unused nodes removed) on which they still differ.
+ */
+struct Disagreement {
+  std::string backend;
+  std::string source;
+  int referenceCount = 0;
+  int backendCount = 0;
+  size_t originalEdges = 0;
+  CrossingCase minimized;
+};
+
+struct BackendTally {
+  std::string backend;
+  uint64_t comparisons = 0;
+  uint64_t disagreements = 0;
+};
+
+struct ValidationReport {
+  uint64_t cases = 0;
+  std::vector<std::pair<std::string, uint64_t>> casesPerKind;
+  std::vector<BackendTally> tallies;
+  std::vector<Disagreement> disagreements; // First few per backend
+
+  bool Passed() const;
+};
+
+class CrossingValidator {
+public:
+  static constexpr int MAX_REPORTED_PER_BACKEND = 5;
+
+  static const std::vector<CrossingBackend> &Backends();
+  static const CrossingBackend *FindBackend(const std::string &key);
+
+  // Uniform layouts with random graphs, and seeded puzzles with random moves
+  static std::vector<CrossingCase> RandomCases(uint32_t seed, int count);
+
+  // Collinear, duplicate-point, near-EPSILON and integer-lattice layouts
+  static std::vector<CrossingCase> AdversarialCases(uint32_t seed, int count);
+
+  // One case per recorded move: the layout before it, and the move
+  static std::vector<CrossingCase> ReplayCases(const ReplayLogger &replay,
+                                               const std::string &source);
+
+  // Plays each solver on small seeded puzzles through a ReplayLogger, as
+  // the game's CPU opponent does, and returns the cases of every session
+  static std::vector<CrossingCase> RecordedSessionCases(uint32_t seed);
+
+  static ValidationReport Run(const ValidationConfig &config);
+
+  static int ReferenceCount(const CrossingCase &testCase);
+
+  // Shrinks a case on which backend disagrees with the reference
+  static CrossingCase Minimize(const CrossingCase &testCase,
+                               const CrossingBackend &backend);
+
+  static void WriteReport(const ValidationReport &report, std::ostream &out);
+
+  /**
+   * Debug builds only: compare a count a fast path just produced with the
+   * reference, and log the layout if they differ. Counted in
+   * LiveDisagreements() so tools can fail on it.
+   */
+  static void CheckLive(const char *backendKey, int count,
+                        const std::vector<Node> &nodes,
+                        const std::vector<Edge> &edges, int movedId,
+                        const Vec2 &movedPosition);
+  static uint64_t LiveDisagreements();
+};
+
+} // namespace GreedyTangle
+
+#if GREEDY_TANGLE_CROSSING_VALIDATION
+#define GT_VALIDATE_CROSSINGS(backendKey, count, nodes, edges, movedId,       \
+                              movedPosition)                                  \
+  ::GreedyTangle::CrossingValidator::CheckLive(backendKey, count, nodes,      \
+                                               edges, movedId, movedPosition)
+#else
+#define GT_VALIDATE_CROSSINGS(backendKey, count, nodes, edges, movedId,       \
+                              movedPosition)                                  \
+  ((void)0)
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+#ifdef _WIN32
+#include <SDL.h>
+#else
+#include <SDL2/SDL.h>
+#endif
+#include "Camera.hpp"
+#include "GraphData.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * DensityLayer - Edges rasterized into a coarse density texture
+ *
+ * The zoomed-out view of a large graph: a world-space grid of at most
+ * MAX_GRID_SIZE cells per side counts how many edges, and how many
+ * crossing edges, pass through each cell. Cells are shaded by coverage
+ * and tinted from the safe to the critical color by the crossing share,
+ * and the whole grid is one streaming texture drawn with one copy.
+ *
+ * Each edge remembers the segment and crossing state it was rasterized
+ * with. The owner reports the edges that moved or flipped crossing state
+ * through MarkEdges() (CrossingTracker::ChangedEdges() has them), and
+ * Draw() un-rasterizes and re-rasterizes only those, then re-shades and
+ * uploads only the cells they touched. Edges nobody reported are not
+ * looked at, so a frame costs the marked edges plus the dirty cells.
+ * A new graph, Invalidate(), more than REBUILD_FRACTION of the edges
+ * marked, or an edge leaving the grid's area rebuilds the grid.
+ */
+class DensityLayer {
+public:
+  static constexpr int MAX_GRID_SIZE = 512;     // Cells on the longer side
+  static constexpr float REBUILD_FRACTION = 0.25f;
+  static constexpr float AREA_SLACK = 0.25f;    // Room to drag past the graph
+  static constexpr uint32_t SATURATION = 64;    // Edges for full brightness
+
+  DensityLayer() = default;
+  ~DensityLayer();
+
+  DensityLayer(const DensityLayer &) = delete;
+  DensityLayer &operator=(const DensityLayer &) = delete;
+
+  void Init(SDL_Renderer *renderer);
+  void Destroy(); // Before the renderer goes away
+
+  // Rebuild on the next Draw
+  void Invalidate() { valid_ = false; }
+
+  // Re-rasterize these edges on the next Draw; repeats are fine
+  void MarkEdges(const std::vector<int> &edgeIndices);
+
+  /**
+   * Bring the grid up to date with the graph and draw it through camera.
+   * False if the texture is unavailable; draw the edges directly then.
+   */
+  bool Draw(const std::vector<Node> &nodes, const std::vector<Edge> &edges,
+            const Camera &camera, SDL_Color safe, SDL_Color critical);
+
+  // Edges re-rasterized by the last Draw; all of them after a rebuild
+  size_t LastRasterized() const { return lastRasterized_; }
+
+private:
+  struct Slot {
+    Vec2 from; // World coordinates
+    Vec2 to;
+    bool critical = false;
+  };
+
+  struct CellBox {
+    int x0, y0, x1, y1; // Inclusive
+  };
+
+  void Rebuild(const std::vector<Node> &nodes, const std::vector<Edge> &edges);
+  void Rasterize(const Slot &slot, int delta);
+  CellBox CellsOf(const Slot &slot) const;
+  void MarkDirty(const CellBox &cells);
+  void Shade(SDL_Color safe, SDL_Color critical);
+  bool Upload();
+
+  SDL_Renderer *renderer_ = nullptr;
+  SDL_Texture *texture_ = nullptr;
+  int textureWidth_ = 0;
+  int textureHeight_ = 0;
+  bool failed_ = false; // Texture could not be made; stop trying
+
+  Rect area_;          // World area the grid covers
+  float cellSize_ = 1.0f;
+  int columns_ = 0;
+  int rows_ = 0;
+  std::vector<uint32_t> coverage_; // Edges through each cell
+  std::vector<uint32_t> crossing_; // Crossing edges through each cell
+  std::vector<uint32_t> pixels_;   // ARGB8888 shade of each cell
+  std::vector<Slot> slots_;        // What each edge was rasterized as
+  SDL_Color colors_[2] = {};       // Safe, critical the pixels use
+  bool valid_ = false;
+
+  bool dirty_ = false; // Cells in dirtyBox_ need shading and upload
+  CellBox dirtyBox_ = {0, 0, -1, -1};
+  size_t lastRasterized_ = 0;
+  std::vector<int> pending_;       // Edges marked since the last Draw
+  std::vector<uint8_t> isPending_; // Per edge: already in pending_
+};
+
+} // namespace GreedyTangle
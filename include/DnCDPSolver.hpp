@@ -2,6 +2,8 @@
 
 #include "ICPUSolver.hpp"
 #include "CPUController.hpp"
+#include "GreedySolver.hpp"
+#include <memory_resource>
 #include <vector>
 
 namespace GreedyTangle {
@@ -9,8 +11,6 @@ namespace GreedyTangle {
 class DnCDPSolver : public ICPUSolver {
 public:
   static constexpr float MARGIN = 60.0f;
-  static constexpr float WINDOW_WIDTH = 1024.0f;
-  static constexpr float WINDOW_HEIGHT = 768.0f;
   static constexpr int BASE_CASE_THRESHOLD = 3;
   static constexpr float GRID_SPACING = 50.0f;
   static constexpr float BOUNDARY_MARGIN = 100.0f;
@@ -27,9 +27,15 @@ public:
   }
 
 private:
+  // Partitions built during a search live in the solver's arena; a copy
+  // gets the default resource, so it can outlive the search
   struct Partition {
-    std::vector<int> nodeIndices;
+    std::pmr::vector<int> nodeIndices;
     float xMin, xMax, yMin, yMax;
+
+    explicit Partition(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : nodeIndices(resource), xMin(0), xMax(0), yMin(0), yMax(0) {}
   };
 
   struct DPState {
@@ -38,16 +44,17 @@ private:
     int costAtPosition;
   };
 
-  Partition CreatePartition(const std::vector<int> &nodeIndices,
+  Partition CreatePartition(std::pmr::vector<int> nodeIndices,
                             const std::vector<Node> &nodes);
 
   std::pair<Partition, Partition> SplitPartition(
       const Partition &partition, const std::vector<Node> &nodes);
 
-  std::vector<Vec2> GenerateDPCandidates(const Partition &partition);
+  std::pmr::vector<Vec2> GenerateDPCandidates(const Partition &partition);
 
-  std::vector<int> OrderNodesByDegree(const std::vector<int> &nodeIndices,
-                                      const std::vector<Node> &nodes);
+  std::pmr::vector<int> OrderNodesByDegree(
+      const std::pmr::vector<int> &nodeIndices,
+      const std::vector<Node> &nodes);
 
   int EvaluatePlacement(std::vector<Node> &nodes,
                         const std::vector<Edge> &edges,
@@ -76,6 +83,11 @@ private:
                                      const std::vector<Edge> &edges);
 
   int lastCandidatesEvaluated_ = 0;
+  Rect canvas_ = DEFAULT_CANVAS; // From the graph at the start of a search
+  GreedySolver fallbackSolver_; // Kept so its arena survives between moves
+
+  // Kernel-level entry points for greedy_tangle_microbench
+  friend struct MicrobenchAccess;
 };
 
 }
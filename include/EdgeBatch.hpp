@@ -0,0 +1,75 @@
+#pragma once
+
+#ifdef _WIN32
+#include <SDL.h>
+#else
+#include <SDL2/SDL.h>
+#endif
+#include "Camera.hpp"
+#include "GraphData.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * EdgeBatch - Edges drawn as thin quads, one call per crossing state
+ *
+ * Every edge owns a persistent slot of four vertices in screen space, so
+ * a frame only rewrites the slots of visible edges whose endpoints or
+ * crossing state changed since they were last drawn; moving the camera
+ * marks every slot stale. The visible edges are grouped into safe and
+ * critical index lists, and each group goes to SDL_RenderGeometry in one
+ * call, critical edges last so they stay on top.
+ *
+ * Without SDL_RenderGeometry (SDL older than 2.0.18, or a backend that
+ * rejects it) each group is drawn with SDL_RenderDrawLine after a single
+ * color change.
+ */
+class EdgeBatch {
+public:
+  static constexpr float LINE_WIDTH = 1.0f; // Quad thickness in pixels
+
+  EdgeBatch() = default;
+
+  EdgeBatch(const EdgeBatch &) = delete;
+  EdgeBatch &operator=(const EdgeBatch &) = delete;
+
+  void Init(SDL_Renderer *renderer);
+
+  // Draw the edges listed in visible (indices into edges) through camera
+  void Draw(const std::vector<Node> &nodes, const std::vector<Edge> &edges,
+            const std::vector<int> &visible, const Camera &camera,
+            SDL_Color safe, SDL_Color critical);
+
+  // Slots rewritten by the last Draw; every visible one after a new edge
+  // list or camera move
+  size_t LastRewritten() const { return lastRewritten_; }
+
+private:
+  struct Slot {
+    Vec2 from; // World coordinates
+    Vec2 to;
+    bool critical = false;
+    uint32_t version = 0; // Stale unless equal to version_
+  };
+
+  void WriteSlot(size_t index, const Slot &slot);
+  void BuildGroups(const std::vector<int> &visible);
+  void DrawLines(const std::vector<Node> &nodes, const std::vector<Edge> &edges,
+                 const std::vector<int> &visible);
+
+  SDL_Renderer *renderer_ = nullptr;
+  bool geometrySupported_ = true; // Cleared after SDL_RenderGeometry fails
+
+  SDL_Color colors_[2] = {};           // Safe, critical
+  Camera camera_;                      // Transform the slots were written with
+  uint32_t version_ = 1;               // Bumped when every slot goes stale
+  std::vector<Slot> slots_;            // What each vertex slot shows
+  std::vector<SDL_Vertex> vertices_;   // Four per edge, in edge order
+  std::vector<int> groupIndices_[2];   // Safe, critical triangles
+  size_t lastRewritten_ = 0;
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef _WIN32
+#include <SDL.h>
+#else
+#include <SDL2/SDL.h>
+#endif
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace GreedyTangle {
+
+/**
+ * FrameScheduler - Decides when the main loop runs a frame
+ *
+ * The loop asks WaitForFrame() before every frame. While something is
+ * animating it returns on a fixed 60 Hz tick; otherwise it blocks in
+ * SDL_WaitEventTimeout until input arrives, another thread marks the
+ * frame dirty (a solver result, a log line), or the earliest deadline
+ * requested with WakeAt() passes. Only dirty or animating frames are
+ * rendered, so a static screen costs no CPU.
+ */
+class FrameScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Why a frame has to be drawn; combined as a bit mask
+  enum DirtyReason : uint32_t {
+    DIRTY_INPUT = 1u << 0,  // SDL event handled
+    DIRTY_SOLVER = 1u << 1, // Solver, heatmap or replay result arrived
+    DIRTY_LOGS = 1u << 2,   // Background log line for the computing screen
+    DIRTY_STATE = 1u << 3   // Anything else the next frame must show
+  };
+
+  static constexpr float FRAME_INTERVAL = 1.0f / 60.0f; // Fixed timestep
+  static constexpr int IDLE_WAKE_MS = 1000; // Longest block with no deadline
+
+  FrameScheduler() = default;
+
+  FrameScheduler(const FrameScheduler &) = delete;
+  FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+  /**
+   * Register the wake-up event; call after SDL_Init. Without it,
+   * MarkDirty from other threads is only seen at the next timed wake.
+   */
+  void Init();
+
+  // Safe from any thread; wakes a blocked WaitForFrame
+  void MarkDirty(uint32_t reasons);
+
+  // Run frames continuously on the fixed timestep until cleared
+  void SetAnimating(bool animating) { animating_ = animating; }
+  bool IsAnimating() const { return animating_; }
+
+  // Run a frame no later than deadline; the earliest request wins and
+  // requests are cleared once WaitForFrame returns
+  void WakeAt(Clock::time_point deadline);
+  void WakeIn(float seconds);
+
+  // Block until the next frame is due
+  void WaitForFrame();
+
+  // True if this frame should be rendered; clears the dirty reasons
+  bool TakeRenderRequest();
+
+  // The internal wake-up event; HandleInput drops it
+  bool IsWakeEvent(const SDL_Event &event) const {
+    return wakeEventType_ != 0 && event.type == wakeEventType_;
+  }
+
+private:
+  std::atomic<uint32_t> dirty_{DIRTY_STATE}; // Draw the first frame
+  std::atomic<bool> wakePending_{false};     // A wake event is queued
+  Uint32 wakeEventType_ = 0;
+  bool animating_ = false;
+  bool hasDeadline_ = false;
+  Clock::time_point deadline_;
+  Clock::time_point nextTick_;
+};
+
+} // namespace GreedyTangle
@@ -1,10 +1,24 @@
 #pragma once
 
+#include "AllocationTracker.hpp"
+#include "BenchmarkRunner.hpp"
 #include "CPUController.hpp"
+#include "Camera.hpp"
+#include "CrossingTracker.hpp"
+#include "DensityLayer.hpp"
+#include "EdgeBatch.hpp"
+#include "FrameScheduler.hpp"
 #include "ICPUSolver.hpp"
+#include "SPSCChannel.hpp"
+#include "ScalabilityAnalysis.hpp"
 #include "SolverFactory.hpp"
+#include "ThreadPool.hpp"
 #include "GraphData.hpp"
 #include "MenuBar.hpp"
+#include "NodeSpriteAtlas.hpp"
+#include "RetainedLayer.hpp"
+#include "SceneIndex.hpp"
+#include "TextCache.hpp"
 #ifdef _WIN32
 #include <SDL.h>
 #else
@@ -22,9 +36,11 @@ namespace GreedyTangle {
  * GameEngine - Core SDL lifecycle and render loop
  *
  * Render Loop Lifecycle:
+ * 0. Wait: FrameScheduler idles the loop until input, a result or a timer
  * 1. Input Poll: Handle SDL_Quit and Mouse events
  * 2. Update: Verify graph state and recalculate intersections
- * 3. Render: Clear → Draw Edges → Draw Nodes → Swap Buffers
+ * 3. Render: Clear → Draw Edges → Draw Nodes → Swap Buffers (dirty frames
+ *    and animations only)
  */
 class GameEngine {
 public:
@@ -32,6 +48,7 @@ public:
   static constexpr int WINDOW_WIDTH = 1024;
   static constexpr int WINDOW_HEIGHT = 768;
   static constexpr const char *WINDOW_TITLE = "Greedy Tangle";
+  static constexpr const char *TRACE_OUTPUT_PATH = "greedy_tangle_trace.json";
 
   // Color palette (minimalist dark theme)
   struct Colors {
@@ -83,6 +100,10 @@ private:
   std::vector<Edge> edges;
   bool isRunning = false;
 
+  // Frame pacing: blocks the loop while nothing is dirty or animating
+  FrameScheduler frameScheduler_;
+  static constexpr float JOB_POLL_INTERVAL = 1.0f / 30.0f; // Pending futures
+
   // Game phase state machine
   GamePhase currentPhase = GamePhase::MAIN_MENU;
   std::chrono::steady_clock::time_point phaseStartTime;
@@ -97,10 +118,27 @@ private:
   // Interaction state (Input State Machine)
   int selectedNodeID = -1; // ID of node being dragged (-1 = Idle state)
   int hoveredNodeID = -1;  // ID of node under cursor (-1 = none)
-  Vec2 mousePosition;      // Current mouse coordinates (float)
+  Vec2 mousePosition;      // Mouse position in world coordinates
+  Vec2 mouseScreen;        // Mouse position in window pixels
+  bool isPanning = false;  // Right or middle button held on the board
+
+  // World view: nodes live in world coordinates, drawn through camera_
+  Camera camera_;
+  Rect world_ = DEFAULT_CANVAS; // Area the current puzzle is laid out in
+  SceneIndex sceneIndex_;       // Grids of node and edge bounds for culling
+  std::vector<int> visibleNodes_; // Indices on screen this frame
+  std::vector<int> visibleEdges_;
+  static constexpr float ZOOM_STEP = 1.15f; // Per mouse wheel notch
+
+  // Level of detail: once nodes shrink below LOD_NODE_PIXELS of radius,
+  // edges are drawn as a density texture and nodes as single points
+  static constexpr float LOD_NODE_PIXELS = 3.0f;
+  DensityLayer densityLayer_;
+  std::vector<SDL_Point> lodPoints_;
 
   // Statistics
   int intersectionCount = 0;
+  CrossingTracker crossingTracker_; // Per-edge counters, moved nodes only
 
   // Game analytics
   int moveCount = 0; // Number of node drags
@@ -115,8 +153,22 @@ private:
 
   // Menu bar
   std::unique_ptr<MenuBar> menuBar;
+  NodeSpriteAtlas nodeSprites_; // Batched node circles
+  EdgeBatch edgeBatch_;         // Edge quads, redrawn slots only
+  TextCache textCache_;         // DrawTextCentered strings and glyphs
+
+  // Panels repainted only when their inputs change
+  RetainedLayer heatmapLegendLayer_;
+  RetainedLayer algorithmPanelLayer_;
+  RetainedLayer victoryLayer_;
+  RetainedLayer benchmarkLayer_;
+  RetainedLayer scalabilityLayer_;
+  RetainedLayer howItWorksLayer_;
 
   // Game settings
+  static constexpr int MAX_NODE_COUNT = 10000;
+  static constexpr int NODES_PER_DEFAULT_CANVAS = 200; // Larger puzzles
+                                                        // get a larger world
   int currentNodeCount = 10; // Default changed to 10
   Difficulty currentDifficulty = Difficulty::MEDIUM;
   GameMode currentMode = GameMode::GREEDY;
@@ -126,6 +178,9 @@ private:
   std::string inputBuffer;
   std::chrono::steady_clock::time_point inputCursorBlink;
 
+  // Shared work-stealing executor for all background jobs
+  std::unique_ptr<ThreadPool> threadPool_;
+
   std::unique_ptr<ICPUSolver> currentSolver_;
   std::unique_ptr<ReplayLogger> cpuReplayLogger_;
   std::future<CPUMove> cpuFuture_;
@@ -134,6 +189,30 @@ private:
   float cpuGameDuration_ = 0.0f;
   std::atomic<bool> cpuCancelFlag_{false}; // Cancellation flag for solver
 
+  // Live search state streamed from the solver (drained once per frame)
+  SolverProgressChannel cpuProgress_;
+  CPUMove cpuLiveBest_;        // Best applicable move reported so far
+  int cpuLiveEvaluated_ = 0;   // Candidates evaluated so far
+  bool cpuCommitEarly_ = false; // Search cancelled to commit cpuLiveBest_
+  std::chrono::steady_clock::time_point cpuSearchStartTime_;
+  static constexpr float CPU_COMMIT_DEADLINE = 2.0f; // Seconds before early commit
+
+  // Live solver throughput, sampled from the solver's stats block
+  SolverStatsSnapshot cpuStatsSample_;
+  std::chrono::steady_clock::time_point cpuStatsSampleTime_;
+  double cpuEvalRate_ = 0.0; // Candidates evaluated per second
+  double cpuPairRate_ = 0.0; // Segment-pair tests per second
+  static constexpr float STATS_SAMPLE_INTERVAL = 0.5f; // Seconds per sample
+
+  // Heap allocations per frame phase (GREEDY_TANGLE_TRACK_ALLOCATIONS builds)
+  uint64_t frameCounter_ = 0;
+  uint64_t allocSampleFrame_ = 0;
+  AllocCounters updateAllocSample_;
+  AllocCounters renderAllocSample_;
+  std::chrono::steady_clock::time_point allocSampleTime_;
+  double updateAllocsPerFrame_ = 0.0;
+  double renderAllocsPerFrame_ = 0.0;
+
   // Race Mode: CPU has its own copy of the graph
   std::vector<Node> cpuNodes_; // CPU's graph state
   int cpuIntersectionCount_ =
@@ -146,6 +225,7 @@ private:
   // CPU stuck/perturbation tracking
   int cpuStuckCount_ = 0;                     // Consecutive invalid moves
   static constexpr int MAX_PERTURBATIONS = 8; // Max random restarts before giving up
+  static constexpr float PERTURB_MARGIN = 60.0f; // Kept inside the solver canvas
 
   // CPU delay based on difficulty (makes CPU beatable on easier levels)
   std::chrono::steady_clock::time_point cpuLastMoveTime_;
@@ -174,15 +254,28 @@ private:
 
   // Decision Heatmap (Feature 5)
   bool heatmapEnabled_ = false;
-  std::vector<float> nodeHeatmapScores_; // Normalized 0.0-1.0 per node
+  std::vector<float> nodeHeatmapScores_; // Normalized 0.0-1.0 per node (front)
   std::chrono::steady_clock::time_point heatmapLastUpdate_;
   static constexpr float HEATMAP_UPDATE_INTERVAL = 1.5f; // Recalc every 1.5s
+  static constexpr int HEATMAP_FULL_PASS_INTERVAL = 8;   // Incremental passes per full pass
+
+  // Background heatmap job. While heatmapFuture_ is pending the job owns
+  // the snapshot, raw scores and back buffer; the UI thread only swaps the
+  // back buffer into nodeHeatmapScores_ once the job has finished.
+  std::future<void> heatmapFuture_;
+  std::vector<Node> heatmapSnapshot_;     // Layout the raw scores were computed for
+  std::vector<int> heatmapRawScores_;     // Best reduction per node
+  std::vector<float> heatmapBackScores_;  // Normalized result of the last job
+  size_t heatmapEdgeCount_ = 0;
+  int heatmapPassesSinceFull_ = 0;
+  bool heatmapNeedsFullPass_ = true;
 
   // Step-by-Step Replay Viewer (Feature 4)
   int replayCurrentStep_ = 0;        // 0 = initial state, 1..N = after move N
   bool replayPlaying_ = false;       // Auto-play mode
   std::vector<Node> replayNodes_;    // Graph state for replay rendering
   std::vector<Edge> replayEdges_;    // Edges snapshot from the replayed game
+  Rect replayArea_ = DEFAULT_CANVAS; // World box the viewer fits to the window
   std::chrono::steady_clock::time_point replayLastStepTime_;
   static constexpr float REPLAY_STEP_INTERVAL = 1.2f; // Auto-play speed (slower for animation)
 
@@ -204,35 +297,60 @@ private:
   std::vector<ReplayCandidate> replayCandidates_; // Evaluated candidates for current step
   bool replayShowCandidates_ = true; // Toggle candidate visualization
 
+  // Replay completion runs as a pool job; its moves stream back over
+  // replayMoves_ and the UI thread records them, so the viewer can scrub
+  // the moves found so far while the rest are still being computed
+  std::future<void> replayCompletionFuture_;
+  SPSCChannel<CPUMove, 256> replayMoves_;
+  std::atomic<bool> replayCancelFlag_{false};
+  bool replayCompleting_ = false;
+  static constexpr float REPLAY_COMPLETION_TIME_LIMIT = 15.0f; // seconds
+  static constexpr int REPLAY_COMPLETION_MAX_MOVES = 100;
+
   // Algorithm Comparison / Benchmark Mode (Feature 1)
   struct BenchmarkResult {
     std::string solverName;
     int totalMoves = 0;
     int64_t totalTimeMs = 0;
     int totalCandidatesEvaluated = 0;
+    uint64_t pairTests = 0;           // Segment pairs examined
+    double evalsPerSecond = 0.0;      // Candidates per second of search
+    double pairTestsPerSecond = 0.0;  // Pair tests per second of search
     int initialIntersections = 0;
     int finalIntersections = 0;
     bool solved = false;
     std::vector<int> intersectionHistory; // Per-move intersection count
+
+    // Distributions over every seed x family trial (the scalar fields
+    // above hold the medians, the history comes from the first puzzle)
+    int trials = 0;
+    int solvedTrials = 0;
+    Distribution timeMsDist;
+    Distribution movesDist;
+    Distribution finalDist;
   };
   std::vector<BenchmarkResult> benchmarkResults_;
   static constexpr int BENCHMARK_MAX_MOVES = 100;
-  static constexpr float BENCHMARK_MAX_TIME = 30.0f; // seconds per solver
+  static constexpr float BENCHMARK_MAX_TIME = 30.0f;       // seconds for the whole sweep
+  static constexpr float BENCHMARK_TRIAL_MAX_TIME = 10.0f; // seconds per trial
+  static constexpr int BENCHMARK_SEEDS = 5;
+  int benchmarkNodeCount_ = 0;
+  int benchmarkTrialCount_ = 0;   // Trials that ran before the deadline
+  int benchmarkSkippedTrials_ = 0;
+  std::atomic<bool> benchmarkCancelFlag_{false};
   bool benchmarkShowPlot_ = false; // Toggle between cards and convergence plot
 
   // Scalability / Empirical Complexity Analysis (Feature 3)
-  struct ScalabilityDataPoint {
-    std::string solverName;
-    int nodeCount = 0;
-    int64_t timeMs = 0;
-    int moves = 0;
-    bool solved = false;
-  };
-  std::vector<ScalabilityDataPoint> scalabilityResults_;
-  static constexpr int SCALABILITY_SIZES[] = {4, 6, 8, 10, 13, 16, 20};
-  static constexpr int SCALABILITY_NUM_SIZES = 7;
+  ScalabilityReport scalabilityReport_;
+  static constexpr int SCALABILITY_MIN_NODES = 10;
+  static constexpr int SCALABILITY_MAX_NODES = 10240; // Ladder doubles up to here
+  static constexpr int SCALABILITY_SEEDS = 3;         // Trials per solver per size
   static constexpr int SCALABILITY_MAX_MOVES = 30;
-  static constexpr float SCALABILITY_MAX_TIME = 10.0f; // seconds per solver per size
+  static constexpr float SCALABILITY_MAX_TIME = 10.0f;        // seconds per trial
+  static constexpr float SCALABILITY_SWEEP_MAX_TIME = 120.0f; // seconds for the whole ladder
+  static constexpr const char *SCALABILITY_CSV_PATH = "greedy_tangle_scalability.csv";
+  static constexpr const char *SCALABILITY_JSON_PATH = "greedy_tangle_scalability.json";
+  std::atomic<bool> scalabilityCancelFlag_{false};
 
   // How It Works - Interactive Algorithm Explainer
   int howItWorksTab_ = 0; // 0=Greedy, 1=Backtracking, 2=D&C+DP
@@ -241,7 +359,7 @@ private:
   std::future<void> backgroundTask_;
   std::vector<std::string> computingLogs_;
   std::mutex logMutex_;
-  void* logRedirector_ = nullptr;
+  int logSubscription_ = 0; // Logger subscription feeding computingLogs_
   float computingSpinnerAngle_ = 0.0f;
 
   // UI Fonts
@@ -291,6 +409,12 @@ public:
    */
   void GenerateDynamicGraph(int nodeCount);
 
+  // Size world_ so nodeCount nodes get the density of a default puzzle
+  void SetWorldForNodeCount(int nodeCount);
+
+  // Show all of world_ and the graph in the window
+  void FitCameraToGraph();
+
   /**
    * Easy: Cycle + Chords (low rigidity, floppy)
    * Creates ring with 2-3 non-crossing chords
@@ -342,8 +466,9 @@ private:
 
   /**
    * Update game state
-   * - Recalculate all edge intersections
+   * - Recount crossings on the edges of nodes that moved (CrossingTracker)
    * - Update isIntersecting flags
+   * - Mark the edges that changed for the density layer
    */
   void Update();
 
@@ -355,12 +480,19 @@ private:
 
   // Rendering helpers
   void DrawFilledCircle(int cx, int cy, int radius);
+  void DrawCircleOutline(int cx, int cy, int radius);
   void DrawNode(const Node &node); // Uses node.isDragging/isHovered for state
-  void DrawEdge(const Edge &edge);
+  void RenderGraph();        // Culled full geometry, or LOD when zoomed out
+  void RenderGraphDensity(); // Density texture and node points
+  // Queues the node in nodeSprites_, or draws it directly if the atlas
+  // cannot; nodeSprites_.Flush() draws the queue
+  void DrawNodeShape(int cx, int cy, int radius, SDL_Color fill,
+                     SDL_Color border);
 
   // Interaction helpers
-  int GetNodeAtPosition(const Vec2 &pos);
+  int GetNodeAtPosition(const Vec2 &pos); // pos in world coordinates
   void UpdateHoverState(); // Update isHovered flags based on mouse position
+  void SetMouseScreen(int x, int y); // Track the cursor through camera_
 
   // Phase management
   void UpdatePhase();            // Manage phase transitions and animations
@@ -374,6 +506,7 @@ private:
   // Victory handling
   void CheckVictory();        // Check if game is won
   void RenderVictoryScreen(); // Draw analytics overlay
+  void PaintVictoryScreen();  // Overlay contents, into its layer
 
   // Custom input dialog
   void ShowCustomNodeDialog(); // Open custom node count input
@@ -384,6 +517,13 @@ private:
   void UpdateCPURace();      // Check if CPU made progress, update counts
   void RenderScoreboard();   // Draw "H: X | CPU: Y" live scoreboard
   void StartNextCPUMove();   // Dispatch next CPU move computation
+  void LaunchCPUSearch();    // Submit a search on the CPU's graph copy
+  void DrainCPUProgress();   // Consume streamed solver progress
+  void SampleSolverThroughput(); // Refresh live evals/s and pairs/s
+  void SampleFrameAllocations(); // Refresh allocations per update / render
+  void ScheduleNextFrame();      // Animation flag and wake-ups for the loop
+  void InvalidateLayers();       // Repaint every retained panel
+  void DestroyLayers();          // Before the renderer goes away
   float GetCPUDelay() const; // Get delay based on difficulty
 
   // Home Screen UI
@@ -404,10 +544,16 @@ private:
 
   // Algorithm Description Panel (Feature 6)
   void RenderAlgorithmPanel(); // Draw solver info panel during gameplay
+  void PaintAlgorithmPanel(int panelX, int panelY, int panelW,
+                           int panelH); // Panel contents, into its layer
 
   // Decision Heatmap (Feature 5)
-  void CalculateHeatmap();     // Compute per-node impact scores
+  void UpdateHeatmap();        // Harvest finished job / launch the next one
+  void CalculateHeatmap(std::vector<Node> current, std::vector<Edge> edges,
+                        bool fullPass); // Pool job: per-node impact scores
   void RenderHeatmapLegend();  // Draw color legend on screen
+  void PaintHeatmapLegend(int legendX, int legendY, int legendW,
+                          int legendH); // Legend contents, into its layer
   void ToggleHeatmap();        // Toggle heatmap on/off
   SDL_Color GetHeatmapColor(float score) const; // Map score to color
 
@@ -417,6 +563,10 @@ private:
 
   // Step-by-Step Replay Viewer (Feature 4)
   void StartReplayViewer();    // Enter replay mode from recorded CPU data
+  void CompleteReplay(std::vector<Node> solveNodes, std::vector<Edge> solveEdges,
+                      SolverMode mode); // Pool job: finish the CPU's solution
+  void DrainReplayMoves();     // Record moves streamed by the completion job
+  void StopReplayCompletion(); // Cancel the completion job and keep its moves
   void RenderReplayViewer();   // Render replay screen with controls and annotations
   void HandleReplayInput(const SDL_Event &event); // Handle replay button clicks
   void ReplayGoToStep(int step); // Update graph state for a specific step
@@ -425,23 +575,31 @@ private:
   // Algorithm Comparison / Benchmark Mode (Feature 1)
   void RunBenchmark();              // Run all 3 solvers on same graph, store results
   void RenderBenchmarkResults();    // Render comparison dashboard
+  void PaintBenchmarkResults(int winW, int winH,
+                             int numSolvers); // Dashboard, into its layer
   void HandleBenchmarkInput(const SDL_Event &event); // Handle dashboard clicks
 
   // Convergence Plot (Feature 2)
   void RenderConvergencePlot();     // Draw intersections vs. moves line chart
 
   // Scalability / Empirical Complexity Analysis (Feature 3)
-  void RunScalabilityTest();              // Run all solvers on increasing graph sizes
-  void RenderScalabilityResults();        // Render runtime vs N chart
+  void RunScalabilityTest();              // Run all solvers up a geometric size ladder
+  void RenderScalabilityResults();        // Render log-log time per move vs N chart
+  void PaintScalabilityResults(int winW, int winH,
+                               const ScalabilityReport &report); // Into its layer
   void HandleScalabilityInput(const SDL_Event &event); // Handle scalability screen input
 
   // How It Works - Interactive Algorithm Explainer
   void RenderHowItWorks();              // Render explainer screen with tabs
+  void PaintHowItWorks(int winW, int winH); // Explainer contents, into its layer
   void HandleHowItWorksInput(const SDL_Event &event); // Handle tab clicks
 
   // UI Logging and Async Computation
   void StartComputingBenchmark();
   void StartComputingScalability();
+  void ToggleTraceCapture(); // F9: start capture / write Chrome trace JSON
+  void SubscribeComputingLogs();
+  void UnsubscribeComputingLogs();
   void PushLog(const std::string& message);
   void RenderComputingScreen(const std::string& title);
 };
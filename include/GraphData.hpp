@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -94,4 +95,96 @@ struct Edge {
   }
 };
 
+/**
+ * Rect - Axis-aligned box in world coordinates
+ */
+struct Rect {
+  float minX = 0.0f;
+  float minY = 0.0f;
+  float maxX = 0.0f;
+  float maxY = 0.0f;
+
+  constexpr Rect() = default;
+  constexpr Rect(float minX_, float minY_, float maxX_, float maxY_)
+      : minX(minX_), minY(minY_), maxX(maxX_), maxY(maxY_) {}
+
+  // Smallest box holding both points (e.g. an edge's endpoints)
+  static Rect Around(const Vec2 &a, const Vec2 &b) {
+    return Rect(std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x),
+                std::max(a.y, b.y));
+  }
+
+  float Width() const { return maxX - minX; }
+  float Height() const { return maxY - minY; }
+
+  bool Contains(const Vec2 &point) const {
+    return point.x >= minX && point.x <= maxX && point.y >= minY &&
+           point.y <= maxY;
+  }
+
+  // Touching boxes intersect
+  bool Intersects(const Rect &other) const {
+    return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY &&
+           other.minY <= maxY;
+  }
+
+  Rect Expanded(float amount) const {
+    return Rect(minX - amount, minY - amount, maxX + amount, maxY + amount);
+  }
+
+  Rect United(const Rect &other) const {
+    return Rect(std::min(minX, other.minX), std::min(minY, other.minY),
+                std::max(maxX, other.maxX), std::max(maxY, other.maxY));
+  }
+
+  // Nearest point inside the box
+  Vec2 Clamp(const Vec2 &point) const {
+    return Vec2(std::clamp(point.x, minX, maxX),
+                std::clamp(point.y, minY, maxY));
+  }
+};
+
+/**
+ * World area of the original fixed 1024x768 board. Puzzles up to the
+ * default node counts are laid out in it, and it is the smallest canvas
+ * the solvers search.
+ */
+constexpr Rect DEFAULT_CANVAS(0.0f, 0.0f, 1024.0f, 768.0f);
+
+// Bounding box of the node positions (empty at the origin for no nodes)
+inline Rect GraphBounds(const std::vector<Node> &nodes) {
+  if (nodes.empty()) {
+    return Rect();
+  }
+  Rect bounds(nodes[0].position.x, nodes[0].position.y, nodes[0].position.x,
+              nodes[0].position.y);
+  for (const Node &node : nodes) {
+    bounds = bounds.United(Rect::Around(node.position, node.position));
+  }
+  return bounds;
+}
+
+/**
+ * Area a solver may move nodes in: DEFAULT_CANVAS grown to cover every
+ * node with margin to spare, so candidates clamped to margin inside it
+ * still reach the outermost nodes
+ */
+inline Rect SolverCanvas(const std::vector<Node> &nodes, float margin) {
+  if (nodes.empty()) {
+    return DEFAULT_CANVAS;
+  }
+  return DEFAULT_CANVAS.United(GraphBounds(nodes).Expanded(margin));
+}
+
+/**
+ * Candidate grid step for a canvas: baseSpacing on DEFAULT_CANVAS, and
+ * stretched on larger canvases so a grid over the whole canvas keeps
+ * about the same number of points
+ */
+inline float GridSpacingFor(const Rect &canvas, float baseSpacing) {
+  float scale = std::max({1.0f, canvas.Width() / DEFAULT_CANVAS.Width(),
+                          canvas.Height() / DEFAULT_CANVAS.Height()});
+  return baseSpacing * scale;
+}
+
 } // namespace GreedyTangle
@@ -2,6 +2,7 @@
 
 #include "ICPUSolver.hpp"
 #include "CPUController.hpp"
+#include <memory_resource>
 #include <vector>
 
 namespace GreedyTangle {
@@ -11,8 +12,6 @@ class GreedySolver : public ICPUSolver {
 public:
   static constexpr float GRID_SPACING = 50.0f;
   static constexpr float MARGIN = 60.0f;
-  static constexpr float WINDOW_WIDTH = 1024.0f;
-  static constexpr float WINDOW_HEIGHT = 768.0f;
 
   GreedySolver() = default;
 
@@ -26,14 +25,26 @@ public:
   }
 
 private:
-  std::vector<Vec2> GenerateCandidatePositions(int node_id,
-                                               const std::vector<Node> &nodes);
+  // Grid points tried for every node, before neighbour-based candidates
+  size_t GridCandidates() const;
 
-  int CountIntersectionsWithMove(std::vector<Node> nodes,
+  // Clamp a candidate to MARGIN inside the canvas
+  Vec2 ClampToCanvas(Vec2 position) const;
+
+  // Replaces the contents of candidates; reuse one buffer across nodes
+  void GenerateCandidatePositions(int node_id, const std::vector<Node> &nodes,
+                                  std::pmr::vector<Vec2> &candidates);
+
+  int CountIntersectionsWithMove(const std::vector<Node> &nodes,
                                  const std::vector<Edge> &edges, int node_id,
                                  Vec2 new_position);
 
   int lastCandidatesEvaluated_ = 0;
+  Rect canvas_ = DEFAULT_CANVAS; // From the graph at the start of a search
+  float gridSpacing_ = GRID_SPACING;
+
+  // Kernel-level entry points for greedy_tangle_microbench
+  friend struct MicrobenchAccess;
 };
 
 }
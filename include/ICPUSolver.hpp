@@ -1,13 +1,18 @@
 #pragma once
 
+#include "CPUController.hpp"
 #include "GraphData.hpp"
+#include "MathUtils.hpp"
+#include "SPSCChannel.hpp"
+#include "SolverArena.hpp"
+#include "SolverStats.hpp"
 #include <atomic>
 #include <string>
 #include <vector>
 
 namespace GreedyTangle {
 
-struct CPUMove;
+class ThreadPool;
 
 enum class SolverMode {
   GREEDY,
@@ -15,6 +20,18 @@ enum class SolverMode {
   BACKTRACKING
 };
 
+/**
+ * SolverProgress - Intermediate search state streamed while FindBestMove runs
+ */
+struct SolverProgress {
+  enum class Kind { IMPROVED_MOVE, PROGRESS };
+
+  Kind kind = Kind::PROGRESS;
+  CPUMove move;                // Best single move so far (IMPROVED_MOVE)
+  int candidatesEvaluated = 0; // Candidates scored so far in this call
+};
+
+using SolverProgressChannel = SPSCChannel<SolverProgress, 256>;
 
 class ICPUSolver {
 public:
@@ -30,15 +47,84 @@ public:
 
   virtual int GetLastCandidatesEvaluated() const = 0;
 
+  // Live counters and phase timings, readable from any thread mid-search
+  const SolverStats &GetStats() const { return stats_; }
+  void ResetStats() { stats_.Reset(); }
+
   // Cancellation support: set a flag that solvers check in their hot loops
   void SetCancelFlag(std::atomic<bool> *flag) { cancelFlag_ = flag; }
 
+  // Shared executor for solvers that can spread candidate evaluation
+  void SetThreadPool(ThreadPool *pool) { threadPool_ = pool; }
+
+  // Live progress: improving moves and counters are pushed here while a
+  // search runs, so the UI can show and commit the best move found so far
+  void SetProgressChannel(SolverProgressChannel *channel) {
+    progressChannel_ = channel;
+  }
+
 protected:
   bool IsCancelled() const {
     return cancelFlag_ && cancelFlag_->load(std::memory_order_relaxed);
   }
 
+  // CountIntersections plus bookkeeping of the segment pairs it examines
+  int CountCrossings(const std::vector<Node> &nodes,
+                     const std::vector<Edge> &edges) {
+    uint64_t e = edges.size();
+    if (e > 1) {
+      SolverStats::Add(stats_.pairTests, e * (e - 1) / 2);
+    }
+    return CountIntersections(nodes, edges);
+  }
+
+  // Reset per-call progress state; call at the start of FindBestMove
+  void BeginProgress() {
+    publishedReduction_.store(0, std::memory_order_relaxed);
+  }
+
+  // Publish a single applicable move if it beats everything published
+  // so far in this call
+  void PublishImprovement(const CPUMove &move) {
+    if (!progressChannel_) return;
+    int best = publishedReduction_.load(std::memory_order_relaxed);
+    while (move.intersection_reduction > best) {
+      if (publishedReduction_.compare_exchange_weak(
+              best, move.intersection_reduction, std::memory_order_relaxed)) {
+        SolverProgress progress;
+        progress.kind = SolverProgress::Kind::IMPROVED_MOVE;
+        progress.move = move;
+        Publish(progress);
+        return;
+      }
+    }
+  }
+
+  void PublishProgress(int candidatesEvaluated) {
+    if (!progressChannel_) return;
+    SolverProgress progress;
+    progress.candidatesEvaluated = candidatesEvaluated;
+    Publish(progress);
+  }
+
   std::atomic<bool> *cancelFlag_ = nullptr;
+  ThreadPool *threadPool_ = nullptr;
+  SolverProgressChannel *progressChannel_ = nullptr;
+  SolverStats stats_;
+  SolverArena arena_; // Per-search scratch; Reset() at the top of FindBestMove
+
+private:
+  void Publish(const SolverProgress &progress) {
+    // Parallel solvers report from several workers; serialize them so the
+    // channel still sees a single producer. A full channel drops the update.
+    while (publishLock_.test_and_set(std::memory_order_acquire)) {
+    }
+    progressChannel_->TryPush(progress);
+    publishLock_.clear(std::memory_order_release);
+  }
+
+  std::atomic<int> publishedReduction_{0};
+  std::atomic_flag publishLock_ = ATOMIC_FLAG_INIT;
 };
 
 }
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GreedyTangle {
+
+enum class LogLevel : uint8_t { VERBOSE, INFO, WARN, ERROR };
+
+/**
+ * Leveled logger that never blocks the calling thread.
+ *
+ * Producers (any thread) claim a slot in a bounded lock-free MPSC ring and
+ * store the format string plus raw argument values; nothing is formatted or
+ * written on the caller's thread. A single drain thread formats each record,
+ * writes it to stdout/stderr and hands it to subscribers (e.g. the computing
+ * screen). When the ring is full the record is dropped and counted instead
+ * of waiting.
+ *
+ * Format strings use "{}" for each argument and "{:.Nf}" for fixed-point
+ * floats. The tag and format must be string literals; string arguments are
+ * copied into the slot (truncated if very long).
+ */
+class Logger {
+public:
+  using Subscriber =
+      std::function<void(LogLevel level, const std::string &line)>;
+
+  static Logger &Instance();
+
+  ~Logger();
+
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  void SetMinLevel(LogLevel level) {
+    minLevel_.store(level, std::memory_order_relaxed);
+  }
+
+  bool IsEnabled(LogLevel level) const {
+    return level >= minLevel_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Enqueue one record. Returns false if it was filtered or dropped.
+   */
+  template <typename... Args>
+  bool Log(LogLevel level, const char *tag, const char *format,
+           const Args &...args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Too many log arguments");
+    if (!IsEnabled(level)) {
+      return false;
+    }
+    Record *record = Claim();
+    if (!record) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    record->level = level;
+    record->tag = tag;
+    record->format = format;
+    record->argCount = 0;
+    record->textUsed = 0;
+    (Capture(*record, args), ...);
+    Publish(*record);
+    return true;
+  }
+
+  /**
+   * Receive every formatted line on the drain thread. Callbacks must be
+   * quick; they run between writes to the console.
+   */
+  int Subscribe(Subscriber subscriber);
+  void Unsubscribe(int id);
+
+  /**
+   * Block until every record enqueued before this call has been written.
+   * Meant for shutdown and tests, never for solver threads.
+   */
+  void Flush();
+
+  uint64_t GetDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr size_t CAPACITY = 4096; // Records, power of two
+  static constexpr size_t MAX_ARGS = 8;
+  static constexpr size_t TEXT_CAPACITY = 160; // Bytes of copied strings
+
+  enum class ArgType : uint8_t { INT, UINT, DOUBLE, BOOL, TEXT };
+
+  struct Arg {
+    ArgType type;
+    union {
+      int64_t i;
+      uint64_t u;
+      double d;
+      struct {
+        uint16_t offset;
+        uint16_t length;
+      } text;
+    };
+  };
+
+  struct Record {
+    std::atomic<size_t> sequence{0};
+    LogLevel level = LogLevel::INFO;
+    const char *tag = nullptr;
+    const char *format = nullptr;
+    uint8_t argCount = 0;
+    uint16_t textUsed = 0;
+    std::array<Arg, MAX_ARGS> args;
+    std::array<char, TEXT_CAPACITY> text;
+  };
+
+  Logger();
+
+  Record *Claim();
+  void Publish(Record &record);
+  void DrainLoop();
+  bool DrainOne(std::string &line, LogLevel &level);
+  static void Format(const Record &record, std::string &out);
+
+  static void CaptureText(Record &record, std::string_view value) {
+    size_t room = TEXT_CAPACITY - record.textUsed;
+    size_t length = value.size() < room ? value.size() : room;
+    Arg &arg = record.args[record.argCount++];
+    arg.type = ArgType::TEXT;
+    arg.text.offset = record.textUsed;
+    arg.text.length = static_cast<uint16_t>(length);
+    std::memcpy(record.text.data() + record.textUsed, value.data(), length);
+    record.textUsed = static_cast<uint16_t>(record.textUsed + length);
+  }
+
+  template <typename T> static void Capture(Record &record, const T &value) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+      Arg &arg = record.args[record.argCount++];
+      arg.type = ArgType::BOOL;
+      arg.u = value ? 1 : 0;
+    } else if constexpr (std::is_enum_v<U>) {
+      Arg &arg = record.args[record.argCount++];
+      arg.type = ArgType::INT;
+      arg.i = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+      Arg &arg = record.args[record.argCount++];
+      arg.type = ArgType::INT;
+      arg.i = value;
+    } else if constexpr (std::is_integral_v<U>) {
+      Arg &arg = record.args[record.argCount++];
+      arg.type = ArgType::UINT;
+      arg.u = value;
+    } else if constexpr (std::is_floating_point_v<U>) {
+      Arg &arg = record.args[record.argCount++];
+      arg.type = ArgType::DOUBLE;
+      arg.d = value;
+    } else if constexpr (std::is_convertible_v<const T &, const char *>) {
+      const char *str = value;
+      CaptureText(record, str ? std::string_view(str) : std::string_view());
+    } else {
+      CaptureText(record, std::string_view(value));
+    }
+  }
+
+  // Vyukov-style bounded queue: each slot's sequence says whether it is
+  // free for producer position p (== p) or holds a record for the consumer
+  // (== p + 1). Only the drain thread dequeues.
+  alignas(64) std::atomic<size_t> enqueuePos_{0};
+  alignas(64) size_t dequeuePos_ = 0;
+  alignas(64) std::array<Record, CAPACITY> records_;
+
+  std::atomic<LogLevel> minLevel_{LogLevel::INFO};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> written_{0};
+
+  std::mutex subscriberMutex_; // Drain thread and (un)subscribers only
+  std::vector<std::pair<int, Subscriber>> subscribers_;
+  int nextSubscriberId_ = 1;
+
+  std::mutex wakeMutex_;
+  std::condition_variable wakeCv_;
+  std::condition_variable flushedCv_;
+  bool stopping_ = false; // Guarded by wakeMutex_
+  std::thread drainThread_;
+};
+
+} // namespace GreedyTangle
+
+#define GT_LOG(level, tag, ...)                                               \
+  do {                                                                        \
+    auto &gtLogger_ = ::GreedyTangle::Logger::Instance();                     \
+    if (gtLogger_.IsEnabled(level)) {                                         \
+      gtLogger_.Log(level, tag, __VA_ARGS__);                                 \
+    }                                                                         \
+  } while (0)
+
+#define GT_LOG_VERBOSE(tag, ...)                                              \
+  GT_LOG(::GreedyTangle::LogLevel::VERBOSE, tag, __VA_ARGS__)
+#define GT_LOG_INFO(tag, ...)                                                 \
+  GT_LOG(::GreedyTangle::LogLevel::INFO, tag, __VA_ARGS__)
+#define GT_LOG_WARN(tag, ...)                                                 \
+  GT_LOG(::GreedyTangle::LogLevel::WARN, tag, __VA_ARGS__)
+#define GT_LOG_ERROR(tag, ...)                                                \
+  GT_LOG(::GreedyTangle::LogLevel::ERROR, tag, __VA_ARGS__)
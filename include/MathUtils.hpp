@@ -114,4 +114,100 @@ inline int CountIntersections(const std::vector<Node> &nodes,
   return count;
 }
 
+/**
+ * CountIntersections as if node movedId sat at movedPosition. Reads the
+ * node list without copying or changing it, so concurrent callers can
+ * share one list.
+ */
+inline int CountIntersectionsWithMove(const std::vector<Node> &nodes,
+                                      const std::vector<Edge> &edges,
+                                      int movedId, const Vec2 &movedPosition) {
+  auto positionOf = [&](int id) -> const Vec2 & {
+    return id == movedId ? movedPosition : nodes[id].position;
+  };
+
+  int count = 0;
+  size_t numEdges = edges.size();
+
+  for (size_t i = 0; i < numEdges; ++i) {
+    const Edge &e1 = edges[i];
+    const Vec2 &a = positionOf(e1.u_id);
+    const Vec2 &b = positionOf(e1.v_id);
+
+    for (size_t j = i + 1; j < numEdges; ++j) {
+      const Edge &e2 = edges[j];
+      if (e1.sharesVertex(e2)) {
+        continue;
+      }
+      if (CheckIntersection(a, b, positionOf(e2.u_id), positionOf(e2.v_id))) {
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Count intersections involving the given edges only
+ * (e.g. the edges incident to one node). Pairs within the list are skipped:
+ * edges incident to the same node share a vertex and never count.
+ * Moving that node changes the total by exactly the change in this value.
+ */
+inline int CountIncidentIntersections(const std::vector<Node> &nodes,
+                                      const std::vector<Edge> &edges,
+                                      const std::vector<int> &incidentEdges) {
+  int count = 0;
+
+  for (int edgeIndex : incidentEdges) {
+    const Edge &e1 = edges[edgeIndex];
+    const Vec2 &a = nodes[e1.u_id].position;
+    const Vec2 &b = nodes[e1.v_id].position;
+
+    for (const Edge &e2 : edges) {
+      if (e1.sharesVertex(e2)) {
+        continue;
+      }
+      if (CheckIntersection(a, b, nodes[e2.u_id].position,
+                            nodes[e2.v_id].position)) {
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+ * CountIncidentIntersections as if node movedId sat at movedPosition,
+ * without copying the node list (see CountIntersectionsWithMove)
+ */
+inline int CountIncidentIntersectionsWithMove(
+    const std::vector<Node> &nodes, const std::vector<Edge> &edges,
+    const std::vector<int> &incidentEdges, int movedId,
+    const Vec2 &movedPosition) {
+  auto positionOf = [&](int id) -> const Vec2 & {
+    return id == movedId ? movedPosition : nodes[id].position;
+  };
+
+  int count = 0;
+
+  for (int edgeIndex : incidentEdges) {
+    const Edge &e1 = edges[edgeIndex];
+    const Vec2 &a = positionOf(e1.u_id);
+    const Vec2 &b = positionOf(e1.v_id);
+
+    for (const Edge &e2 : edges) {
+      if (e1.sharesVertex(e2)) {
+        continue;
+      }
+      if (CheckIntersection(a, b, positionOf(e2.u_id), positionOf(e2.v_id))) {
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
 } // namespace GreedyTangle
@@ -7,6 +7,8 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #endif
+#include "RetainedLayer.hpp"
+#include "TextCache.hpp"
 #include <functional>
 #include <string>
 #include <vector>
@@ -68,6 +70,8 @@ public:
 private:
   SDL_Renderer *renderer = nullptr;
   TTF_Font *font = nullptr;
+  TextCache textCache; // Titles and items are drawn every frame
+  RetainedLayer layer; // Bar and open dropdowns, repainted on change
   std::vector<Menu> menus;
   int hoveredMenuIndex = -1;
   int hoveredItemIndex = -1;
@@ -119,6 +123,9 @@ public:
    */
   void SetItemChecked(int menuIndex, int itemIndex, bool checked);
 
+  // Repaint the bar on the next Render (lost render targets)
+  void InvalidateLayer() { layer.Invalidate(); }
+
   /**
    * Render text at a specific position (for external use)
    */
@@ -132,6 +139,7 @@ public:
 
 private:
   void RecalculateLayout();
+  void Paint(int windowWidth); // Bar and dropdowns, into the layer
   void RenderDropdown(const Menu &menu);
   int GetTextWidth(const std::string &text);
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#ifdef _WIN32
+#include <SDL.h>
+#else
+#include <SDL2/SDL.h>
+#endif
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * NodeSpriteAtlas - Pre-rasterized node circles drawn in one batch
+ *
+ * Each node radius gets two white sprites in one texture: the filled disc
+ * and the one-pixel border ring, rasterized with the same scanline and
+ * midpoint rules the per-pixel drawing used. Add() queues a node with its
+ * fill and border colors; Flush() draws the queue as tinted quads in a
+ * single SDL_RenderGeometry call, in queue order so later nodes still
+ * cover earlier ones.
+ *
+ * Renderers without SDL_RenderGeometry (SDL older than 2.0.18, or a
+ * backend that rejects it) get one color-modulated SDL_RenderCopy per
+ * sprite instead. Add() returns false when a node cannot be drawn from
+ * the atlas at all, and the caller draws it the old way.
+ */
+class NodeSpriteAtlas {
+public:
+  static constexpr int MAX_RADIUS = 64; // Larger nodes are drawn directly
+  static constexpr int MAX_RADII = 8;   // Distinct radii kept in the texture
+
+  NodeSpriteAtlas() = default;
+  ~NodeSpriteAtlas();
+
+  NodeSpriteAtlas(const NodeSpriteAtlas &) = delete;
+  NodeSpriteAtlas &operator=(const NodeSpriteAtlas &) = delete;
+
+  bool Init(SDL_Renderer *renderer);
+  void Destroy(); // Before the renderer goes away
+
+  // Queue a node centered on (cx, cy); false if it must be drawn directly
+  bool Add(int cx, int cy, int radius, SDL_Color fill, SDL_Color border);
+
+  // Draw and clear the queue
+  void Flush();
+
+private:
+  struct Sprite {
+    int radius = 0;
+    SDL_Rect fill;   // Texel rect of the disc
+    SDL_Rect border; // Texel rect of the ring
+  };
+
+  struct Instance {
+    int x, y;         // Top-left corner on screen
+    int sprite;       // Index into sprites_
+    SDL_Color fill;
+    SDL_Color border;
+  };
+
+  const Sprite *FindSprite(int radius);
+  bool Rasterize(); // Rebuild the texture for every radius in sprites_
+  void PushQuad(const SDL_Rect &src, int x, int y, SDL_Color color);
+  void FlushCopies();
+
+  SDL_Renderer *renderer_ = nullptr;
+  SDL_Texture *texture_ = nullptr;
+  int textureWidth_ = 0;
+  int textureHeight_ = 0;
+  bool geometrySupported_ = true; // Cleared after SDL_RenderGeometry fails
+  bool failed_ = false;           // Texture creation failed; draw directly
+
+  std::vector<Sprite> sprites_;
+  std::vector<Instance> queue_;
+  std::vector<SDL_Vertex> vertices_; // Rebuilt by each Flush
+  std::vector<int> indices_;         // Two triangles per quad, grown once
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "ICPUSolver.hpp"
+#include "PuzzleGenerator.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * CorpusEntry - Puzzle size and move budget for one solver in the corpus
+ */
+struct CorpusEntry {
+  SolverMode mode = SolverMode::GREEDY;
+  int nodeCount = 10;
+  int maxMoves = 4;
+};
+
+/**
+ * RegressionCorpus - The fixed set of seeded puzzles a baseline was taken on
+ *
+ * Every trial runs a fixed number of moves with no time limit, so the work
+ * done per repetition is identical and only the wall time can change.
+ * Sizes are per solver so that each one costs a few seconds per pass;
+ * Backtracking is exponential and gets the smallest puzzles.
+ */
+struct RegressionCorpus {
+  std::vector<CorpusEntry> entries = {
+      {SolverMode::GREEDY, 12, 4},
+      {SolverMode::BACKTRACKING, 8, 2},
+      {SolverMode::DIVIDE_AND_CONQUER_DP, 16, 4}};
+  std::vector<PuzzleFamily> families = {PuzzleFamily::CYCLE_CHORDS,
+                                        PuzzleFamily::GRID_MESH,
+                                        PuzzleFamily::TRIANGULATION};
+  std::vector<uint32_t> seeds = {1, 2};
+  int repetitions = 5; // Corpus passes; each metric is a median over these
+};
+
+/**
+ * MetricSample - Median and median absolute deviation over repetitions
+ */
+struct MetricSample {
+  double median = 0.0;
+  double mad = 0.0;
+
+  static MetricSample From(std::vector<double> values);
+};
+
+/**
+ * SolverPerf - One solver's cost over the whole corpus
+ *
+ * moves and finalIntersections are summed over the corpus. Solvers are
+ * deterministic, so a change there means the solver now plays differently.
+ */
+struct SolverPerf {
+  SolverMode mode = SolverMode::GREEDY;
+  std::string solverName;
+  MetricSample msPerMove;          // Wall time per FindBestMove call
+  MetricSample pairTestsPerSecond; // Segment pair tests per second of search
+  int searches = 0;
+  int moves = 0;
+  int finalIntersections = 0;
+};
+
+/**
+ * BuildConfig - How the binary that took a measurement was built
+ *
+ * Optimization flags and the instrumentation options move the timings by
+ * far more than the tolerance, so a baseline only gates a binary built
+ * the same way.
+ */
+struct BuildConfig {
+  std::string buildType; // CMAKE_BUILD_TYPE, "None" when unset
+  std::string compiler;  // Compiler id and version
+  std::string flags;     // CMAKE_CXX_FLAGS plus the build type's flags
+  std::string options;   // Tracing, allocation tracking, crossing checks
+
+  static BuildConfig Current();
+};
+
+struct PerfBaseline {
+  RegressionCorpus corpus;
+  BuildConfig build;
+  std::vector<SolverPerf> solvers;
+};
+
+/**
+ * RegressionCheck - One metric of one solver, current run vs. baseline
+ *
+ * A metric regresses when it is worse than the baseline by more than
+ * threshold, the larger of the relative tolerance and madMultiplier times
+ * the combined MAD of both runs, scaled to a standard deviation. Anything
+ * inside that band is noise.
+ */
+struct RegressionCheck {
+  std::string solverName;
+  std::string metric;
+  bool higherIsBetter = false;
+  double baseline = 0.0;
+  double current = 0.0;
+  double threshold = 0.0; // Allowed absolute change in the bad direction
+  bool regressed = false;
+  bool improved = false; // Better by more than threshold
+
+  double ChangePercent() const {
+    return baseline != 0.0 ? 100.0 * (current - baseline) / baseline : 0.0;
+  }
+};
+
+struct RegressionResult {
+  std::vector<RegressionCheck> checks;
+  std::vector<std::string> notes; // Behaviour changes and missing solvers
+  bool passed = true;
+};
+
+/**
+ * PerfRegression - Measures the corpus and compares it with a baseline
+ *
+ * Trials run one at a time on the calling thread so that timings are not
+ * skewed by other trials competing for cores.
+ */
+class PerfRegression {
+public:
+  static constexpr double DEFAULT_TOLERANCE = 0.15;     // 15% slower
+  static constexpr double DEFAULT_MAD_MULTIPLIER = 3.0; // Noise band width
+
+  static std::vector<SolverPerf> Measure(const RegressionCorpus &corpus);
+
+  static RegressionResult
+  Compare(const PerfBaseline &baseline, const std::vector<SolverPerf> &current,
+          double tolerance = DEFAULT_TOLERANCE,
+          double madMultiplier = DEFAULT_MAD_MULTIPLIER);
+
+  /**
+   * One line per field where the baseline's build differs from current;
+   * empty when the two are comparable
+   */
+  static std::vector<std::string> BuildMismatches(const BuildConfig &baseline,
+                                                  const BuildConfig &current);
+
+  static bool WriteBaseline(const PerfBaseline &baseline, std::ostream &out);
+  // Fills error with a readable reason on failure
+  static bool ReadBaseline(std::istream &in, PerfBaseline &baseline,
+                           std::string &error);
+
+  // Aligned table of every check, then the notes and a verdict line
+  static void WriteReport(const RegressionResult &result, std::ostream &out);
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "GraphData.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * Graph families used for benchmarking. They mirror the in-game
+ * difficulties (Easy / Medium / Hard) but are fully determined by a seed,
+ * so any benchmark trial can be reproduced exactly.
+ */
+enum class PuzzleFamily {
+  CYCLE_CHORDS,  // Hamiltonian cycle plus a few non-crossing chords
+  GRID_MESH,     // Grid with ~22% of edges removed
+  TRIANGULATION  // Maximal planar graph built by splitting faces
+};
+
+const char *PuzzleFamilyName(PuzzleFamily family);
+
+// Short stable names ("cycle", "grid", "triangulation") for CLIs and files
+const char *PuzzleFamilyKey(PuzzleFamily family);
+bool PuzzleFamilyFromKey(const std::string &key, PuzzleFamily &family);
+
+/**
+ * Puzzle - A planar graph scrambled onto a circle, ready to solve
+ */
+struct Puzzle {
+  PuzzleFamily family = PuzzleFamily::CYCLE_CHORDS;
+  uint32_t seed = 0;
+  std::vector<Node> nodes; // Tangled positions, adjacency lists filled in
+  std::vector<Edge> edges;
+};
+
+/**
+ * Generate a tangled puzzle of the given family. The same
+ * (family, nodeCount, seed) always yields the same graph and layout.
+ * No SDL dependency, so benchmark tools can use it headless.
+ */
+Puzzle GeneratePuzzle(PuzzleFamily family, int nodeCount, uint32_t seed,
+                      float width = 1024.0f, float height = 768.0f);
+
+} // namespace GreedyTangle
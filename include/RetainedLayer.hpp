@@ -0,0 +1,92 @@
+#pragma once
+
+#ifdef _WIN32
+#include <SDL.h>
+#else
+#include <SDL2/SDL.h>
+#endif
+#include <cstdint>
+#include <string_view>
+
+namespace GreedyTangle {
+
+/**
+ * RetainedLayer - A UI panel cached in a render target texture
+ *
+ * Draw() repaints the panel into an output-sized target texture only when
+ * the key built from its inputs changes, the output is resized, or
+ * Invalidate() was called; every other frame it is a single copy of the
+ * panel's bounds. Paint code keeps drawing in screen coordinates.
+ *
+ * Painting with SDL_BLENDMODE_BLEND onto a target cleared to transparent
+ * black leaves premultiplied color in the texture, so it is composited
+ * with a premultiplied "over" blend mode. Renderers without render
+ * targets or custom blend modes paint directly every frame.
+ */
+class RetainedLayer {
+public:
+  /**
+   * Key - FNV-1a hash of everything a panel's pixels depend on
+   */
+  class Key {
+  public:
+    Key &Add(uint64_t value);
+    Key &Add(int value) { return Add(static_cast<uint64_t>(value)); }
+    Key &Add(bool value) { return Add(static_cast<uint64_t>(value)); }
+    Key &Add(double value);
+    Key &Add(std::string_view text);
+
+    uint64_t Value() const { return hash_; }
+
+  private:
+    void Mix(const void *data, size_t size);
+
+    uint64_t hash_ = 14695981039346656037ull;
+  };
+
+  RetainedLayer() = default;
+  ~RetainedLayer();
+
+  RetainedLayer(const RetainedLayer &) = delete;
+  RetainedLayer &operator=(const RetainedLayer &) = delete;
+
+  template <typename Paint>
+  void Draw(SDL_Renderer *renderer, const SDL_Rect &bounds, const Key &key,
+            Paint &&paint) {
+    Mode mode = Prepare(renderer, key.Value());
+    if (mode == Mode::DIRECT) {
+      paint();
+      return;
+    }
+    if (mode == Mode::REPAINT) {
+      paint();
+      FinishRepaint(renderer);
+    }
+    Composite(renderer, bounds);
+  }
+
+  // Repaint on the next Draw (new results, lost render targets)
+  void Invalidate() { valid_ = false; }
+
+  void Destroy(); // Before the renderer goes away
+
+  uint64_t Repaints() const { return repaints_; }
+
+private:
+  enum class Mode { DIRECT, REPAINT, CACHED };
+
+  Mode Prepare(SDL_Renderer *renderer, uint64_t key);
+  void FinishRepaint(SDL_Renderer *renderer);
+  void Composite(SDL_Renderer *renderer, const SDL_Rect &bounds);
+
+  SDL_Texture *texture_ = nullptr;
+  SDL_Texture *previousTarget_ = nullptr; // Restored after a repaint
+  int width_ = 0;
+  int height_ = 0;
+  uint64_t key_ = 0;
+  bool valid_ = false;
+  bool unsupported_ = false; // Paint directly from now on
+  uint64_t repaints_ = 0;
+};
+
+} // namespace GreedyTangle
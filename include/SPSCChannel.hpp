@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace GreedyTangle {
+
+/**
+ * SPSCChannel - Bounded lock-free single-producer/single-consumer queue
+ *
+ * One thread pushes, one thread pops; neither ever blocks. When the ring is
+ * full TryPush fails and the caller decides whether the item can be dropped.
+ * Capacity must be a power of two.
+ */
+template <typename T, size_t Capacity> class SPSCChannel {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SPSCChannel capacity must be a power of two");
+
+public:
+  SPSCChannel() = default;
+  SPSCChannel(const SPSCChannel &) = delete;
+  SPSCChannel &operator=(const SPSCChannel &) = delete;
+
+  /**
+   * Producer side: enqueue a copy of item. Returns false if the ring is full.
+   */
+  bool TryPush(const T &item) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cachedHead_ == Capacity) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      if (tail - cachedHead_ == Capacity) {
+        return false;
+      }
+    }
+    slots_[tail & (Capacity - 1)] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer side: dequeue the oldest item. Returns false if empty.
+   */
+  bool TryPop(T &out) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cachedTail_) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      if (head == cachedTail_) {
+        return false;
+      }
+    }
+    out = slots_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer side: discard everything currently queued.
+   */
+  void Clear() {
+    T discarded;
+    while (TryPop(discarded)) {
+    }
+  }
+
+private:
+  static constexpr size_t CACHE_LINE = 64;
+
+  // Producer and consumer indices live on separate cache lines; each side
+  // keeps a private copy of the other's index to avoid needless sharing.
+  alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+  size_t cachedHead_ = 0;
+  alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+  size_t cachedTail_ = 0;
+  alignas(CACHE_LINE) std::array<T, Capacity> slots_{};
+};
+
+} // namespace GreedyTangle
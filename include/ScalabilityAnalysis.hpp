@@ -0,0 +1,131 @@
+#pragma once
+
+#include "BenchmarkRunner.hpp"
+#include "ICPUSolver.hpp"
+#include "PuzzleGenerator.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace GreedyTangle {
+
+struct ScalabilityConfig {
+  std::vector<SolverMode> modes = {SolverMode::GREEDY, SolverMode::BACKTRACKING,
+                                   SolverMode::DIVIDE_AND_CONQUER_DP};
+  PuzzleFamily family = PuzzleFamily::CYCLE_CHORDS;
+  int minNodes = 10;
+  int maxNodes = 10240;
+  double growth = 2.0; // Ratio between consecutive ladder sizes
+  std::vector<uint32_t> seeds = {1, 2, 3};
+  int maxMoves = 30;
+  float trialTimeLimit = 10.0f;  // Seconds per trial, enforced mid-search
+  float sweepTimeLimit = 120.0f; // Seconds for the whole ladder; 0 = none
+  std::atomic<bool> *cancelFlag = nullptr;
+  ThreadPool *solverPool = nullptr; // Lets each search fan out; null = serial
+};
+
+/**
+ * ScalabilityPoint - One solver at one ladder size, summarized over seeds
+ */
+struct ScalabilityPoint {
+  SolverMode mode = SolverMode::GREEDY;
+  std::string solverName;
+  int nodeCount = 0;
+  int edgeCount = 0; // Of the first seed's puzzle
+  int trials = 0;
+  int solvedTrials = 0;
+  bool censored = false; // A trial hit a time limit: totals are lower bounds
+  bool tooSlow = false;  // A trial could not finish a single search
+  Distribution timeMs;
+  Distribution msPerMove; // Wall time per completed FindBestMove call
+  Distribution moves;
+};
+
+/**
+ * ComplexityFit - Least-squares fit of log(time) = log(c) + k * log(N)
+ *
+ * The exponent k is the empirical complexity; ciLow / ciHigh bound it at
+ * 95% confidence using Student's t on the slope's standard error.
+ */
+struct ComplexityFit {
+  int samples = 0;
+  double exponent = 0.0;
+  double ciLow = 0.0;
+  double ciHigh = 0.0;
+  double coefficient = 0.0; // Predicted ms at N = 1
+  double rSquared = 0.0;
+
+  bool IsValid() const { return samples >= 3; }
+  double Predict(double nodeCount) const;
+};
+
+/**
+ * SolverScaling - Power-law fits for one solver across the ladder
+ *
+ * totalTime only uses sizes where every trial finished in time; perMove
+ * also uses time-limited trials, since their completed searches are still
+ * exact measurements.
+ */
+struct SolverScaling {
+  SolverMode mode = SolverMode::GREEDY;
+  std::string solverName;
+  ComplexityFit totalTime; // Time to solve or stall, capped at maxMoves
+  ComplexityFit perMove;   // Time per search, the cost the solver docs quote
+  int largestCompleted = 0; // Largest N where every trial finished in time
+};
+
+struct ScalabilityReport {
+  ScalabilityConfig config;
+  std::vector<int> sizes; // Ladder sizes that were attempted
+  std::vector<BenchmarkTrial> trials;
+  std::vector<ScalabilityPoint> points; // Ladder order, then config.modes
+  std::vector<SolverScaling> solvers;   // config.modes order
+  int64_t sweepMs = 0;
+  bool cutShort = false; // Sweep deadline or cancellation ended the ladder
+};
+
+/**
+ * ScalabilityAnalysis - Empirical complexity over a geometric size ladder
+ *
+ * Each rung runs every active solver on every seed concurrently. A watchdog
+ * on the calling thread cancels any trial that outlives trialTimeLimit, so
+ * a single oversized search cannot stall the ladder. Once a solver cannot
+ * finish even one search within the limit it is dropped from larger rungs.
+ */
+class ScalabilityAnalysis {
+public:
+  explicit ScalabilityAnalysis(ThreadPool &pool) : pool_(pool) {}
+
+  ScalabilityReport Run(const ScalabilityConfig &config);
+
+  /**
+   * minNodes, minNodes * growth, ... up to maxNodes, strictly increasing
+   */
+  static std::vector<int> SizeLadder(int minNodes, int maxNodes,
+                                     double growth);
+
+  static ComplexityFit FitPowerLaw(const std::vector<double> &nodeCounts,
+                                   const std::vector<double> &values);
+
+  // One row per trial, for spreadsheets and plotting scripts
+  static bool WriteCSV(const ScalabilityReport &report, std::ostream &out);
+  static bool WriteCSV(const ScalabilityReport &report,
+                       const std::string &path);
+  // Config, per-size summaries, fits and trials
+  static bool WriteJSON(const ScalabilityReport &report, std::ostream &out);
+  static bool WriteJSON(const ScalabilityReport &report,
+                        const std::string &path);
+
+private:
+  std::vector<BenchmarkTrial> RunRung(const ScalabilityConfig &config,
+                                      const std::vector<SolverMode> &modes,
+                                      int nodeCount, int64_t deadlineNs,
+                                      bool &cutShort);
+
+  ThreadPool &pool_;
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "GraphData.hpp"
+#include "SpatialGrid.hpp"
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * SceneIndex - Spatial index of a live layout's nodes and edges
+ *
+ * Update() compares node positions with the ones it saw last time and
+ * re-files only the moved nodes and their incident edges, so a drag
+ * costs O(degree) grid work on top of the O(N) position scan. A new
+ * graph, or a frame that moves more than REBUILD_FRACTION of the nodes
+ * (the tangle animation), rebuilds both grids over the layout's bounds.
+ *
+ * The node grid also answers hit tests: NodeAt() only looks at the nodes
+ * filed in the cell under the cursor. Code that moves a single node
+ * between frames (a drag, an auto-solve step) reports it with MoveNode()
+ * so hit tests see the new position before the next Update().
+ */
+class SceneIndex {
+public:
+  static constexpr float CELL_SIZE = 128.0f; // World units
+  static constexpr float REBUILD_FRACTION = 0.25f;
+
+  void Update(const std::vector<Node> &nodes, const std::vector<Edge> &edges);
+
+  // Rebuild on the next Update
+  void Invalidate() { valid_ = false; }
+
+  // True once Update() has filed a node list of this size
+  bool Tracks(const std::vector<Node> &nodes) const {
+    return valid_ && positions_.size() == nodes.size();
+  }
+
+  // Re-file nodes[id] and its edges now; Update() then sees it unmoved
+  void MoveNode(const std::vector<Node> &nodes, int id);
+
+  /**
+   * Index of the topmost (highest index) node whose hitbox contains
+   * point, or -1. Expected O(1) for nodes spread over the grid.
+   */
+  int NodeAt(const std::vector<Node> &nodes, const Vec2 &point) const;
+
+  /**
+   * Nodes whose bounds and edges whose segments intersect area, in index
+   * order so they draw in the same stacking order as a full pass
+   */
+  void Query(const Rect &area, std::vector<int> &visibleNodes,
+             std::vector<int> &visibleEdges) const;
+
+  // Just the nodes, in index order
+  void QueryNodes(const Rect &area, std::vector<int> &visibleNodes) const;
+
+private:
+  bool SameGraph(const std::vector<Node> &nodes,
+                 const std::vector<Edge> &edges) const;
+  void Rebuild(const std::vector<Node> &nodes, const std::vector<Edge> &edges);
+  void Refile(const std::vector<Node> &nodes, int id);
+  static Rect NodeBox(const Node &node);
+
+  SpatialGrid nodeGrid_;
+  SpatialGrid edgeGrid_;
+  std::vector<Vec2> positions_;            // Node positions last filed
+  std::vector<Edge> endpoints_;            // Edge list last filed
+  std::vector<std::vector<int>> incident_; // Node -> indices of its edges
+  bool valid_ = false;
+
+  // Scratch reused between updates and hit tests
+  std::vector<int> movedNodes_;
+  mutable std::vector<int> hits_;
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace GreedyTangle {
+
+/**
+ * SolverArena - Per-search scratch memory for a solver
+ *
+ * A monotonic buffer that FindBestMove resets on entry, so the candidate
+ * lists, partitions and DP tables of one search are carved out of a single
+ * block and dropped together. A search that outgrows the block spills to
+ * the heap, and the next Reset grows the block to fit, so after the first
+ * few moves a solver stops touching the global allocator.
+ *
+ * Allocation is serialized with a spinlock so ParallelFor workers can share
+ * one arena; allocate per node or per partition, not per candidate.
+ */
+class SolverArena : public std::pmr::memory_resource {
+public:
+  static constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+  static constexpr size_t MAX_CAPACITY = 16 * 1024 * 1024; // Spill beyond
+
+  explicit SolverArena(size_t capacity = INITIAL_CAPACITY);
+
+  SolverArena(const SolverArena &) = delete;
+  SolverArena &operator=(const SolverArena &) = delete;
+
+  /**
+   * Drop everything allocated since the last Reset. Containers still
+   * pointing into the arena must be gone by then.
+   */
+  void Reset();
+
+  size_t Capacity() const { return capacity_; }
+
+private:
+  /**
+   * SpillCounter - Heap upstream that remembers how much it handed out
+   */
+  class SpillCounter : public std::pmr::memory_resource {
+  public:
+    size_t bytes = 0;
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+  };
+
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *, size_t, size_t) override {} // Freed by Reset
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::unique_ptr<std::byte[]> buffer_;
+  size_t capacity_;
+  SpillCounter spill_;
+  std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+  std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+};
+
+} // namespace GreedyTangle
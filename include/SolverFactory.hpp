@@ -2,9 +2,14 @@
 
 #include "ICPUSolver.hpp"
 #include <memory>
+#include <string>
 
 namespace GreedyTangle {
 
 std::unique_ptr<ICPUSolver> CreateSolver(SolverMode mode);
 
+// Short stable names ("greedy", "backtracking", "dnc") for CLIs and files
+const char *SolverModeKey(SolverMode mode);
+bool SolverModeFromKey(const std::string &key, SolverMode &mode);
+
 }
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "AllocationTracker.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace GreedyTangle {
+
+/**
+ * SolverStatsSnapshot - Plain copy of a SolverStats block at one instant
+ *
+ * Phase timings are summed across worker threads, so for a parallel solver
+ * generation + evaluation can exceed the wall-clock searchNs.
+ */
+struct SolverStatsSnapshot {
+  uint64_t calls = 0;               // FindBestMove invocations
+  uint64_t candidatesEvaluated = 0; // Candidate positions scored
+  uint64_t pairTests = 0;           // Segment pairs examined while counting
+  uint64_t prunedCandidates = 0;    // Candidates discarded without expansion
+  uint64_t cacheHits = 0;           // Evaluations answered from a cache
+  uint64_t searchNs = 0;            // Wall time inside FindBestMove
+  uint64_t generationNs = 0;        // Candidate generation / partitioning
+  uint64_t evaluationNs = 0;        // Candidate evaluation loops
+  uint64_t fallbackNs = 0;          // Stuck / fallback searches
+  uint64_t allocations = 0;         // Heap allocations inside FindBestMove
+  uint64_t allocatedBytes = 0;      // Bytes requested by those allocations
+  uint64_t peakBytes = 0;           // Largest single-search high-water mark
+
+  SolverStatsSnapshot operator-(const SolverStatsSnapshot &other) const {
+    SolverStatsSnapshot d;
+    d.calls = calls - other.calls;
+    d.candidatesEvaluated = candidatesEvaluated - other.candidatesEvaluated;
+    d.pairTests = pairTests - other.pairTests;
+    d.prunedCandidates = prunedCandidates - other.prunedCandidates;
+    d.cacheHits = cacheHits - other.cacheHits;
+    d.searchNs = searchNs - other.searchNs;
+    d.generationNs = generationNs - other.generationNs;
+    d.evaluationNs = evaluationNs - other.evaluationNs;
+    d.fallbackNs = fallbackNs - other.fallbackNs;
+    d.allocations = allocations - other.allocations;
+    d.allocatedBytes = allocatedBytes - other.allocatedBytes;
+    d.peakBytes = peakBytes; // A high-water mark does not subtract
+    return d;
+  }
+
+  double EvaluationsPerSecond() const {
+    return searchNs > 0 ? candidatesEvaluated * 1e9 / searchNs : 0.0;
+  }
+
+  double PairTestsPerSecond() const {
+    return searchNs > 0 ? pairTests * 1e9 / searchNs : 0.0;
+  }
+
+  double AllocationsPerCall() const {
+    return calls > 0 ? static_cast<double>(allocations) / calls : 0.0;
+  }
+};
+
+/**
+ * SolverStats - Live per-solver counters
+ *
+ * Every field is a relaxed atomic, so solver threads update it without
+ * synchronization and the UI can sample it mid-search.
+ */
+struct SolverStats {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> candidatesEvaluated{0};
+  std::atomic<uint64_t> pairTests{0};
+  std::atomic<uint64_t> prunedCandidates{0};
+  std::atomic<uint64_t> cacheHits{0};
+  std::atomic<uint64_t> searchNs{0};
+  std::atomic<uint64_t> generationNs{0};
+  std::atomic<uint64_t> evaluationNs{0};
+  std::atomic<uint64_t> fallbackNs{0};
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> allocatedBytes{0};
+  std::atomic<uint64_t> peakBytes{0};
+
+  static void Add(std::atomic<uint64_t> &counter, uint64_t amount = 1) {
+    counter.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  static void Max(std::atomic<uint64_t> &counter, uint64_t value) {
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    while (value > current &&
+           !counter.compare_exchange_weak(current, value,
+                                          std::memory_order_relaxed)) {
+    }
+  }
+
+  SolverStatsSnapshot Snapshot() const {
+    SolverStatsSnapshot s;
+    s.calls = calls.load(std::memory_order_relaxed);
+    s.candidatesEvaluated = candidatesEvaluated.load(std::memory_order_relaxed);
+    s.pairTests = pairTests.load(std::memory_order_relaxed);
+    s.prunedCandidates = prunedCandidates.load(std::memory_order_relaxed);
+    s.cacheHits = cacheHits.load(std::memory_order_relaxed);
+    s.searchNs = searchNs.load(std::memory_order_relaxed);
+    s.generationNs = generationNs.load(std::memory_order_relaxed);
+    s.evaluationNs = evaluationNs.load(std::memory_order_relaxed);
+    s.fallbackNs = fallbackNs.load(std::memory_order_relaxed);
+    s.allocations = allocations.load(std::memory_order_relaxed);
+    s.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+    s.peakBytes = peakBytes.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  // Fold another solver's work into this block (e.g. a nested fallback)
+  void Merge(const SolverStatsSnapshot &other) {
+    Add(candidatesEvaluated, other.candidatesEvaluated);
+    Add(pairTests, other.pairTests);
+    Add(prunedCandidates, other.prunedCandidates);
+    Add(cacheHits, other.cacheHits);
+  }
+
+  void Reset() {
+    for (auto *counter :
+         {&calls, &candidatesEvaluated, &pairTests, &prunedCandidates,
+          &cacheHits, &searchNs, &generationNs, &evaluationNs, &fallbackNs,
+          &allocations, &allocatedBytes, &peakBytes}) {
+      counter->store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+/**
+ * ScopedPhaseTimer - Adds the lifetime of a scope, in ns, to a counter
+ */
+class ScopedPhaseTimer {
+public:
+  explicit ScopedPhaseTimer(std::atomic<uint64_t> &counter)
+      : counter_(counter), start_(std::chrono::steady_clock::now()) {}
+
+  ~ScopedPhaseTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    SolverStats::Add(
+        counter_,
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()));
+  }
+
+  ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+  ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+
+private:
+  std::atomic<uint64_t> &counter_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * ScopedSearchAllocations - Charges a search's heap use to a stats block
+ *
+ * Always zero unless built with GREEDY_TANGLE_TRACK_ALLOCATIONS.
+ */
+class ScopedSearchAllocations {
+public:
+  explicit ScopedSearchAllocations(SolverStats &stats)
+      : stats_(stats), scope_(AllocTag::SOLVER_SEARCH) {}
+
+  ~ScopedSearchAllocations() {
+    AllocCounters used = scope_.Counters();
+    SolverStats::Add(stats_.allocations, used.allocations);
+    SolverStats::Add(stats_.allocatedBytes, used.bytes);
+    SolverStats::Max(stats_.peakBytes, used.peakBytes);
+  }
+
+  ScopedSearchAllocations(const ScopedSearchAllocations &) = delete;
+  ScopedSearchAllocations &operator=(const ScopedSearchAllocations &) = delete;
+
+private:
+  SolverStats &stats_;
+  AllocScope scope_;
+};
+
+} // namespace GreedyTangle
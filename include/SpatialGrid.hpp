@@ -0,0 +1,88 @@
+#pragma once
+
+#include "GraphData.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * SpatialGrid - Uniform grid of boxes for area queries
+ *
+ * Items are small integer ids (node or edge indices), each filed under
+ * every cell its box overlaps. The grid covers a fixed area; boxes that
+ * stick out of it are filed under the border cells, so queries stay
+ * correct when items move off the area, just slower.
+ *
+ * Boxes spanning more than MAX_ITEM_CELLS cells (long edges across a
+ * tangled layout) are kept in one list that every query scans instead,
+ * which keeps Insert/Update cheap for them.
+ */
+class SpatialGrid {
+public:
+  static constexpr int MAX_CELLS_PER_AXIS = 256;
+  static constexpr int MAX_ITEM_CELLS = 64;
+
+  /**
+   * Drop every item and lay cells of about cellSize over area, for ids
+   * in [0, itemCount)
+   */
+  void Reset(const Rect &area, float cellSize, size_t itemCount);
+
+  // File item under box; the item must not be in the grid
+  void Insert(int item, const Rect &box);
+
+  // Move item to a new box, touching the cells only if they change
+  void Update(int item, const Rect &box);
+
+  void Remove(int item);
+
+  /**
+   * Replace out with the items whose boxes intersect area, each once,
+   * in no particular order
+   */
+  void Query(const Rect &area, std::vector<int> &out) const;
+
+  const Rect &Box(int item) const { return items_[item].box; }
+  size_t ItemCount() const { return items_.size(); }
+
+private:
+  struct CellRange {
+    int x0 = 0, y0 = 0, x1 = -1, y1 = -1; // Inclusive; empty if x1 < x0
+
+    bool operator==(const CellRange &other) const {
+      return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 &&
+             y1 == other.y1;
+    }
+    bool operator!=(const CellRange &other) const { return !(*this == other); }
+  };
+
+  struct Item {
+    Rect box;
+    CellRange cells;
+    bool filed = false;
+    bool oversized = false; // In oversized_ rather than the cells
+  };
+
+  CellRange RangeFor(const Rect &box) const;
+  static int CellCount(const CellRange &range) {
+    return (range.x1 - range.x0 + 1) * (range.y1 - range.y0 + 1);
+  }
+  void File(int item);
+  void Unfile(int item);
+
+  Rect area_;
+  float cellWidth_ = 1.0f;
+  float cellHeight_ = 1.0f;
+  int columns_ = 0;
+  int rows_ = 0;
+  std::vector<std::vector<int>> cells_;
+  std::vector<int> oversized_;
+  std::vector<Item> items_;
+
+  // Query deduplication: an item is reported once per stamp
+  mutable std::vector<uint32_t> stamps_;
+  mutable uint32_t stamp_ = 0;
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,149 @@
+#pragma once
+
+#ifdef _WIN32
+#include <SDL.h>
+#include <SDL_ttf.h>
+#else
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#endif
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * TextCache - Rendered strings kept as textures between frames
+ *
+ * Composed strings live in an LRU keyed by (font, text, color) under a
+ * byte budget, so a static label costs one SDL_RenderCopy per frame.
+ *
+ * A string is only composed with SDL_ttf the second time it is asked
+ * for. The first time, printable ASCII is drawn from a per-font glyph
+ * atlas (white glyphs tinted through vertex colors), which keeps
+ * counters and timers that change every frame from churning the LRU.
+ * Strings with other characters are composed right away.
+ *
+ * Textures belong to the renderer passed to Init(); Clear() them before
+ * the renderer is destroyed.
+ */
+class TextCache {
+public:
+  static constexpr size_t TEXTURE_BUDGET_BYTES = 8 * 1024 * 1024;
+  static constexpr size_t MAX_ENTRIES = 1024;
+  static constexpr size_t MAX_SEEN = 4096; // Strings waiting for a 2nd use
+
+  enum class Align { TOP_LEFT, CENTER };
+
+  struct Extent {
+    int w = 0;
+    int h = 0;
+  };
+
+  TextCache() = default;
+  ~TextCache();
+
+  TextCache(const TextCache &) = delete;
+  TextCache &operator=(const TextCache &) = delete;
+
+  void Init(SDL_Renderer *renderer);
+  void Clear(); // Destroy every texture
+
+  // Size Draw() would give the text
+  Extent Measure(TTF_Font *font, const std::string &text);
+
+  // Draw with (x, y) as the top-left corner or the center; returns the size
+  Extent Draw(TTF_Font *font, const std::string &text, SDL_Color color,
+              int x, int y, Align align = Align::TOP_LEFT);
+
+  uint64_t Hits() const { return hits_; }
+  uint64_t Misses() const { return misses_; }
+  size_t TextureBytes() const { return textureBytes_; }
+
+private:
+  static constexpr char FIRST_GLYPH = ' ';
+  static constexpr char LAST_GLYPH = '~';
+  static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+
+  struct Key {
+    TTF_Font *font;
+    std::string text;
+    uint32_t color;
+  };
+
+  // Index key; text views the string owned by the Entry (or the caller's)
+  struct KeyView {
+    TTF_Font *font;
+    std::string_view text;
+    uint32_t color;
+
+    bool operator==(const KeyView &other) const {
+      return font == other.font && color == other.color && text == other.text;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const KeyView &key) const;
+  };
+
+  struct Entry {
+    Key key;
+    SDL_Texture *texture = nullptr;
+    Extent extent;
+  };
+
+  using EntryList = std::list<Entry>; // Most recently used first
+
+  /**
+   * GlyphAtlas - Printable ASCII of one font, rendered white
+   */
+  struct GlyphAtlas {
+    SDL_Texture *texture = nullptr; // Null if the font could not be packed
+    int sheetWidth = 0;
+    int sheetHeight = 0;
+    int height = 0; // Line height, as TTF_RenderText_Blended uses
+    std::array<SDL_Rect, GLYPH_COUNT> cells{}; // Texel rect of each glyph
+    std::array<int, GLYPH_COUNT> offsets{};    // Cell left edge vs pen
+    std::array<int, GLYPH_COUNT> advances{};
+  };
+
+  static uint32_t PackColor(SDL_Color color);
+  static bool IsAtlasText(const std::string &text);
+
+  const Entry *Find(const KeyView &key);
+  const Entry *Compose(TTF_Font *font, const std::string &text,
+                       SDL_Color color);
+  void EvictToBudget();
+
+  const GlyphAtlas &AtlasFor(TTF_Font *font);
+  bool BuildAtlas(TTF_Font *font, GlyphAtlas &atlas);
+  int Kerning(TTF_Font *font, char previous, char current) const;
+  Extent MeasureGlyphs(TTF_Font *font, const GlyphAtlas &atlas,
+                       const std::string &text) const;
+  void DrawGlyphs(TTF_Font *font, const GlyphAtlas &atlas,
+                  const std::string &text, SDL_Color color, int x, int y);
+
+  SDL_Renderer *renderer_ = nullptr;
+  bool geometrySupported_ = true;
+
+  EntryList entries_;
+  std::unordered_map<KeyView, EntryList::iterator, KeyHash> index_;
+  std::unordered_set<size_t> seen_; // Hashes of strings drawn once
+  size_t textureBytes_ = 0;
+
+  std::unordered_map<TTF_Font *, GlyphAtlas> atlases_;
+  std::vector<SDL_Vertex> vertices_;
+  std::vector<int> indices_;
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+} // namespace GreedyTangle
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GreedyTangle {
+
+/**
+ * Persistent work-stealing executor shared by the engine, the solvers and
+ * every background job (CPU moves, heatmap, benchmarks, parallel counting).
+ *
+ * Each worker owns a deque: it pops its own tasks from the back and, when
+ * empty, steals from the front of the other workers' deques. Tasks submitted
+ * from outside the pool are spread round-robin across the deques; tasks
+ * submitted from a worker go to that worker's own deque.
+ */
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  /**
+   * Start the workers. A count of 0 sizes the pool from
+   * std::thread::hardware_concurrency().
+   */
+  explicit ThreadPool(size_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * Queue a callable and return a future for its result.
+   */
+  template <typename F>
+  auto Submit(F &&fn) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto task =
+        std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+    std::future<Result> result = task->get_future();
+    Enqueue([task]() { (*task)(); });
+    return result;
+  }
+
+  /**
+   * Run body(i) for every i in [begin, end) across the pool and return once
+   * all iterations are done. The calling thread takes part and never waits
+   * for a helper that has not started, so this is safe to call from the UI
+   * thread and from inside a pool task.
+   */
+  void ParallelFor(size_t begin, size_t end,
+                   const std::function<void(size_t)> &body);
+
+  /**
+   * Block until the future is ready. Called from a worker, queued tasks are
+   * run in the meantime so waiting on nested work never starves the pool.
+   */
+  template <typename T> void Wait(std::future<T> &future) {
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (!RunPendingTask()) {
+        future.wait_for(std::chrono::microseconds(200));
+      }
+    }
+  }
+
+  /**
+   * Execute one queued task if the caller is one of this pool's workers.
+   */
+  bool RunPendingTask();
+
+  size_t GetThreadCount() const { return workers_.size(); }
+
+  /**
+   * Index of the calling thread among this pool's workers, or
+   * GetThreadCount() for any other thread. ParallelFor bodies can keep
+   * per-thread scratch in GetThreadCount() + 1 slots indexed by this.
+   */
+  size_t CurrentThreadSlot() const;
+
+  static size_t DefaultThreadCount();
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void Enqueue(Task task);
+  bool TryPopLocal(size_t index, Task &out);
+  bool TrySteal(size_t thief, Task &out);
+  bool TakeTask(Task &out);
+  void WorkerLoop(size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCv_;
+  std::atomic<size_t> pendingTasks_{0};
+  std::atomic<size_t> nextQueue_{0};
+  bool stopping_ = false; // Guarded by sleepMutex_
+};
+
+} // namespace GreedyTangle
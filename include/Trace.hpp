@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Span tracing in Chrome trace-event format (loadable in Perfetto or
+ * chrome://tracing).
+ *
+ * Each thread records into its own fixed-size ring, allocated with its
+ * first span, so recording a span is a handful of relaxed stores and never
+ * takes a lock. Recording is off
+ * until Tracer::SetEnabled(true); WriteJSON dumps whatever the rings hold.
+ *
+ * Configure with -DGREEDY_TANGLE_ENABLE_TRACING=OFF to compile every
+ * GT_TRACE_* site out of the build.
+ */
+#ifndef GREEDY_TANGLE_TRACING
+#define GREEDY_TANGLE_TRACING 1
+#endif
+
+namespace GreedyTangle {
+
+class Tracer {
+public:
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+
+  /**
+   * Label the calling thread in the trace viewer
+   */
+  static void SetThreadName(const std::string &name);
+
+  /**
+   * Record a completed span. name and category must be string literals
+   * (or otherwise outlive the trace), since only the pointers are stored.
+   */
+  static void RecordSpan(const char *name, const char *category,
+                         uint64_t startNs, uint64_t endNs);
+
+  /**
+   * Drop every recorded span on every thread
+   */
+  static void Clear();
+
+  /**
+   * Write all recorded spans as Chrome trace-event JSON. Safe to call while
+   * other threads keep recording.
+   */
+  static bool WriteJSON(const std::string &path);
+
+  static uint64_t NowNs();
+};
+
+/**
+ * TraceScope - Records a span covering its own lifetime
+ */
+class TraceScope {
+public:
+  TraceScope(const char *name, const char *category)
+      : name_(name), category_(category), active_(Tracer::IsEnabled()),
+        startNs_(active_ ? Tracer::NowNs() : 0) {}
+
+  ~TraceScope() {
+    if (active_) {
+      Tracer::RecordSpan(name_, category_, startNs_, Tracer::NowNs());
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name_;
+  const char *category_;
+  bool active_;
+  uint64_t startNs_;
+};
+
+} // namespace GreedyTangle
+
+#if GREEDY_TANGLE_TRACING
+#define GT_TRACE_CONCAT_INNER(a, b) a##b
+#define GT_TRACE_CONCAT(a, b) GT_TRACE_CONCAT_INNER(a, b)
+#define GT_TRACE_SCOPE(name, category)                                        \
+  ::GreedyTangle::TraceScope GT_TRACE_CONCAT(gtTraceScope_, __LINE__)(name,   \
+                                                                    category)
+#define GT_TRACE_THREAD_NAME(name) ::GreedyTangle::Tracer::SetThreadName(name)
+#else
+#define GT_TRACE_SCOPE(name, category) ((void)0)
+#define GT_TRACE_THREAD_NAME(name) ((void)0)
+#endif
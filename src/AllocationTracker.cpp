@@ -0,0 +1,173 @@
+#include "AllocationTracker.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace GreedyTangle {
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(AllocTag::COUNT);
+
+#if GREEDY_TANGLE_ALLOC_TRACKING
+// Constant-initialized, so usable by allocations made before main()
+std::atomic<uint64_t> tagAllocations[TAG_COUNT];
+std::atomic<uint64_t> tagFrees[TAG_COUNT];
+std::atomic<uint64_t> tagBytes[TAG_COUNT];
+
+thread_local AllocScope *tlsScope = nullptr;
+thread_local uint64_t tlsAllocations = 0;
+
+size_t TagIndex() {
+  return static_cast<size_t>(tlsScope ? tlsScope->Tag() : AllocTag::UNTAGGED);
+}
+#endif
+
+} // namespace
+
+const char *AllocTagName(AllocTag tag) {
+  switch (tag) {
+  case AllocTag::UNTAGGED:
+    return "Untagged";
+  case AllocTag::SOLVER_SEARCH:
+    return "Solver search";
+  case AllocTag::FRAME_UPDATE:
+    return "Frame update";
+  case AllocTag::FRAME_RENDER:
+    return "Frame render";
+  case AllocTag::BACKGROUND_JOB:
+    return "Background job";
+  case AllocTag::COUNT:
+    break;
+  }
+  return "Unknown";
+}
+
+#if GREEDY_TANGLE_ALLOC_TRACKING
+
+/**
+ * AllocationHooks - Called by the replacement operator new / delete
+ *
+ * Must not allocate: it runs inside operator new.
+ */
+struct AllocationHooks {
+  static void OnAllocate(uint64_t size) {
+    ++tlsAllocations;
+    size_t tag = TagIndex();
+    tagAllocations[tag].fetch_add(1, std::memory_order_relaxed);
+    tagBytes[tag].fetch_add(size, std::memory_order_relaxed);
+    for (AllocScope *scope = tlsScope; scope; scope = scope->parent_) {
+      scope->RecordAllocation(size);
+    }
+  }
+
+  static void OnFree(uint64_t size) {
+    tagFrees[TagIndex()].fetch_add(1, std::memory_order_relaxed);
+    for (AllocScope *scope = tlsScope; scope; scope = scope->parent_) {
+      scope->RecordFree(size);
+    }
+  }
+};
+
+AllocCounters AllocationTracker::TagTotals(AllocTag tag) {
+  AllocCounters c;
+  size_t i = static_cast<size_t>(tag);
+  if (i < TAG_COUNT) {
+    c.allocations = tagAllocations[i].load(std::memory_order_relaxed);
+    c.frees = tagFrees[i].load(std::memory_order_relaxed);
+    c.bytes = tagBytes[i].load(std::memory_order_relaxed);
+  }
+  return c;
+}
+
+uint64_t AllocationTracker::ThreadAllocations() { return tlsAllocations; }
+
+AllocScope::AllocScope(AllocTag tag) : tag_(tag), parent_(tlsScope) {
+  tlsScope = this;
+}
+
+AllocScope::~AllocScope() { tlsScope = parent_; }
+
+AllocScope *AllocScope::Current() { return tlsScope; }
+
+AllocCounters AllocScope::Counters() const {
+  AllocCounters c;
+  c.allocations = allocations_.load(std::memory_order_relaxed);
+  c.frees = frees_.load(std::memory_order_relaxed);
+  c.bytes = bytes_.load(std::memory_order_relaxed);
+  c.peakBytes = peakBytes_.load(std::memory_order_relaxed);
+  return c;
+}
+
+void AllocScope::RecordAllocation(uint64_t size) {
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  bytes_.fetch_add(size, std::memory_order_relaxed);
+  int64_t live =
+      liveBytes_.fetch_add(static_cast<int64_t>(size),
+                           std::memory_order_relaxed) +
+      static_cast<int64_t>(size);
+  uint64_t peak = peakBytes_.load(std::memory_order_relaxed);
+  while (live > 0 && static_cast<uint64_t>(live) > peak &&
+         !peakBytes_.compare_exchange_weak(peak, static_cast<uint64_t>(live),
+                                           std::memory_order_relaxed)) {
+  }
+}
+
+void AllocScope::RecordFree(uint64_t size) {
+  frees_.fetch_add(1, std::memory_order_relaxed);
+  liveBytes_.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+AllocScopeAdopt::AllocScopeAdopt(AllocScope *scope) : previous_(tlsScope) {
+  tlsScope = scope;
+}
+
+AllocScopeAdopt::~AllocScopeAdopt() { tlsScope = previous_; }
+
+#else
+
+AllocCounters AllocationTracker::TagTotals(AllocTag) { return {}; }
+
+uint64_t AllocationTracker::ThreadAllocations() { return 0; }
+
+#endif
+
+} // namespace GreedyTangle
+
+#if GREEDY_TANGLE_ALLOC_TRACKING
+
+namespace {
+
+// Every block carries its size in front so frees can be charged too; the
+// header is max_align_t sized to keep the payload suitably aligned
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void *TrackedAllocate(std::size_t size) {
+  void *raw = std::malloc(size + HEADER_SIZE);
+  if (!raw) {
+    throw std::bad_alloc();
+  }
+  *static_cast<std::size_t *>(raw) = size;
+  GreedyTangle::AllocationHooks::OnAllocate(size);
+  return static_cast<char *>(raw) + HEADER_SIZE;
+}
+
+void TrackedFree(void *p) noexcept {
+  if (!p) {
+    return;
+  }
+  char *raw = static_cast<char *>(p) - HEADER_SIZE;
+  GreedyTangle::AllocationHooks::OnFree(*reinterpret_cast<std::size_t *>(raw));
+  std::free(raw);
+}
+
+} // namespace
+
+void *operator new(std::size_t size) { return TrackedAllocate(size); }
+void *operator new[](std::size_t size) { return TrackedAllocate(size); }
+void operator delete(void *p) noexcept { TrackedFree(p); }
+void operator delete[](void *p) noexcept { TrackedFree(p); }
+void operator delete(void *p, std::size_t) noexcept { TrackedFree(p); }
+void operator delete[](void *p, std::size_t) noexcept { TrackedFree(p); }
+
+#endif
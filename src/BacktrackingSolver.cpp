@@ -1,9 +1,10 @@
 #include "BacktrackingSolver.hpp"
+#include "Logger.hpp"
 #include "MathUtils.hpp"
+#include "Trace.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
-#include <iostream>
 #include <limits>
 
 namespace GreedyTangle {
@@ -11,9 +12,17 @@ namespace GreedyTangle {
 CPUMove BacktrackingSolver::FindBestMove(std::vector<Node> nodes,
                                          const std::vector<Edge> &edges) {
   auto start_time = std::chrono::steady_clock::now();
-
-  int current_intersections = CountIntersections(nodes, edges);
+  GT_TRACE_SCOPE("Backtracking::FindBestMove", "solver");
+  ScopedPhaseTimer search_timer(stats_.searchNs);
+  ScopedSearchAllocations search_allocations(stats_);
+  SolverStats::Add(stats_.calls);
+  arena_.Reset();
+  canvas_ = SolverCanvas(nodes, MARGIN);
+  gridSpacing_ = GridSpacingFor(canvas_, GRID_SPACING);
+
+  int current_intersections = CountCrossings(nodes, edges);
   lastCandidatesEvaluated_ = 0;
+  BeginProgress();
 
   CPUMove best_move;
   best_move.intersections_before = current_intersections;
@@ -24,9 +33,27 @@ CPUMove BacktrackingSolver::FindBestMove(std::vector<Node> nodes,
 
   int bestIntersections = current_intersections;
   MoveCandidate bestFirstMove{-1, Vec2()};
-
-  Backtrack(nodes, edges, 0, current_intersections,
-            bestIntersections, bestFirstMove);
+  CandidateBuffers buffers(MAX_DEPTH + 1, &arena_);
+
+  {
+    // Evaluation time is the search minus the generation nested inside it
+    uint64_t generation_before =
+        stats_.generationNs.load(std::memory_order_relaxed);
+    GT_TRACE_SCOPE("EvaluateCandidates", "solver");
+    auto search_start = std::chrono::steady_clock::now();
+
+    Backtrack(nodes, edges, 0, current_intersections,
+              bestIntersections, bestFirstMove, buffers);
+
+    uint64_t total = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - search_start)
+            .count());
+    uint64_t generation =
+        stats_.generationNs.load(std::memory_order_relaxed) - generation_before;
+    SolverStats::Add(stats_.evaluationNs,
+                     total > generation ? total - generation : 0);
+  }
 
   if (IsCancelled()) {
     return best_move;
@@ -41,19 +68,22 @@ CPUMove BacktrackingSolver::FindBestMove(std::vector<Node> nodes,
   }
 
   if (!best_move.isValid() || best_move.intersection_reduction <= 0) {
+    GT_TRACE_SCOPE("Fallback", "solver");
+    ScopedPhaseTimer fallback_timer(stats_.fallbackNs);
     float max_min_distance = 0.0f;
+    std::pmr::vector<Vec2> &candidates = buffers[MAX_DEPTH];
 
     for (size_t node_idx = 0; node_idx < nodes.size() && !IsCancelled(); ++node_idx) {
       Vec2 original_position = nodes[node_idx].position;
-      std::vector<Vec2> candidates =
-          GenerateCandidatePositions(static_cast<int>(node_idx), nodes);
+      GenerateCandidatePositions(static_cast<int>(node_idx), nodes, candidates);
 
       for (const Vec2 &candidate : candidates) {
         if (IsCancelled() || lastCandidatesEvaluated_ > MAX_EVALUATIONS) break;
         ++lastCandidatesEvaluated_;
+        SolverStats::Add(stats_.candidatesEvaluated);
 
         nodes[node_idx].position = candidate;
-        int new_intersections = CountIntersections(nodes, edges);
+        int new_intersections = CountCrossings(nodes, edges);
         nodes[node_idx].position = original_position;
 
         int reduction = current_intersections - new_intersections;
@@ -88,12 +118,12 @@ CPUMove BacktrackingSolver::FindBestMove(std::vector<Node> nodes,
           .count();
 
   if (best_move.isValid()) {
-    std::cout << "[Backtracking] Found move: Node " << best_move.node_id << " -> ("
-              << best_move.to_position.x << ", " << best_move.to_position.y
-              << ") reduction=" << best_move.intersection_reduction
-              << " time=" << best_move.computation_time_ms << "ms" << std::endl;
+    GT_LOG_INFO("Backtracking", "Found move: Node {} -> ({}, {}) reduction={} time={}ms",
+                best_move.node_id, best_move.to_position.x,
+                best_move.to_position.y, best_move.intersection_reduction,
+                best_move.computation_time_ms);
   } else {
-    std::cout << "[Backtracking] No valid move found (stuck)" << std::endl;
+    GT_LOG_INFO("Backtracking", "No valid move found (stuck)");
   }
 
   return best_move;
@@ -104,7 +134,8 @@ void BacktrackingSolver::Backtrack(std::vector<Node> &nodes,
                                    int depth,
                                    int currentIntersections,
                                    int &bestIntersections,
-                                   MoveCandidate &bestFirstMove) {
+                                   MoveCandidate &bestFirstMove,
+                                   CandidateBuffers &buffers) {
   if (IsCancelled() || lastCandidatesEvaluated_ > MAX_EVALUATIONS) {
     return;
   }
@@ -117,20 +148,43 @@ void BacktrackingSolver::Backtrack(std::vector<Node> &nodes,
     return;
   }
 
+  std::pmr::vector<Vec2> &candidates = buffers[depth];
+
   for (size_t node_idx = 0; node_idx < nodes.size() && !IsCancelled(); ++node_idx) {
     Vec2 original_position = nodes[node_idx].position;
 
-    std::vector<Vec2> candidates =
-        GenerateCandidatePositions(static_cast<int>(node_idx), nodes);
+    {
+      GT_TRACE_SCOPE("GenerateCandidates", "solver");
+      ScopedPhaseTimer generation_timer(stats_.generationNs);
+      GenerateCandidatePositions(static_cast<int>(node_idx), nodes, candidates);
+    }
 
     for (const Vec2 &candidate : candidates) {
       if (IsCancelled() || lastCandidatesEvaluated_ > MAX_EVALUATIONS) return;
       ++lastCandidatesEvaluated_;
+      SolverStats::Add(stats_.candidatesEvaluated);
+      if (lastCandidatesEvaluated_ % PROGRESS_INTERVAL == 0) {
+        PublishProgress(lastCandidatesEvaluated_);
+      }
 
       nodes[node_idx].position = candidate;
-      int new_intersections = CountIntersections(nodes, edges);
+      int new_intersections = CountCrossings(nodes, edges);
 
       if (new_intersections < currentIntersections) {
+        // Root-level improvements are single moves that can be applied
+        // as-is, so stream them as the best-so-far result
+        if (depth == 0) {
+          CPUMove improvement;
+          improvement.node_id = static_cast<int>(node_idx);
+          improvement.from_position = original_position;
+          improvement.to_position = candidate;
+          improvement.intersections_before = currentIntersections;
+          improvement.intersections_after = new_intersections;
+          improvement.intersection_reduction =
+              currentIntersections - new_intersections;
+          PublishImprovement(improvement);
+        }
+
         if (new_intersections < bestIntersections) {
           bestIntersections = new_intersections;
 
@@ -140,19 +194,24 @@ void BacktrackingSolver::Backtrack(std::vector<Node> &nodes,
           }
         }
         Backtrack(nodes, edges, depth + 1, new_intersections,
-                  bestIntersections, bestFirstMove);
+                  bestIntersections, bestFirstMove, buffers);
+      } else {
+        // Non-improving branches are never expanded
+        SolverStats::Add(stats_.prunedCandidates);
       }
       nodes[node_idx].position = original_position;
     }
   }
 }
 
-std::vector<Vec2>
-BacktrackingSolver::GenerateCandidatePositions(int node_id,
-                                               const std::vector<Node> &nodes) {
-  std::vector<Vec2> candidates;
-  for (float x = MARGIN; x <= WINDOW_WIDTH - MARGIN; x += GRID_SPACING) {
-    for (float y = MARGIN; y <= WINDOW_HEIGHT - MARGIN; y += GRID_SPACING) {
+void BacktrackingSolver::GenerateCandidatePositions(
+    int node_id, const std::vector<Node> &nodes,
+    std::pmr::vector<Vec2> &candidates) {
+  candidates.clear();
+  for (float x = canvas_.minX + MARGIN; x <= canvas_.maxX - MARGIN;
+       x += gridSpacing_) {
+    for (float y = canvas_.minY + MARGIN; y <= canvas_.maxY - MARGIN;
+         y += gridSpacing_) {
       candidates.emplace_back(x, y);
     }
   }
@@ -167,10 +226,10 @@ BacktrackingSolver::GenerateCandidatePositions(int node_id,
           Vec2 offset(std::cos(angle) * radius, std::sin(angle) * radius);
           Vec2 candidate = neighbor_pos + offset;
 
-          candidate.x =
-              std::max(MARGIN, std::min(WINDOW_WIDTH - MARGIN, candidate.x));
-          candidate.y =
-              std::max(MARGIN, std::min(WINDOW_HEIGHT - MARGIN, candidate.y));
+          candidate.x = std::max(canvas_.minX + MARGIN,
+                                 std::min(canvas_.maxX - MARGIN, candidate.x));
+          candidate.y = std::max(canvas_.minY + MARGIN,
+                                 std::min(canvas_.maxY - MARGIN, candidate.y));
 
           candidates.push_back(candidate);
         }
@@ -188,8 +247,6 @@ BacktrackingSolver::GenerateCandidatePositions(int node_id,
       candidates.push_back(centroid);
     }
   }
-
-  return candidates;
 }
 
 }
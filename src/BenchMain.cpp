@@ -0,0 +1,450 @@
+#include "BenchmarkRunner.hpp"
+#include "CrossingValidator.hpp"
+#include "Logger.hpp"
+#include "PerfRegression.hpp"
+#include "PuzzleGenerator.hpp"
+#include "ScalabilityAnalysis.hpp"
+#include "SolverFactory.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * greedy_tangle_bench - Headless solver benchmark
+ *
+ * Runs the same seeded sweeps as the in-game Benchmark and Complexity
+ * Analysis screens, without SDL or a display, and writes the results as
+ * JSON or CSV for CI boxes and plotting scripts. With --regress it instead
+ * times a fixed corpus against a checked-in baseline and exits non-zero
+ * when a solver got slower than noise allows, and with --validate it checks
+ * every fast crossing-count backend against the reference.
+ */
+
+using namespace GreedyTangle;
+
+namespace {
+
+struct Options {
+  BenchmarkConfig bench;
+  ScalabilityConfig scalability;
+  bool runScalability = false;
+  std::string regressBaseline;  // --regress PATH
+  std::string writeBaseline;    // --write-baseline PATH
+  int repetitions = 0;          // 0 = the baseline's own count
+  double tolerance = PerfRegression::DEFAULT_TOLERANCE;
+  bool validate = false; // --validate
+  ValidationConfig validation;
+  bool parallelSearch = false;
+  bool verbose = false;
+  size_t threads = 0;
+  std::string format = "json";
+  std::string output = "-";
+};
+
+void PrintUsage() {
+  std::cout
+      << "Usage: greedy_tangle_bench [options]\n"
+      << "\n"
+      << "Sweep:\n"
+      << "  --solvers LIST      greedy,backtracking,dnc or all (default all)\n"
+      << "  --families LIST     cycle,grid,triangulation or all (default all)\n"
+      << "  --nodes N           graph size (default 15)\n"
+      << "  --seeds K           run seeds 1..K (default 5)\n"
+      << "  --max-moves M       move budget per trial (default 100)\n"
+      << "  --trial-time S      seconds per trial (default 10)\n"
+      << "  --sweep-time S      seconds for the whole run, 0 = none (default 0)\n"
+      << "\n"
+      << "Complexity analysis:\n"
+      << "  --scalability       run a doubling size ladder and fit N^k\n"
+      << "  --min-nodes N       first ladder size (default 10)\n"
+      << "  --max-nodes N       last ladder size (default 10240)\n"
+      << "  --growth G          ratio between ladder sizes (default 2)\n"
+      << "\n"
+      << "Regression gate:\n"
+      << "  --regress PATH      time the fixed corpus against a baseline JSON,\n"
+      << "                      exit 1 if any solver regressed\n"
+      << "  --write-baseline PATH\n"
+      << "                      time the fixed corpus and save it as a baseline\n"
+      << "  --repetitions R     corpus passes per metric (default 5)\n"
+      << "  --tolerance PCT     slowdown always allowed, in percent (default 15)\n"
+      << "\n"
+      << "Crossing-count validation:\n"
+      << "  --validate          compare every fast backend with the reference\n"
+      << "                      on random, adversarial and replayed layouts,\n"
+      << "                      exit 1 on any disagreement\n"
+      << "  --backends LIST     comma list of with-move, incident-delta,\n"
+      << "                      tracker, or all (default all)\n"
+      << "  --cases N           random and adversarial layouts per seed\n"
+      << "                      (default 200 and 400)\n"
+      << "\n"
+      << "Execution and output:\n"
+      << "  --threads T         worker threads, 0 = one per core (default 0)\n"
+      << "  --parallel-search   let every search fan out across the pool\n"
+      << "  --format json|csv   result format (default json)\n"
+      << "  --output PATH       result file, - = stdout (default -)\n"
+      << "  --verbose           also log solver internals (with --output)\n"
+      << "  --help              show this message\n";
+}
+
+std::vector<std::string> SplitList(const std::string &list) {
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+bool ParseSolvers(const std::string &list, std::vector<SolverMode> &modes) {
+  modes.clear();
+  for (const std::string &name : SplitList(list)) {
+    if (name == "all") {
+      modes = {SolverMode::GREEDY, SolverMode::BACKTRACKING,
+               SolverMode::DIVIDE_AND_CONQUER_DP};
+    } else {
+      SolverMode mode;
+      if (!SolverModeFromKey(name, mode)) {
+        std::cerr << "Unknown solver: " << name << std::endl;
+        return false;
+      }
+      modes.push_back(mode);
+    }
+  }
+  return !modes.empty();
+}
+
+bool ParseFamilies(const std::string &list,
+                   std::vector<PuzzleFamily> &families) {
+  families.clear();
+  for (const std::string &name : SplitList(list)) {
+    if (name == "all") {
+      families = {PuzzleFamily::CYCLE_CHORDS, PuzzleFamily::GRID_MESH,
+                  PuzzleFamily::TRIANGULATION};
+    } else {
+      PuzzleFamily family;
+      if (!PuzzleFamilyFromKey(name, family)) {
+        std::cerr << "Unknown family: " << name << std::endl;
+        return false;
+      }
+      families.push_back(family);
+    }
+  }
+  return !families.empty();
+}
+
+bool ParseBackends(const std::string &list, std::vector<std::string> &keys) {
+  keys.clear();
+  for (const std::string &name : SplitList(list)) {
+    if (name == "all") {
+      keys.clear();
+      return true;
+    }
+    if (!CrossingValidator::FindBackend(name)) {
+      std::cerr << "Unknown crossing backend: " << name << std::endl;
+      return false;
+    }
+    keys.push_back(name);
+  }
+  return !keys.empty();
+}
+
+bool ParseNumber(const std::string &text, double &value) {
+  char *end = nullptr;
+  value = std::strtod(text.c_str(), &end);
+  return end && *end == '\0' && !text.empty() && value >= 0.0;
+}
+
+// Returns 0 to run, or the process exit code
+int ParseOptions(int argc, char *argv[], Options &options) {
+  options.bench.sweepTimeLimit = 0.0f;
+  options.scalability.sweepTimeLimit = 0.0f;
+  const std::vector<std::string> numericOptions = {
+      "--nodes",      "--seeds",      "--max-moves", "--trial-time",
+      "--sweep-time", "--min-nodes",  "--max-nodes", "--growth",
+      "--threads",    "--repetitions", "--tolerance", "--cases"};
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      PrintUsage();
+      return -1;
+    }
+    if (arg == "--scalability") {
+      options.runScalability = true;
+      continue;
+    }
+    if (arg == "--parallel-search") {
+      options.parallelSearch = true;
+      continue;
+    }
+    if (arg == "--verbose") {
+      options.verbose = true;
+      continue;
+    }
+    if (arg == "--validate") {
+      options.validate = true;
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      return 2;
+    }
+    std::string value = argv[++i];
+    double number = 0.0;
+    bool numeric = ParseNumber(value, number);
+
+    if (arg == "--solvers") {
+      if (!ParseSolvers(value, options.bench.modes))
+        return 2;
+      options.scalability.modes = options.bench.modes;
+    } else if (arg == "--families") {
+      if (!ParseFamilies(value, options.bench.families))
+        return 2;
+      // The ladder uses a single family: the first one listed
+      options.scalability.family = options.bench.families.front();
+    } else if (arg == "--format") {
+      if (value != "json" && value != "csv") {
+        std::cerr << "Unknown format: " << value << std::endl;
+        return 2;
+      }
+      options.format = value;
+    } else if (arg == "--output") {
+      options.output = value;
+    } else if (arg == "--regress") {
+      options.regressBaseline = value;
+    } else if (arg == "--write-baseline") {
+      options.writeBaseline = value;
+    } else if (arg == "--backends") {
+      if (!ParseBackends(value, options.validation.backends))
+        return 2;
+    } else if (std::find(numericOptions.begin(), numericOptions.end(), arg) ==
+               numericOptions.end()) {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return 2;
+    } else if (!numeric) {
+      std::cerr << "Expected a non-negative number for " << arg << ", got "
+                << value << std::endl;
+      return 2;
+    } else if (arg == "--nodes") {
+      options.bench.nodeCount = static_cast<int>(number);
+    } else if (arg == "--seeds") {
+      options.bench.seeds.clear();
+      for (int s = 1; s <= static_cast<int>(number); ++s) {
+        options.bench.seeds.push_back(static_cast<uint32_t>(s));
+      }
+      options.scalability.seeds = options.bench.seeds;
+    } else if (arg == "--max-moves") {
+      options.bench.maxMoves = static_cast<int>(number);
+      options.scalability.maxMoves = options.bench.maxMoves;
+    } else if (arg == "--trial-time") {
+      options.bench.trialTimeLimit = static_cast<float>(number);
+      options.scalability.trialTimeLimit = options.bench.trialTimeLimit;
+    } else if (arg == "--sweep-time") {
+      options.bench.sweepTimeLimit = static_cast<float>(number);
+      options.scalability.sweepTimeLimit = options.bench.sweepTimeLimit;
+    } else if (arg == "--min-nodes") {
+      options.scalability.minNodes = static_cast<int>(number);
+    } else if (arg == "--max-nodes") {
+      options.scalability.maxNodes = static_cast<int>(number);
+    } else if (arg == "--growth") {
+      options.scalability.growth = number;
+    } else if (arg == "--threads") {
+      options.threads = static_cast<size_t>(number);
+    } else if (arg == "--repetitions") {
+      options.repetitions = static_cast<int>(number);
+    } else if (arg == "--tolerance") {
+      options.tolerance = number / 100.0;
+    } else if (arg == "--cases") {
+      options.validation.randomCases = static_cast<int>(number);
+      options.validation.adversarialCases = static_cast<int>(number);
+    }
+  }
+
+  options.validation.seeds = options.bench.seeds;
+  if (options.bench.seeds.empty()) {
+    std::cerr << "--seeds must be at least 1" << std::endl;
+    return 2;
+  }
+  if (!options.regressBaseline.empty() && !options.writeBaseline.empty()) {
+    std::cerr << "--regress and --write-baseline are exclusive" << std::endl;
+    return 2;
+  }
+  return 0;
+}
+
+// Drop corpus entries and baseline results for solvers not in --solvers
+void KeepSolvers(const std::vector<SolverMode> &modes, PerfBaseline &baseline) {
+  auto unwanted = [&](SolverMode mode) {
+    return std::find(modes.begin(), modes.end(), mode) == modes.end();
+  };
+  std::vector<CorpusEntry> &entries = baseline.corpus.entries;
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [&](const CorpusEntry &e) {
+                                 return unwanted(e.mode);
+                               }),
+                entries.end());
+  std::vector<SolverPerf> &solvers = baseline.solvers;
+  solvers.erase(std::remove_if(solvers.begin(), solvers.end(),
+                               [&](const SolverPerf &p) {
+                                 return unwanted(p.mode);
+                               }),
+                solvers.end());
+}
+
+int RunRegressionGate(const Options &options) {
+  PerfBaseline baseline;
+  std::ifstream in(options.regressBaseline);
+  std::string error;
+  if (!in) {
+    std::cerr << "Cannot open " << options.regressBaseline << std::endl;
+    return 2;
+  }
+  if (!PerfRegression::ReadBaseline(in, baseline, error)) {
+    std::cerr << options.regressBaseline << ": " << error << std::endl;
+    return 2;
+  }
+  KeepSolvers(options.bench.modes, baseline);
+
+  // Timings from a differently built binary differ by more than any
+  // regression the gate is meant to catch
+  std::vector<std::string> mismatches =
+      PerfRegression::BuildMismatches(baseline.build, BuildConfig::Current());
+  if (!mismatches.empty()) {
+    std::cerr << options.regressBaseline
+              << " was recorded with a different build; rebuild to match it "
+                 "or record a new baseline:\n";
+    for (const std::string &mismatch : mismatches) {
+      std::cerr << "  " << mismatch << "\n";
+    }
+    return 2;
+  }
+
+  RegressionCorpus corpus = baseline.corpus;
+  if (options.repetitions > 0) {
+    corpus.repetitions = options.repetitions;
+  }
+  std::vector<SolverPerf> current = PerfRegression::Measure(corpus);
+  RegressionResult result =
+      PerfRegression::Compare(baseline, current, options.tolerance);
+  Logger::Instance().Flush();
+  PerfRegression::WriteReport(result, std::cout);
+  return result.passed ? 0 : 1;
+}
+
+int RunWriteBaseline(const Options &options) {
+  PerfBaseline baseline;
+  baseline.build = BuildConfig::Current();
+  KeepSolvers(options.bench.modes, baseline);
+  if (options.repetitions > 0) {
+    baseline.corpus.repetitions = options.repetitions;
+  }
+  baseline.solvers = PerfRegression::Measure(baseline.corpus);
+
+  std::ofstream out(options.writeBaseline);
+  if (!out || !PerfRegression::WriteBaseline(baseline, out)) {
+    std::cerr << "Failed to write " << options.writeBaseline << std::endl;
+    return 1;
+  }
+  for (const SolverPerf &perf : baseline.solvers) {
+    GT_LOG_INFO("PerfRegression", "{}: {:.4f} ms/move (MAD {:.4f})",
+                perf.solverName, perf.msPerMove.median, perf.msPerMove.mad);
+  }
+  return 0;
+}
+
+int RunValidation(const Options &options) {
+  ValidationReport report = CrossingValidator::Run(options.validation);
+  Logger::Instance().Flush();
+  CrossingValidator::WriteReport(report, std::cout);
+  return report.Passed() && CrossingValidator::LiveDisagreements() == 0 ? 0
+                                                                        : 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  int parsed = ParseOptions(argc, argv, options);
+  if (parsed != 0) {
+    return parsed < 0 ? 0 : parsed;
+  }
+
+  // Progress lines go to stdout, so keep them out of piped results
+  Logger &logger = Logger::Instance();
+  if (options.output == "-") {
+    logger.SetMinLevel(LogLevel::WARN);
+  } else if (options.verbose) {
+    logger.SetMinLevel(LogLevel::VERBOSE);
+  }
+
+  // The gate times trials serially, so it needs neither a pool nor --output
+  if (!options.regressBaseline.empty() || !options.writeBaseline.empty()) {
+    // Solvers log every move at INFO; keep the report readable
+    logger.SetMinLevel(options.verbose ? LogLevel::VERBOSE : LogLevel::WARN);
+    int status = options.regressBaseline.empty()
+                     ? RunWriteBaseline(options)
+                     : RunRegressionGate(options);
+    logger.Flush();
+    return status;
+  }
+
+  if (options.validate) {
+    // Recorded sessions run real solvers, which log every move at INFO
+    logger.SetMinLevel(options.verbose ? LogLevel::VERBOSE : LogLevel::WARN);
+    int status = RunValidation(options);
+    logger.Flush();
+    return status;
+  }
+
+  ThreadPool pool(options.threads);
+  if (options.parallelSearch) {
+    options.bench.solverPool = &pool;
+    options.scalability.solverPool = &pool;
+  }
+
+  std::ofstream file;
+  std::ostream *out = &std::cout;
+  if (options.output != "-") {
+    file.open(options.output);
+    if (!file) {
+      std::cerr << "Cannot open " << options.output << std::endl;
+      return 1;
+    }
+    out = &file;
+  }
+
+  bool written = false;
+  if (options.runScalability) {
+    ScalabilityAnalysis analysis(pool);
+    ScalabilityReport report = analysis.Run(options.scalability);
+    written = options.format == "csv"
+                  ? ScalabilityAnalysis::WriteCSV(report, *out)
+                  : ScalabilityAnalysis::WriteJSON(report, *out);
+  } else {
+    BenchmarkRunner runner(pool);
+    std::vector<BenchmarkTrial> trials = runner.Run(options.bench);
+    std::vector<BenchmarkAggregate> aggregates =
+        BenchmarkRunner::Aggregate(trials, options.bench.modes);
+    written = options.format == "csv"
+                  ? BenchmarkRunner::WriteCSV(trials, *out)
+                  : BenchmarkRunner::WriteJSON(options.bench, trials,
+                                               aggregates, *out);
+  }
+
+  out->flush();
+  logger.Flush();
+  if (!written) {
+    std::cerr << "Failed to write results to " << options.output << std::endl;
+    return 1;
+  }
+  return 0;
+}
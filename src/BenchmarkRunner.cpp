@@ -0,0 +1,312 @@
+#include "BenchmarkRunner.hpp"
+#include "AllocationTracker.hpp"
+#include "Logger.hpp"
+#include "MathUtils.hpp"
+#include "SolverFactory.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <numeric>
+
+namespace GreedyTangle {
+
+namespace {
+
+int64_t SteadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Nearest-rank percentile on sorted data
+double Percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  rank = std::clamp<size_t>(rank, 1, sorted.size());
+  return sorted[rank - 1];
+}
+
+} // namespace
+
+Distribution Distribution::From(std::vector<double> values) {
+  Distribution d;
+  d.samples = static_cast<int>(values.size());
+  if (values.empty())
+    return d;
+
+  std::sort(values.begin(), values.end());
+  d.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+  size_t mid = values.size() / 2;
+  d.median = values.size() % 2 ? values[mid]
+                               : (values[mid - 1] + values[mid]) / 2.0;
+  d.p95 = Percentile(values, 0.95);
+  d.min = values.front();
+  d.max = values.back();
+  return d;
+}
+
+void Distribution::WriteJSON(std::ostream &out) const {
+  out << "{\"samples\": " << samples << ", \"mean\": " << mean
+      << ", \"median\": " << median << ", \"p95\": " << p95
+      << ", \"min\": " << min << ", \"max\": " << max << "}";
+}
+
+BenchmarkTrial BenchmarkRunner::RunTrial(SolverMode mode, const Puzzle &puzzle,
+                                         const BenchmarkConfig &config,
+                                         int64_t deadlineNs) {
+  GT_TRACE_SCOPE("BenchmarkTrial", "job");
+
+  std::unique_ptr<ICPUSolver> solver = CreateSolver(mode);
+  solver->SetCancelFlag(config.cancelFlag);
+  solver->SetThreadPool(config.solverPool);
+
+  BenchmarkTrial trial;
+  trial.mode = mode;
+  trial.solverName = solver->GetName();
+  trial.family = puzzle.family;
+  trial.seed = puzzle.seed;
+  trial.nodeCount = static_cast<int>(puzzle.nodes.size());
+  trial.edgeCount = static_cast<int>(puzzle.edges.size());
+  trial.completed = true;
+
+  std::vector<Node> nodes = puzzle.nodes;
+  int currentCount = CountIntersections(nodes, puzzle.edges);
+  trial.initialIntersections = currentCount;
+  trial.intersectionHistory.push_back(currentCount);
+
+  auto startTime = std::chrono::steady_clock::now();
+  for (int moveNum = 0; moveNum < config.maxMoves && currentCount > 0;
+       ++moveNum) {
+    float elapsed = std::chrono::duration<float>(
+                        std::chrono::steady_clock::now() - startTime)
+                        .count();
+    if (elapsed >= config.trialTimeLimit ||
+        (deadlineNs > 0 && SteadyNowNs() >= deadlineNs) ||
+        (config.cancelFlag && config.cancelFlag->load())) {
+      trial.cutOff = true;
+      break;
+    }
+
+    auto searchStart = std::chrono::steady_clock::now();
+    CPUMove move = solver->FindBestMove(nodes, puzzle.edges);
+    // A search interrupted by the cancel flag returns a partial answer
+    if (config.cancelFlag && config.cancelFlag->load()) {
+      trial.cutOff = true;
+      break;
+    }
+    ++trial.searches;
+    trial.searchMs += std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - searchStart)
+                          .count();
+    if (!move.isValid() || move.intersection_reduction <= 0)
+      break;
+
+    nodes[move.node_id].position = move.to_position;
+    currentCount = CountIntersections(nodes, puzzle.edges);
+    ++trial.moves;
+    trial.intersectionHistory.push_back(currentCount);
+  }
+
+  trial.timeMs = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - startTime)
+                     .count();
+  trial.finalIntersections = currentCount;
+  trial.solved = (currentCount == 0);
+
+  SolverStatsSnapshot stats = solver->GetStats().Snapshot();
+  trial.candidatesEvaluated = stats.candidatesEvaluated;
+  trial.pairTests = stats.pairTests;
+  trial.evalsPerSecond = stats.EvaluationsPerSecond();
+  trial.pairTestsPerSecond = stats.PairTestsPerSecond();
+  trial.allocations = stats.allocations;
+  trial.allocatedBytes = stats.allocatedBytes;
+  trial.peakBytes = stats.peakBytes;
+  return trial;
+}
+
+std::vector<BenchmarkTrial> BenchmarkRunner::Run(const BenchmarkConfig &config) {
+  GT_TRACE_SCOPE("BenchmarkSweep", "job");
+
+  int64_t deadlineNs = 0;
+  if (config.sweepTimeLimit > 0.0f) {
+    deadlineNs = SteadyNowNs() +
+                 static_cast<int64_t>(config.sweepTimeLimit * 1e9);
+  }
+
+  // Generate each puzzle once; the solvers all get the same instances
+  std::vector<Puzzle> puzzles;
+  for (uint32_t seed : config.seeds) {
+    for (PuzzleFamily family : config.families) {
+      puzzles.push_back(GeneratePuzzle(family, config.nodeCount, seed));
+    }
+  }
+
+  std::vector<std::future<BenchmarkTrial>> futures;
+  futures.reserve(puzzles.size() * config.modes.size());
+  for (const Puzzle &puzzle : puzzles) {
+    for (SolverMode mode : config.modes) {
+      futures.push_back(pool_.Submit([&puzzle, mode, &config, deadlineNs]() {
+        if (deadlineNs > 0 && SteadyNowNs() >= deadlineNs) {
+          BenchmarkTrial skipped;
+          skipped.mode = mode;
+          skipped.family = puzzle.family;
+          skipped.seed = puzzle.seed;
+          return skipped;
+        }
+        return RunTrial(mode, puzzle, config, deadlineNs);
+      }));
+    }
+  }
+
+  std::vector<BenchmarkTrial> trials;
+  trials.reserve(futures.size());
+  for (auto &future : futures) {
+    pool_.Wait(future);
+    BenchmarkTrial trial = future.get();
+    if (trial.completed) {
+      GT_LOG_INFO("Benchmark", "{} on {} seed {}: {} moves, {:.0f}ms, final={}{}",
+                  trial.solverName, PuzzleFamilyName(trial.family), trial.seed,
+                  trial.moves, trial.timeMs, trial.finalIntersections,
+                  trial.solved ? " (SOLVED)" : "");
+    }
+    trials.push_back(std::move(trial));
+  }
+  return trials;
+}
+
+std::vector<BenchmarkAggregate>
+BenchmarkRunner::Aggregate(const std::vector<BenchmarkTrial> &trials,
+                           const std::vector<SolverMode> &modes) {
+  std::vector<BenchmarkAggregate> aggregates;
+  for (SolverMode mode : modes) {
+    BenchmarkAggregate agg;
+    agg.mode = mode;
+    std::vector<double> times, moves, finals, evalRates, pairRates, allocs;
+
+    for (const BenchmarkTrial &t : trials) {
+      if (t.mode != mode || !t.completed)
+        continue;
+      agg.solverName = t.solverName;
+      ++agg.trials;
+      if (t.solved)
+        ++agg.solvedTrials;
+      times.push_back(t.timeMs);
+      moves.push_back(t.moves);
+      finals.push_back(t.finalIntersections);
+      evalRates.push_back(t.evalsPerSecond);
+      pairRates.push_back(t.pairTestsPerSecond);
+      allocs.push_back(t.AllocationsPerSearch());
+      agg.candidatesEvaluated += t.candidatesEvaluated;
+      agg.pairTests += t.pairTests;
+      agg.peakBytes = std::max(agg.peakBytes, t.peakBytes);
+    }
+
+    if (agg.solverName.empty()) {
+      agg.solverName = CreateSolver(mode)->GetName();
+    }
+    agg.timeMs = Distribution::From(std::move(times));
+    agg.moves = Distribution::From(std::move(moves));
+    agg.finalIntersections = Distribution::From(std::move(finals));
+    agg.evalsPerSecond = Distribution::From(std::move(evalRates));
+    agg.pairTestsPerSecond = Distribution::From(std::move(pairRates));
+    agg.allocationsPerSearch = Distribution::From(std::move(allocs));
+    aggregates.push_back(std::move(agg));
+  }
+  return aggregates;
+}
+
+bool BenchmarkRunner::WriteCSV(const std::vector<BenchmarkTrial> &trials,
+                               std::ostream &out) {
+  out << "solver,family,nodes,edges,seed,completed,cut_off,moves,searches,"
+         "time_ms,ms_per_move,initial_crossings,final_crossings,solved,"
+         "candidates,pair_tests,allocations,allocated_bytes,peak_bytes\n";
+  out << std::fixed << std::setprecision(3);
+  for (const BenchmarkTrial &t : trials) {
+    out << '"' << t.solverName << "\"," << PuzzleFamilyName(t.family) << ','
+        << t.nodeCount << ',' << t.edgeCount << ',' << t.seed << ','
+        << (t.completed ? 1 : 0) << ',' << (t.cutOff ? 1 : 0) << ','
+        << t.moves << ',' << t.searches << ',' << t.timeMs << ','
+        << t.MsPerSearch() << ',' << t.initialIntersections << ','
+        << t.finalIntersections << ',' << (t.solved ? 1 : 0) << ','
+        << t.candidatesEvaluated << ',' << t.pairTests << ','
+        << t.allocations << ',' << t.allocatedBytes << ',' << t.peakBytes
+        << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+bool BenchmarkRunner::WriteJSON(
+    const BenchmarkConfig &config, const std::vector<BenchmarkTrial> &trials,
+    const std::vector<BenchmarkAggregate> &aggregates, std::ostream &out) {
+  out << std::fixed << std::setprecision(4);
+
+  out << "{\n  \"config\": {\"nodes\": " << config.nodeCount
+      << ", \"maxMoves\": " << config.maxMoves
+      << ", \"trialTimeLimit\": " << config.trialTimeLimit
+      << ", \"sweepTimeLimit\": " << config.sweepTimeLimit
+      << ", \"parallelSearch\": "
+      << (config.solverPool ? "true" : "false") << ", \"allocationTracking\": "
+      << (AllocationTracker::IsEnabled() ? "true" : "false")
+      << ", \"families\": [";
+  for (size_t i = 0; i < config.families.size(); ++i) {
+    out << (i ? ", " : "") << '"' << PuzzleFamilyName(config.families[i])
+        << '"';
+  }
+  out << "], \"seeds\": [";
+  for (size_t i = 0; i < config.seeds.size(); ++i) {
+    out << (i ? ", " : "") << config.seeds[i];
+  }
+  out << "]},\n";
+
+  out << "  \"aggregates\": [";
+  for (size_t i = 0; i < aggregates.size(); ++i) {
+    const BenchmarkAggregate &a = aggregates[i];
+    out << (i ? ",\n" : "\n") << "    {\"solver\": \"" << a.solverName
+        << "\", \"trials\": " << a.trials << ", \"solved\": " << a.solvedTrials
+        << ", \"candidates\": " << a.candidatesEvaluated
+        << ", \"pairTests\": " << a.pairTests
+        << ", \"peakBytes\": " << a.peakBytes << ",\n      \"timeMs\": ";
+    a.timeMs.WriteJSON(out);
+    out << ",\n      \"moves\": ";
+    a.moves.WriteJSON(out);
+    out << ",\n      \"finalIntersections\": ";
+    a.finalIntersections.WriteJSON(out);
+    out << ",\n      \"evalsPerSecond\": ";
+    a.evalsPerSecond.WriteJSON(out);
+    out << ",\n      \"pairTestsPerSecond\": ";
+    a.pairTestsPerSecond.WriteJSON(out);
+    out << ",\n      \"allocationsPerSearch\": ";
+    a.allocationsPerSearch.WriteJSON(out);
+    out << "}";
+  }
+  out << "\n  ],\n";
+
+  out << "  \"trials\": [";
+  for (size_t i = 0; i < trials.size(); ++i) {
+    const BenchmarkTrial &t = trials[i];
+    out << (i ? ",\n" : "\n") << "    {\"solver\": \"" << t.solverName
+        << "\", \"family\": \"" << PuzzleFamilyName(t.family)
+        << "\", \"seed\": " << t.seed << ", \"nodes\": " << t.nodeCount
+        << ", \"edges\": " << t.edgeCount
+        << ", \"completed\": " << (t.completed ? "true" : "false")
+        << ", \"cutOff\": " << (t.cutOff ? "true" : "false")
+        << ", \"moves\": " << t.moves << ", \"searches\": " << t.searches
+        << ", \"timeMs\": " << t.timeMs << ", \"msPerMove\": " << t.MsPerSearch()
+        << ", \"initial\": " << t.initialIntersections
+        << ", \"final\": " << t.finalIntersections
+        << ", \"solved\": " << (t.solved ? "true" : "false")
+        << ", \"candidates\": " << t.candidatesEvaluated
+        << ", \"pairTests\": " << t.pairTests
+        << ", \"allocations\": " << t.allocations
+        << ", \"allocatedBytes\": " << t.allocatedBytes
+        << ", \"peakBytes\": " << t.peakBytes << "}";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+} // namespace GreedyTangle
@@ -1,4 +1,5 @@
 #include "CPUController.hpp"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -14,13 +15,41 @@ void ReplayLogger::StartMatch(const std::vector<Node> &initial_nodes,
   for (const Node &node : initial_nodes) {
     initialPositions_.push_back(node.position);
   }
+  positions_ = initialPositions_;
+  slotOf_.assign(initialPositions_.size(), -1);
 
   for (const Edge &edge : edges) {
     edges_.emplace_back(edge.u_id, edge.v_id);
   }
 }
 
-void ReplayLogger::RecordMove(const CPUMove &move) { moves_.push_back(move); }
+void ReplayLogger::RecordMove(const CPUMove &move) {
+  moves_.push_back(move);
+  if ((moves_.size() - 1) % KEYFRAME_INTERVAL == 0) {
+    if (!keyframes_.empty()) {
+      for (int id : keyframes_.back().nodes) {
+        slotOf_[id] = -1;
+      }
+    }
+    keyframes_.emplace_back();
+  }
+
+  // Moves replay skips leave no trace in the keyframe either
+  if (!move.isValid() || move.node_id >= static_cast<int>(positions_.size())) {
+    return;
+  }
+  Keyframe &keyframe = keyframes_.back();
+  int &slot = slotOf_[move.node_id];
+  if (slot < 0) {
+    slot = static_cast<int>(keyframe.nodes.size());
+    keyframe.nodes.push_back(move.node_id);
+    keyframe.before.push_back(positions_[move.node_id]);
+    keyframe.after.push_back(move.to_position);
+  } else {
+    keyframe.after[slot] = move.to_position;
+  }
+  positions_[move.node_id] = move.to_position;
+}
 
 const CPUMove &ReplayLogger::GetMoveAt(int step) const {
   static CPUMove invalid;
@@ -30,6 +59,59 @@ const CPUMove &ReplayLogger::GetMoveAt(int step) const {
   return invalid;
 }
 
+void ReplayLogger::ApplyMoves(std::vector<Node> &nodes, int first,
+                              int last) const {
+  for (int step = first; step <= last; ++step) {
+    const CPUMove &move = moves_[step - 1];
+    if (move.isValid() && move.node_id < static_cast<int>(nodes.size())) {
+      nodes[move.node_id].position = move.to_position;
+    }
+  }
+}
+
+void ReplayLogger::ApplyDelta(std::vector<Node> &nodes,
+                              const Keyframe &keyframe,
+                              const std::vector<Vec2> &positions) {
+  for (size_t i = 0; i < keyframe.nodes.size(); ++i) {
+    if (keyframe.nodes[i] < static_cast<int>(nodes.size())) {
+      nodes[keyframe.nodes[i]].position = positions[i];
+    }
+  }
+}
+
+void ReplayLogger::Seek(std::vector<Node> &nodes, int from, int to) const {
+  int total = GetTotalMoves();
+  from = std::clamp(from, 0, total);
+  to = std::clamp(to, 0, total);
+
+  if (to >= from) {
+    // Finish from's block, then cross whole blocks by their end positions
+    int block = from / KEYFRAME_INTERVAL;
+    if (to < (block + 1) * KEYFRAME_INTERVAL) {
+      ApplyMoves(nodes, from + 1, to);
+      return;
+    }
+    ApplyDelta(nodes, keyframes_[block], keyframes_[block].after);
+    ++block;
+    while ((block + 1) * KEYFRAME_INTERVAL <= to) {
+      ApplyDelta(nodes, keyframes_[block], keyframes_[block].after);
+      ++block;
+    }
+    ApplyMoves(nodes, block * KEYFRAME_INTERVAL + 1, to);
+    return;
+  }
+
+  // Rewind to the start of from's block and on back past to, then replay
+  // the moves from that keyframe up to to
+  int block = (from - 1) / KEYFRAME_INTERVAL;
+  ApplyDelta(nodes, keyframes_[block], keyframes_[block].before);
+  while (block * KEYFRAME_INTERVAL > to) {
+    --block;
+    ApplyDelta(nodes, keyframes_[block], keyframes_[block].before);
+  }
+  ApplyMoves(nodes, block * KEYFRAME_INTERVAL + 1, to);
+}
+
 bool ReplayLogger::IsSolved() const {
   if (moves_.empty()) {
     return initialIntersections_ == 0;
@@ -95,6 +177,9 @@ void ReplayLogger::Clear() {
   edges_.clear();
   moves_.clear();
   initialIntersections_ = 0;
+  keyframes_.clear();
+  positions_.clear();
+  slotOf_.clear();
 }
 
 } // namespace GreedyTangle
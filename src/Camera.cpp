@@ -0,0 +1,35 @@
+#include "Camera.hpp"
+#include <algorithm>
+
+namespace GreedyTangle {
+
+Rect Camera::Viewport(int screenWidth, int screenHeight) const {
+  Vec2 topLeft = ScreenToWorld(Vec2(0.0f, 0.0f));
+  Vec2 bottomRight = ScreenToWorld(Vec2(static_cast<float>(screenWidth),
+                                        static_cast<float>(screenHeight)));
+  return Rect(topLeft.x, topLeft.y, bottomRight.x, bottomRight.y);
+}
+
+void Camera::Pan(const Vec2 &screenDelta) {
+  origin_ = origin_ - screenDelta * (1.0f / zoom_);
+}
+
+void Camera::ZoomAt(const Vec2 &screenAnchor, float factor) {
+  Vec2 anchor = ScreenToWorld(screenAnchor);
+  zoom_ = std::clamp(zoom_ * factor, MIN_ZOOM, MAX_ZOOM);
+  origin_ = anchor - screenAnchor * (1.0f / zoom_);
+}
+
+void Camera::Fit(const Rect &area, int screenWidth, int screenHeight) {
+  float width = std::max(area.Width(), 1.0f);
+  float height = std::max(area.Height(), 1.0f);
+  zoom_ = std::clamp(std::min(screenWidth / width, screenHeight / height),
+                     MIN_ZOOM, MAX_ZOOM);
+
+  // Split the spare room evenly on both sides
+  Vec2 center((area.minX + area.maxX) * 0.5f, (area.minY + area.maxY) * 0.5f);
+  Vec2 halfScreen(screenWidth * 0.5f, screenHeight * 0.5f);
+  origin_ = center - halfScreen * (1.0f / zoom_);
+}
+
+} // namespace GreedyTangle
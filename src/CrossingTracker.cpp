@@ -0,0 +1,168 @@
+#include "CrossingTracker.hpp"
+#include "MathUtils.hpp"
+#include "Trace.hpp"
+
+namespace GreedyTangle {
+
+int CrossingTracker::Update(const std::vector<Node> &nodes,
+                            std::vector<Edge> &edges) {
+  lastPairTests_ = 0;
+  recounted_ = false;
+  changedEdges_.clear();
+
+  if (!valid_ || !SameGraph(nodes, edges)) {
+    Rebuild(nodes, edges);
+  } else {
+    movedNodes_.clear();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const Vec2 &now = nodes[i].position;
+      if (now.x != positions_[i].x || now.y != positions_[i].y) {
+        movedNodes_.push_back(static_cast<int>(i));
+      }
+    }
+    if (!movedNodes_.empty()) {
+      UpdateMoved(nodes, edges);
+    }
+  }
+
+  // Cheap next to any retest, and keeps flags right if edges were rebuilt
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edges[i].isIntersecting = edgeCrossings_[i] > 0;
+  }
+  return total_;
+}
+
+bool CrossingTracker::SameGraph(const std::vector<Node> &nodes,
+                                const std::vector<Edge> &edges) const {
+  if (nodes.size() != positions_.size() ||
+      edges.size() != endpoints_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < edges.size(); ++i) {
+    if (edges[i].u_id != endpoints_[i].u_id ||
+        edges[i].v_id != endpoints_[i].v_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CrossingTracker::Rebuild(const std::vector<Node> &nodes,
+                              const std::vector<Edge> &edges) {
+  GT_TRACE_SCOPE("CrossingTracker::Rebuild", "frame");
+  size_t numEdges = edges.size();
+
+  positions_.resize(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    positions_[i] = nodes[i].position;
+  }
+  endpoints_.assign(edges.begin(), edges.end());
+
+  incident_.assign(nodes.size(), {});
+  for (size_t i = 0; i < numEdges; ++i) {
+    incident_[edges[i].u_id].push_back(static_cast<int>(i));
+    if (edges[i].v_id != edges[i].u_id) {
+      incident_[edges[i].v_id].push_back(static_cast<int>(i));
+    }
+  }
+
+  edgeCrossings_.assign(numEdges, 0);
+  total_ = 0;
+  for (size_t i = 0; i < numEdges; ++i) {
+    const Edge &e1 = edges[i];
+    const Vec2 &a = positions_[e1.u_id];
+    const Vec2 &b = positions_[e1.v_id];
+
+    for (size_t j = i + 1; j < numEdges; ++j) {
+      const Edge &e2 = edges[j];
+      if (e1.sharesVertex(e2)) {
+        continue;
+      }
+      ++lastPairTests_;
+      if (CheckIntersection(a, b, positions_[e2.u_id], positions_[e2.v_id])) {
+        ++edgeCrossings_[i];
+        ++edgeCrossings_[j];
+        ++total_;
+      }
+    }
+  }
+
+  affected_.assign(numEdges, 0);
+  valid_ = true;
+  recounted_ = true;
+}
+
+void CrossingTracker::UpdateMoved(const std::vector<Node> &nodes,
+                                  const std::vector<Edge> &edges) {
+  affectedEdges_.clear();
+  for (int id : movedNodes_) {
+    for (int edgeIndex : incident_[id]) {
+      if (!affected_[edgeIndex]) {
+        affected_[edgeIndex] = 1;
+        affectedEdges_.push_back(edgeIndex);
+      }
+    }
+  }
+
+  size_t numEdges = edges.size();
+  if (affectedEdges_.size() >
+      static_cast<size_t>(FULL_RECOUNT_FRACTION * numEdges)) {
+    for (int edgeIndex : affectedEdges_) {
+      affected_[edgeIndex] = 0;
+    }
+    Rebuild(nodes, edges);
+    return;
+  }
+
+  GT_TRACE_SCOPE("CrossingTracker::UpdateMoved", "frame");
+  auto current = [&](int id) -> const Vec2 & { return nodes[id].position; };
+
+  // positions_ still holds the layout the counters describe, so each pair
+  // is tested before and after and only a change of state is applied
+  for (int i : affectedEdges_) {
+    const Edge &e1 = edges[i];
+    const Vec2 &oldA = positions_[e1.u_id];
+    const Vec2 &oldB = positions_[e1.v_id];
+    const Vec2 &newA = current(e1.u_id);
+    const Vec2 &newB = current(e1.v_id);
+
+    for (size_t j = 0; j < numEdges; ++j) {
+      // Pairs of affected edges are visited once, from the lower index
+      if (affected_[j] && static_cast<int>(j) <= i) {
+        continue;
+      }
+      const Edge &e2 = edges[j];
+      if (e1.sharesVertex(e2)) {
+        continue;
+      }
+      lastPairTests_ += 2;
+      bool before = CheckIntersection(oldA, oldB, positions_[e2.u_id],
+                                      positions_[e2.v_id]);
+      bool after =
+          CheckIntersection(newA, newB, current(e2.u_id), current(e2.v_id));
+      if (before == after) {
+        continue;
+      }
+      int delta = after ? 1 : -1;
+      edgeCrossings_[i] += delta;
+      edgeCrossings_[j] += delta;
+      total_ += delta;
+      // Affected edges are reported below; others only when they flip
+      if (!affected_[j] && edgeCrossings_[j] == (after ? 1 : 0)) {
+        changedEdges_.push_back(static_cast<int>(j));
+      }
+    }
+  }
+
+  changedEdges_.insert(changedEdges_.end(), affectedEdges_.begin(),
+                       affectedEdges_.end());
+
+  for (int id : movedNodes_) {
+    positions_[id] = nodes[id].position;
+  }
+  for (int edgeIndex : affectedEdges_) {
+    affected_[edgeIndex] = 0;
+  }
+}
+
+} // namespace GreedyTangle
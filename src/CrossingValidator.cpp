@@ -0,0 +1,596 @@
+#include "CrossingValidator.hpp"
+#include "CrossingTracker.hpp"
+#include "Logger.hpp"
+#include "MathUtils.hpp"
+#include "PuzzleGenerator.hpp"
+#include "SolverFactory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+
+namespace GreedyTangle {
+
+namespace {
+
+constexpr float FIELD_WIDTH = 1024.0f;
+constexpr float FIELD_HEIGHT = 768.0f;
+
+std::atomic<uint64_t> gLiveDisagreements{0};
+
+// ---- Backends ----
+
+int CountReference(const CrossingCase &c) {
+  if (c.movedId < 0) {
+    return CountIntersections(c.nodes, c.edges);
+  }
+  std::vector<Node> moved = c.nodes;
+  moved[c.movedId].position = c.movedPosition;
+  return CountIntersections(moved, c.edges);
+}
+
+int CountWithMove(const CrossingCase &c) {
+  return CountIntersectionsWithMove(c.nodes, c.edges, c.movedId,
+                                    c.movedPosition);
+}
+
+// Total before the move, adjusted by the change in crossings on the moved
+// node's edges (the heatmap's shortcut)
+int CountIncidentDelta(const CrossingCase &c) {
+  int before = CountIntersections(c.nodes, c.edges);
+  if (c.movedId < 0) {
+    return before;
+  }
+  std::vector<int> incident;
+  for (size_t i = 0; i < c.edges.size(); ++i) {
+    if (c.edges[i].u_id == c.movedId || c.edges[i].v_id == c.movedId) {
+      incident.push_back(static_cast<int>(i));
+    }
+  }
+  return before - CountIncidentIntersections(c.nodes, c.edges, incident) +
+         CountIncidentIntersectionsWithMove(c.nodes, c.edges, incident,
+                                            c.movedId, c.movedPosition);
+}
+
+// Counters built on the layout, then updated for the move alone (the
+// game's per-frame path)
+int CountTracked(const CrossingCase &c) {
+  std::vector<Edge> edges = c.edges;
+  CrossingTracker tracker;
+  int count = tracker.Update(c.nodes, edges);
+  if (c.movedId < 0) {
+    return count;
+  }
+  std::vector<Node> moved = c.nodes;
+  moved[c.movedId].position = c.movedPosition;
+  return tracker.Update(moved, edges);
+}
+
+// ---- Case generation ----
+
+std::vector<Node> MakeNodes(const std::vector<Vec2> &positions) {
+  std::vector<Node> nodes;
+  nodes.reserve(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    nodes.emplace_back(static_cast<int>(i), positions[i]);
+  }
+  return nodes;
+}
+
+// Distinct, non-loop edges over nodeCount nodes
+std::vector<Edge> RandomEdges(int nodeCount, int edgeCount,
+                              std::mt19937 &gen) {
+  std::uniform_int_distribution<int> nodeDist(0, nodeCount - 1);
+  std::set<std::pair<int, int>> used;
+  std::vector<Edge> edges;
+  for (int attempt = 0;
+       static_cast<int>(edges.size()) < edgeCount && attempt < edgeCount * 8;
+       ++attempt) {
+    int u = nodeDist(gen);
+    int v = nodeDist(gen);
+    if (u == v || !used.insert({std::min(u, v), std::max(u, v)}).second) {
+      continue;
+    }
+    edges.emplace_back(u, v);
+  }
+  return edges;
+}
+
+// An endpoint of a random edge, so the move changes something
+int PickMovedNode(const std::vector<Edge> &edges, int nodeCount,
+                  std::mt19937 &gen) {
+  if (edges.empty()) {
+    return std::uniform_int_distribution<int>(0, nodeCount - 1)(gen);
+  }
+  const Edge &edge = edges[std::uniform_int_distribution<size_t>(
+      0, edges.size() - 1)(gen)];
+  return std::bernoulli_distribution(0.5)(gen) ? edge.u_id : edge.v_id;
+}
+
+Vec2 UniformPoint(std::mt19937 &gen) {
+  return {std::uniform_real_distribution<float>(0.0f, FIELD_WIDTH)(gen),
+          std::uniform_real_distribution<float>(0.0f, FIELD_HEIGHT)(gen)};
+}
+
+enum class AdversarialKind { COLLINEAR, DUPLICATE, NEAR_EPSILON, LATTICE };
+
+const char *AdversarialKindKey(AdversarialKind kind) {
+  switch (kind) {
+  case AdversarialKind::COLLINEAR:
+    return "collinear";
+  case AdversarialKind::DUPLICATE:
+    return "duplicate";
+  case AdversarialKind::NEAR_EPSILON:
+    return "near-epsilon";
+  case AdversarialKind::LATTICE:
+    return "lattice";
+  }
+  return "unknown";
+}
+
+/**
+ * A point placed to stress CheckIntersection's degenerate branches, given
+ * the points placed so far.
+ */
+Vec2 AdversarialPoint(AdversarialKind kind, const std::vector<Vec2> &placed,
+                      std::mt19937 &gen) {
+  auto pick = [&]() -> const Vec2 & {
+    return placed[std::uniform_int_distribution<size_t>(0, placed.size() -
+                                                               1)(gen)];
+  };
+  auto choose = [&](std::initializer_list<float> values) {
+    return *(values.begin() + std::uniform_int_distribution<size_t>(
+                                  0, values.size() - 1)(gen));
+  };
+
+  switch (kind) {
+  case AdversarialKind::LATTICE: {
+    // A 5x5 lattice: many exactly collinear and touching segments
+    std::uniform_int_distribution<int> step(0, 4);
+    return {128.0f + 192.0f * step(gen), 96.0f + 144.0f * step(gen)};
+  }
+  case AdversarialKind::COLLINEAR: {
+    if (std::bernoulli_distribution(0.2)(gen)) {
+      return UniformPoint(gen);
+    }
+    // Points on a few shared lines, so segments overlap along them
+    float s = std::uniform_real_distribution<float>(0.0f, 1.0f)(gen);
+    switch (std::uniform_int_distribution<int>(0, 3)(gen)) {
+    case 0:
+      return {s * FIELD_WIDTH, FIELD_HEIGHT / 2.0f};
+    case 1:
+      return {FIELD_WIDTH / 2.0f, s * FIELD_HEIGHT};
+    case 2:
+      return {s * FIELD_HEIGHT, s * FIELD_HEIGHT};
+    default:
+      return {100.0f + s * 600.0f, 700.0f - s * 600.0f};
+    }
+  }
+  case AdversarialKind::DUPLICATE:
+    if (placed.empty() || std::bernoulli_distribution(0.4)(gen)) {
+      return UniformPoint(gen);
+    }
+    return pick();
+  case AdversarialKind::NEAR_EPSILON: {
+    if (placed.size() < 2 || std::bernoulli_distribution(0.15)(gen)) {
+      return UniformPoint(gen);
+    }
+    const Vec2 &a = pick();
+    const Vec2 &b = pick();
+    if (std::bernoulli_distribution(0.25)(gen)) {
+      // A short segment from a: its cross products sit near EPSILON
+      float len = choose({1e-3f, 3e-3f, 1e-2f});
+      Vec2 dir = b - a;
+      float mag = dir.magnitude();
+      if (mag < EPSILON) {
+        return {a.x + len, a.y};
+      }
+      return a + dir * (len / mag);
+    }
+    // On or just off segment ab, near its ends or middle
+    float t = choose({0.0f, EPSILON, 2.0f * EPSILON, -EPSILON, 0.5f,
+                      1.0f - EPSILON, 1.0f - 2.0f * EPSILON, 1.0f,
+                      1.0f + EPSILON});
+    float offset = choose({0.0f, 0.0f, EPSILON, -EPSILON, 0.5f * EPSILON,
+                           1e-3f, -1e-3f});
+    Vec2 ab = b - a;
+    float mag = ab.magnitude();
+    Vec2 normal = mag < EPSILON ? Vec2(0.0f, 1.0f)
+                                : Vec2(-ab.y / mag, ab.x / mag);
+    return a + ab * t + normal * (offset * std::max(1.0f, mag));
+  }
+  }
+  return UniformPoint(gen);
+}
+
+bool Disagrees(const CrossingCase &c, const CrossingBackend &backend) {
+  return backend.count(c) != CountReference(c);
+}
+
+// Drops nodes no edge uses (except the moved one) and renumbers the rest
+CrossingCase CompactNodes(const CrossingCase &c) {
+  std::vector<int> remap(c.nodes.size(), -1);
+  auto keep = [&](int id) {
+    if (id >= 0 && remap[id] < 0) {
+      remap[id] = 0;
+    }
+  };
+  for (const Edge &edge : c.edges) {
+    keep(edge.u_id);
+    keep(edge.v_id);
+  }
+  keep(c.movedId);
+
+  CrossingCase compact;
+  compact.source = c.source;
+  compact.movedPosition = c.movedPosition;
+  for (size_t i = 0; i < c.nodes.size(); ++i) {
+    if (remap[i] >= 0) {
+      remap[i] = static_cast<int>(compact.nodes.size());
+      compact.nodes.emplace_back(remap[i], c.nodes[i].position);
+    }
+  }
+  for (const Edge &edge : c.edges) {
+    compact.edges.emplace_back(remap[edge.u_id], remap[edge.v_id]);
+  }
+  compact.movedId = c.movedId >= 0 ? remap[c.movedId] : -1;
+  return compact;
+}
+
+std::string KindOf(const std::string &source) {
+  return source.substr(0, source.find(':'));
+}
+
+void WriteCase(const CrossingCase &c, std::ostream &out) {
+  out << std::setprecision(9);
+  for (const Node &node : c.nodes) {
+    out << "  node " << node.id << " (" << node.position.x << ", "
+        << node.position.y << ")\n";
+  }
+  for (const Edge &edge : c.edges) {
+    out << "  edge " << edge.u_id << "-" << edge.v_id << '\n';
+  }
+  if (c.movedId >= 0) {
+    out << "  move node " << c.movedId << " -> (" << c.movedPosition.x << ", "
+        << c.movedPosition.y << ")\n";
+  }
+}
+
+} // namespace
+
+bool ValidationReport::Passed() const {
+  for (const BackendTally &tally : tallies) {
+    if (tally.disagreements > 0)
+      return false;
+  }
+  return true;
+}
+
+const std::vector<CrossingBackend> &CrossingValidator::Backends() {
+  static const std::vector<CrossingBackend> backends = {
+      {"reference", "CountIntersections on a moved copy", CountReference},
+      {"with-move", "CountIntersectionsWithMove (Greedy scoring)",
+       CountWithMove},
+      {"incident-delta", "Total plus change on incident edges (heatmap)",
+       CountIncidentDelta},
+      {"tracker", "CrossingTracker counters after an incremental update",
+       CountTracked},
+  };
+  return backends;
+}
+
+const CrossingBackend *CrossingValidator::FindBackend(const std::string &key) {
+  for (const CrossingBackend &backend : Backends()) {
+    if (key == backend.key)
+      return &backend;
+  }
+  return nullptr;
+}
+
+int CrossingValidator::ReferenceCount(const CrossingCase &testCase) {
+  return CountReference(testCase);
+}
+
+std::vector<CrossingCase> CrossingValidator::RandomCases(uint32_t seed,
+                                                         int count) {
+  std::mt19937 gen(seed * 2654435761u + 17u);
+  std::vector<CrossingCase> cases;
+  cases.reserve(count);
+
+  for (int i = 0; i < count; ++i) {
+    CrossingCase c;
+    if (i % 4 == 3) {
+      // Every fourth case is a real puzzle layout with a random move
+      PuzzleFamily family = static_cast<PuzzleFamily>((i / 4) % 3);
+      int nodeCount = std::uniform_int_distribution<int>(8, 40)(gen);
+      Puzzle puzzle = GeneratePuzzle(family, nodeCount, gen());
+      c.nodes = std::move(puzzle.nodes);
+      c.edges = std::move(puzzle.edges);
+      c.source = std::string("puzzle:") + PuzzleFamilyKey(family);
+    } else {
+      int nodeCount = std::uniform_int_distribution<int>(4, 40)(gen);
+      int edgeCount =
+          std::uniform_int_distribution<int>(nodeCount / 2, nodeCount * 2)(gen);
+      std::vector<Vec2> positions(nodeCount);
+      for (Vec2 &p : positions) {
+        p = UniformPoint(gen);
+      }
+      c.nodes = MakeNodes(positions);
+      c.edges = RandomEdges(nodeCount, edgeCount, gen);
+      c.source = "random";
+    }
+    c.movedId = PickMovedNode(c.edges, static_cast<int>(c.nodes.size()), gen);
+    c.movedPosition = UniformPoint(gen);
+    cases.push_back(std::move(c));
+  }
+  return cases;
+}
+
+std::vector<CrossingCase> CrossingValidator::AdversarialCases(uint32_t seed,
+                                                              int count) {
+  std::mt19937 gen(seed * 2654435761u + 29u);
+  std::vector<CrossingCase> cases;
+  cases.reserve(count);
+
+  for (int i = 0; i < count; ++i) {
+    AdversarialKind kind = static_cast<AdversarialKind>(i % 4);
+    int nodeCount = std::uniform_int_distribution<int>(4, 16)(gen);
+    int edgeCount =
+        std::uniform_int_distribution<int>(nodeCount, nodeCount * 2)(gen);
+
+    std::vector<Vec2> positions;
+    positions.reserve(nodeCount);
+    for (int n = 0; n < nodeCount; ++n) {
+      positions.push_back(AdversarialPoint(kind, positions, gen));
+    }
+
+    CrossingCase c;
+    c.nodes = MakeNodes(positions);
+    c.edges = RandomEdges(nodeCount, edgeCount, gen);
+    c.movedId = PickMovedNode(c.edges, nodeCount, gen);
+    c.movedPosition = AdversarialPoint(kind, positions, gen);
+    c.source = AdversarialKindKey(kind);
+    cases.push_back(std::move(c));
+  }
+  return cases;
+}
+
+std::vector<CrossingCase>
+CrossingValidator::ReplayCases(const ReplayLogger &replay,
+                               const std::string &source) {
+  std::vector<Node> nodes = MakeNodes(replay.GetInitialPositions());
+  std::vector<Edge> edges;
+  for (const auto &pair : replay.GetEdgePairs()) {
+    edges.emplace_back(pair.first, pair.second);
+  }
+
+  std::vector<CrossingCase> cases;
+  for (int step = 1; step <= replay.GetTotalMoves(); ++step) {
+    const CPUMove &move = replay.GetMoveAt(step);
+    if (move.node_id < 0 || move.node_id >= static_cast<int>(nodes.size()))
+      continue;
+
+    CrossingCase c;
+    c.nodes = nodes;
+    c.edges = edges;
+    c.movedId = move.node_id;
+    c.movedPosition = move.to_position;
+    c.source = source + " step " + std::to_string(step);
+    cases.push_back(std::move(c));
+
+    nodes[move.node_id].position = move.to_position;
+  }
+  return cases;
+}
+
+std::vector<CrossingCase> CrossingValidator::RecordedSessionCases(uint32_t seed) {
+  // Small sizes: the point is real solver trajectories, not search time
+  struct Session {
+    SolverMode mode;
+    int nodeCount;
+    int maxMoves;
+  };
+  const Session sessions[] = {{SolverMode::GREEDY, 12, 6},
+                              {SolverMode::BACKTRACKING, 6, 2},
+                              {SolverMode::DIVIDE_AND_CONQUER_DP, 16, 6}};
+  const PuzzleFamily families[] = {PuzzleFamily::CYCLE_CHORDS,
+                                   PuzzleFamily::GRID_MESH,
+                                   PuzzleFamily::TRIANGULATION};
+
+  std::vector<CrossingCase> cases;
+  for (const Session &session : sessions) {
+    std::unique_ptr<ICPUSolver> solver = CreateSolver(session.mode);
+    for (PuzzleFamily family : families) {
+      Puzzle puzzle = GeneratePuzzle(family, session.nodeCount, seed);
+      std::vector<Node> nodes = puzzle.nodes;
+
+      ReplayLogger replay;
+      replay.StartMatch(nodes, puzzle.edges,
+                        CountIntersections(nodes, puzzle.edges));
+      for (int m = 0; m < session.maxMoves; ++m) {
+        CPUMove move = solver->FindBestMove(nodes, puzzle.edges);
+        if (!move.isValid() || move.intersection_reduction <= 0)
+          break;
+        replay.RecordMove(move);
+        nodes[move.node_id].position = move.to_position;
+      }
+
+      std::string source = std::string("replay:") +
+                           SolverModeKey(session.mode) + "/" +
+                           PuzzleFamilyKey(family) + " seed " +
+                           std::to_string(seed);
+      std::vector<CrossingCase> recorded = ReplayCases(replay, source);
+      std::move(recorded.begin(), recorded.end(), std::back_inserter(cases));
+    }
+  }
+  return cases;
+}
+
+CrossingCase CrossingValidator::Minimize(const CrossingCase &testCase,
+                                         const CrossingBackend &backend) {
+  CrossingCase best = testCase;
+  bool shrunk = true;
+  while (shrunk) {
+    shrunk = false;
+    for (size_t i = 0; i < best.edges.size();) {
+      CrossingCase trial = best;
+      trial.edges.erase(trial.edges.begin() + static_cast<ptrdiff_t>(i));
+      if (Disagrees(trial, backend)) {
+        best = std::move(trial);
+        shrunk = true;
+      } else {
+        ++i;
+      }
+    }
+  }
+
+  CrossingCase compact = CompactNodes(best);
+  return Disagrees(compact, backend) ? compact : best;
+}
+
+ValidationReport CrossingValidator::Run(const ValidationConfig &config) {
+  std::vector<const CrossingBackend *> backends;
+  for (const CrossingBackend &backend : Backends()) {
+    bool wanted = config.backends.empty() ||
+                  std::find(config.backends.begin(), config.backends.end(),
+                            backend.key) != config.backends.end();
+    if (wanted && &backend != &Backends().front()) {
+      backends.push_back(&backend);
+    }
+  }
+
+  ValidationReport report;
+  for (const CrossingBackend *backend : backends) {
+    report.tallies.push_back({backend->key, 0, 0});
+  }
+
+  auto countKind = [&](const std::string &kind) {
+    for (auto &entry : report.casesPerKind) {
+      if (entry.first == kind) {
+        ++entry.second;
+        return;
+      }
+    }
+    report.casesPerKind.emplace_back(kind, 1);
+  };
+
+  auto check = [&](const CrossingCase &c) {
+    ++report.cases;
+    countKind(KindOf(c.source));
+    int reference = CountReference(c);
+    for (size_t b = 0; b < backends.size(); ++b) {
+      BackendTally &tally = report.tallies[b];
+      ++tally.comparisons;
+      int got = backends[b]->count(c);
+      if (got == reference)
+        continue;
+      if (++tally.disagreements > MAX_REPORTED_PER_BACKEND)
+        continue;
+
+      Disagreement d;
+      d.backend = backends[b]->key;
+      d.source = c.source;
+      d.referenceCount = reference;
+      d.backendCount = got;
+      d.originalEdges = c.edges.size();
+      d.minimized = Minimize(c, *backends[b]);
+      report.disagreements.push_back(std::move(d));
+    }
+  };
+
+  for (uint32_t seed : config.seeds) {
+    for (const CrossingCase &c : RandomCases(seed, config.randomCases)) {
+      check(c);
+    }
+    for (const CrossingCase &c :
+         AdversarialCases(seed, config.adversarialCases)) {
+      check(c);
+    }
+    if (config.replaySessions) {
+      for (const CrossingCase &c : RecordedSessionCases(seed)) {
+        check(c);
+      }
+    }
+  }
+  return report;
+}
+
+void CrossingValidator::WriteReport(const ValidationReport &report,
+                                    std::ostream &out) {
+  out << std::left << std::setw(18) << "Backend" << std::right
+      << std::setw(14) << "Comparisons" << std::setw(16) << "Disagreements"
+      << '\n';
+  out << std::string(48, '-') << '\n';
+  for (const BackendTally &tally : report.tallies) {
+    out << std::left << std::setw(18) << tally.backend << std::right
+        << std::setw(14) << tally.comparisons << std::setw(16)
+        << tally.disagreements << '\n';
+  }
+
+  out << "\ncases: " << report.cases << " (";
+  for (size_t i = 0; i < report.casesPerKind.size(); ++i) {
+    out << (i ? ", " : "") << report.casesPerKind[i].first << ' '
+        << report.casesPerKind[i].second;
+  }
+  out << ")\n";
+
+  for (const Disagreement &d : report.disagreements) {
+    out << "\nDISAGREE " << d.backend << " on " << d.source << ": reference "
+        << d.referenceCount << ", backend " << d.backendCount << " ("
+        << d.originalEdges << " edges, minimized to "
+        << d.minimized.edges.size() << ")\n";
+    WriteCase(d.minimized, out);
+  }
+
+  out << '\n';
+  if (report.Passed()) {
+    out << "PASS: " << report.tallies.size()
+        << " backends agree with the reference on " << report.cases
+        << " cases\n";
+  } else {
+    uint64_t total = 0;
+    for (const BackendTally &tally : report.tallies) {
+      total += tally.disagreements;
+    }
+    out << "FAIL: " << total << " disagreements with the reference\n";
+  }
+}
+
+void CrossingValidator::CheckLive(const char *backendKey, int count,
+                                  const std::vector<Node> &nodes,
+                                  const std::vector<Edge> &edges, int movedId,
+                                  const Vec2 &movedPosition) {
+  CrossingCase c;
+  c.nodes = nodes;
+  c.edges = edges;
+  c.movedId = movedId;
+  c.movedPosition = movedPosition;
+  int reference = CountReference(c);
+  if (count == reference)
+    return;
+
+  gLiveDisagreements.fetch_add(1, std::memory_order_relaxed);
+  GT_LOG_WARN("CrossingValidator",
+              "{} counted {} crossings, reference {} ({} nodes, {} edges)",
+              backendKey, count, reference, nodes.size(), edges.size());
+
+  if (const CrossingBackend *backend = FindBackend(backendKey)) {
+    CrossingCase minimized = Minimize(c, *backend);
+    std::stringstream text;
+    WriteCase(minimized, text);
+    std::string line;
+    while (std::getline(text, line)) {
+      GT_LOG_WARN("CrossingValidator", "{}", line);
+    }
+  }
+}
+
+uint64_t CrossingValidator::LiveDisagreements() {
+  return gLiveDisagreements.load(std::memory_order_relaxed);
+}
+
+} // namespace GreedyTangle
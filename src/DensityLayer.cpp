@@ -0,0 +1,261 @@
+#include "DensityLayer.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace GreedyTangle {
+
+namespace {
+
+bool SameColor(const SDL_Color &a, const SDL_Color &b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+bool SamePoint(const Vec2 &a, const Vec2 &b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+} // namespace
+
+DensityLayer::~DensityLayer() { Destroy(); }
+
+void DensityLayer::Init(SDL_Renderer *renderer) { renderer_ = renderer; }
+
+void DensityLayer::MarkEdges(const std::vector<int> &edgeIndices) {
+  if (!valid_) {
+    return; // The rebuild picks everything up
+  }
+  for (int i : edgeIndices) {
+    if (i >= 0 && static_cast<size_t>(i) < isPending_.size() &&
+        !isPending_[i]) {
+      isPending_[i] = 1;
+      pending_.push_back(i);
+    }
+  }
+}
+
+void DensityLayer::Destroy() {
+  if (texture_) {
+    SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+  }
+  textureWidth_ = 0;
+  textureHeight_ = 0;
+  valid_ = false;
+}
+
+DensityLayer::CellBox DensityLayer::CellsOf(const Slot &slot) const {
+  auto column = [&](float x) {
+    return std::clamp(static_cast<int>((x - area_.minX) / cellSize_), 0,
+                      columns_ - 1);
+  };
+  auto row = [&](float y) {
+    return std::clamp(static_cast<int>((y - area_.minY) / cellSize_), 0,
+                      rows_ - 1);
+  };
+  return {column(std::min(slot.from.x, slot.to.x)),
+          row(std::min(slot.from.y, slot.to.y)),
+          column(std::max(slot.from.x, slot.to.x)),
+          row(std::max(slot.from.y, slot.to.y))};
+}
+
+void DensityLayer::Rasterize(const Slot &slot, int delta) {
+  // DDA in cell units: one step per cell along the major axis
+  float x = (slot.from.x - area_.minX) / cellSize_;
+  float y = (slot.from.y - area_.minY) / cellSize_;
+  float dx = (slot.to.x - area_.minX) / cellSize_ - x;
+  float dy = (slot.to.y - area_.minY) / cellSize_ - y;
+  int steps = std::max(1, static_cast<int>(std::ceil(
+                              std::max(std::fabs(dx), std::fabs(dy)))));
+  dx /= static_cast<float>(steps);
+  dy /= static_cast<float>(steps);
+
+  int lastCell = -1;
+  for (int i = 0; i <= steps; ++i) {
+    int column = std::clamp(static_cast<int>(x), 0, columns_ - 1);
+    int row = std::clamp(static_cast<int>(y), 0, rows_ - 1);
+    int cell = row * columns_ + column;
+    if (cell != lastCell) {
+      coverage_[cell] += delta;
+      if (slot.critical) {
+        crossing_[cell] += delta;
+      }
+      lastCell = cell;
+    }
+    x += dx;
+    y += dy;
+  }
+}
+
+void DensityLayer::MarkDirty(const CellBox &cells) {
+  if (!dirty_) {
+    dirtyBox_ = cells;
+    dirty_ = true;
+    return;
+  }
+  dirtyBox_.x0 = std::min(dirtyBox_.x0, cells.x0);
+  dirtyBox_.y0 = std::min(dirtyBox_.y0, cells.y0);
+  dirtyBox_.x1 = std::max(dirtyBox_.x1, cells.x1);
+  dirtyBox_.y1 = std::max(dirtyBox_.y1, cells.y1);
+}
+
+void DensityLayer::Rebuild(const std::vector<Node> &nodes,
+                           const std::vector<Edge> &edges) {
+  GT_TRACE_SCOPE("DensityLayer::Rebuild", "frame");
+  Rect bounds = GraphBounds(nodes);
+  float extent = std::max({bounds.Width(), bounds.Height(), 1.0f});
+  area_ = bounds.Expanded(extent * AREA_SLACK);
+  cellSize_ = std::max(area_.Width(), area_.Height()) / MAX_GRID_SIZE;
+  columns_ = std::clamp(
+      static_cast<int>(std::ceil(area_.Width() / cellSize_)), 1,
+      MAX_GRID_SIZE);
+  rows_ = std::clamp(static_cast<int>(std::ceil(area_.Height() / cellSize_)),
+                     1, MAX_GRID_SIZE);
+
+  size_t cells = static_cast<size_t>(columns_) * rows_;
+  coverage_.assign(cells, 0);
+  crossing_.assign(cells, 0);
+  pixels_.assign(cells, 0);
+  slots_.resize(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    Slot &slot = slots_[i];
+    slot.from = nodes[edges[i].u_id].position;
+    slot.to = nodes[edges[i].v_id].position;
+    slot.critical = edges[i].isIntersecting;
+    Rasterize(slot, 1);
+  }
+  lastRasterized_ = edges.size();
+  pending_.clear();
+  isPending_.assign(edges.size(), 0);
+
+  dirty_ = false;
+  MarkDirty({0, 0, columns_ - 1, rows_ - 1});
+  valid_ = true;
+}
+
+void DensityLayer::Shade(SDL_Color safe, SDL_Color critical) {
+  for (int y = dirtyBox_.y0; y <= dirtyBox_.y1; ++y) {
+    for (int x = dirtyBox_.x0; x <= dirtyBox_.x1; ++x) {
+      size_t cell = static_cast<size_t>(y) * columns_ + x;
+      uint32_t coverage = coverage_[cell];
+      if (coverage == 0) {
+        pixels_[cell] = 0;
+        continue;
+      }
+      // Brightness by how many edges pass, hue by how many of them cross
+      float intensity = std::min(
+          1.0f, std::sqrt(static_cast<float>(coverage) / SATURATION));
+      float share = static_cast<float>(crossing_[cell]) / coverage;
+      auto mix = [&](Uint8 a, Uint8 b) {
+        return static_cast<uint32_t>(a + (b - a) * share);
+      };
+      uint32_t alpha = static_cast<uint32_t>(64.0f + 191.0f * intensity);
+      pixels_[cell] = alpha << 24 | mix(safe.r, critical.r) << 16 |
+                      mix(safe.g, critical.g) << 8 | mix(safe.b, critical.b);
+    }
+  }
+}
+
+bool DensityLayer::Upload() {
+  if (!texture_ || textureWidth_ != columns_ || textureHeight_ != rows_) {
+    if (texture_) {
+      SDL_DestroyTexture(texture_);
+    }
+    texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888,
+                                 SDL_TEXTUREACCESS_STREAMING, columns_, rows_);
+    if (!texture_) {
+      GT_LOG_WARN("Render", "Density texture failed ({}), zoomed-out graphs "
+                            "are drawn edge by edge",
+                  SDL_GetError());
+      failed_ = true;
+      return false;
+    }
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+    textureWidth_ = columns_;
+    textureHeight_ = rows_;
+    MarkDirty({0, 0, columns_ - 1, rows_ - 1});
+  }
+
+  SDL_Rect rect = {dirtyBox_.x0, dirtyBox_.y0, dirtyBox_.x1 - dirtyBox_.x0 + 1,
+                   dirtyBox_.y1 - dirtyBox_.y0 + 1};
+  const uint32_t *first =
+      &pixels_[static_cast<size_t>(dirtyBox_.y0) * columns_ + dirtyBox_.x0];
+  if (SDL_UpdateTexture(texture_, &rect, first,
+                        columns_ * static_cast<int>(sizeof(uint32_t))) != 0) {
+    GT_LOG_WARN("Render", "Density texture upload failed: {}",
+                SDL_GetError());
+  }
+  return true;
+}
+
+bool DensityLayer::Draw(const std::vector<Node> &nodes,
+                        const std::vector<Edge> &edges, const Camera &camera,
+                        SDL_Color safe, SDL_Color critical) {
+  GT_TRACE_SCOPE("DensityLayer::Draw", "frame");
+  if (!renderer_ || failed_) {
+    return false;
+  }
+
+  lastRasterized_ = 0;
+  if (!valid_ || slots_.size() != edges.size()) {
+    Rebuild(nodes, edges);
+  } else if (!pending_.empty()) {
+    bool leftArea = false;
+    for (int i : pending_) {
+      leftArea = leftArea || !area_.Contains(nodes[edges[i].u_id].position) ||
+                 !area_.Contains(nodes[edges[i].v_id].position);
+    }
+
+    if (leftArea || pending_.size() > edges.size() * REBUILD_FRACTION) {
+      Rebuild(nodes, edges);
+    } else {
+      for (int i : pending_) {
+        Slot &slot = slots_[i];
+        isPending_[i] = 0;
+        const Vec2 &from = nodes[edges[i].u_id].position;
+        const Vec2 &to = nodes[edges[i].v_id].position;
+        if (SamePoint(slot.from, from) && SamePoint(slot.to, to) &&
+            slot.critical == edges[i].isIntersecting) {
+          continue; // Flipped and back again
+        }
+        Rasterize(slot, -1);
+        MarkDirty(CellsOf(slot));
+        slot.from = from;
+        slot.to = to;
+        slot.critical = edges[i].isIntersecting;
+        Rasterize(slot, 1);
+        MarkDirty(CellsOf(slot));
+        ++lastRasterized_;
+      }
+      pending_.clear();
+    }
+  }
+
+  if (!SameColor(colors_[0], safe) || !SameColor(colors_[1], critical)) {
+    colors_[0] = safe;
+    colors_[1] = critical;
+    MarkDirty({0, 0, columns_ - 1, rows_ - 1});
+  }
+  if (dirty_) {
+    Shade(safe, critical);
+    if (!Upload()) {
+      return false;
+    }
+    dirty_ = false;
+  }
+
+  // The grid stretched over its world area
+  Vec2 topLeft = camera.WorldToScreen(Vec2(area_.minX, area_.minY));
+  Vec2 bottomRight = camera.WorldToScreen(
+      Vec2(area_.minX + columns_ * cellSize_, area_.minY + rows_ * cellSize_));
+  SDL_Rect destination = {
+      static_cast<int>(std::floor(topLeft.x)),
+      static_cast<int>(std::floor(topLeft.y)),
+      static_cast<int>(std::ceil(bottomRight.x - topLeft.x)),
+      static_cast<int>(std::ceil(bottomRight.y - topLeft.y))};
+  SDL_RenderCopy(renderer_, texture_, nullptr, &destination);
+  return true;
+}
+
+} // namespace GreedyTangle
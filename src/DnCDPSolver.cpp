@@ -16,28 +16,29 @@
 
 #include "DnCDPSolver.hpp"
 #include "GreedySolver.hpp"
+#include "Logger.hpp"
 #include "MathUtils.hpp"
+#include "Trace.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
-#include <iostream>
 #include <limits>
 #include <numeric>
 
 namespace GreedyTangle {
 
 DnCDPSolver::Partition DnCDPSolver::CreatePartition(
-    const std::vector<int> &nodeIndices,
+    std::pmr::vector<int> nodeIndices,
     const std::vector<Node> &nodes) {
 
-  Partition p;
-  p.nodeIndices = nodeIndices;
+  Partition p(&arena_);
+  p.nodeIndices = std::move(nodeIndices);
   p.xMin = std::numeric_limits<float>::max();
   p.xMax = std::numeric_limits<float>::lowest();
   p.yMin = std::numeric_limits<float>::max();
   p.yMax = std::numeric_limits<float>::lowest();
 
-  for (int idx : nodeIndices) {
+  for (int idx : p.nodeIndices) {
     const Vec2 &pos = nodes[idx].position;
     p.xMin = std::min(p.xMin, pos.x);
     p.xMax = std::max(p.xMax, pos.x);
@@ -51,8 +52,11 @@ DnCDPSolver::Partition DnCDPSolver::CreatePartition(
 std::pair<DnCDPSolver::Partition, DnCDPSolver::Partition>
 DnCDPSolver::SplitPartition(const Partition &partition,
                              const std::vector<Node> &nodes) {
+  GT_TRACE_SCOPE("SplitPartition", "solver");
+  ScopedPhaseTimer generation_timer(stats_.generationNs);
 
-  std::vector<std::pair<float, int>> xPositions;
+  std::pmr::vector<std::pair<float, int>> xPositions(&arena_);
+  xPositions.reserve(partition.nodeIndices.size());
   for (int idx : partition.nodeIndices) {
     xPositions.emplace_back(nodes[idx].position.x, idx);
   }
@@ -60,7 +64,9 @@ DnCDPSolver::SplitPartition(const Partition &partition,
 
   size_t midpoint = xPositions.size() / 2;
 
-  std::vector<int> leftIndices, rightIndices;
+  std::pmr::vector<int> leftIndices(&arena_), rightIndices(&arena_);
+  leftIndices.reserve(midpoint);
+  rightIndices.reserve(xPositions.size() - midpoint);
   for (size_t i = 0; i < xPositions.size(); ++i) {
     if (i < midpoint) {
       leftIndices.push_back(xPositions[i].second);
@@ -69,10 +75,10 @@ DnCDPSolver::SplitPartition(const Partition &partition,
     }
   }
 
-  Partition left = CreatePartition(leftIndices, nodes);
-  Partition right = CreatePartition(rightIndices, nodes);
+  Partition left = CreatePartition(std::move(leftIndices), nodes);
+  Partition right = CreatePartition(std::move(rightIndices), nodes);
 
-  return {left, right};
+  return {std::move(left), std::move(right)};
 }
 
 std::vector<Edge> DnCDPSolver::GetRelevantEdges(
@@ -99,8 +105,9 @@ std::vector<Edge> DnCDPSolver::GetRelevantEdges(
 CPUMove DnCDPSolver::SolveBaseCase(std::vector<Node> &nodes,
                                     const std::vector<Edge> &edges,
                                     const Partition &partition) {
+  GT_TRACE_SCOPE("SolveBaseCase", "solver");
   CPUMove best_move;
-  int current_intersections = CountIntersections(nodes, edges);
+  int current_intersections = CountCrossings(nodes, edges);
   best_move.intersections_before = current_intersections;
   int best_reduction = 0;
 
@@ -110,15 +117,19 @@ CPUMove DnCDPSolver::SolveBaseCase(std::vector<Node> &nodes,
 
     float stepX = (partition.xMax - partition.xMin) / 6.0f;
     float stepY = (partition.yMax - partition.yMin) / 6.0f;
-    if (stepX < 20.0f) stepX = 20.0f;
-    if (stepY < 20.0f) stepY = 20.0f;
-
-    for (float x = MARGIN; x <= WINDOW_WIDTH - MARGIN; x += stepX) {
-      for (float y = MARGIN; y <= WINDOW_HEIGHT - MARGIN; y += stepY) {
+    float minStep = GridSpacingFor(canvas_, 20.0f);
+    if (stepX < minStep) stepX = minStep;
+    if (stepY < minStep) stepY = minStep;
+
+    for (float x = canvas_.minX + MARGIN; x <= canvas_.maxX - MARGIN;
+         x += stepX) {
+      for (float y = canvas_.minY + MARGIN; y <= canvas_.maxY - MARGIN;
+           y += stepY) {
         ++lastCandidatesEvaluated_;
+        SolverStats::Add(stats_.candidatesEvaluated);
 
         nodes[nodeIdx].position = Vec2(x, y);
-        int newCount = CountIntersections(nodes, edges);
+        int newCount = CountCrossings(nodes, edges);
         int reduction = current_intersections - newCount;
 
         if (reduction > best_reduction) {
@@ -128,6 +139,7 @@ CPUMove DnCDPSolver::SolveBaseCase(std::vector<Node> &nodes,
           best_move.to_position = Vec2(x, y);
           best_move.intersections_after = newCount;
           best_move.intersection_reduction = reduction;
+          PublishImprovement(best_move);
         }
       }
     }
@@ -138,17 +150,23 @@ CPUMove DnCDPSolver::SolveBaseCase(std::vector<Node> &nodes,
   return best_move;
 }
 
-std::vector<Vec2> DnCDPSolver::GenerateDPCandidates(const Partition &partition) {
-  std::vector<Vec2> candidates;
+std::pmr::vector<Vec2>
+DnCDPSolver::GenerateDPCandidates(const Partition &partition) {
+  GT_TRACE_SCOPE("GenerateCandidates", "solver");
+  ScopedPhaseTimer generation_timer(stats_.generationNs);
+  std::pmr::vector<Vec2> candidates(&arena_);
 
-  float pxMin = std::max(MARGIN, partition.xMin - 50.0f);
-  float pxMax = std::min(WINDOW_WIDTH - MARGIN, partition.xMax + 50.0f);
-  float pyMin = std::max(MARGIN, partition.yMin - 50.0f);
-  float pyMax = std::min(WINDOW_HEIGHT - MARGIN, partition.yMax + 50.0f);
+  float pxMin = std::max(canvas_.minX + MARGIN, partition.xMin - 50.0f);
+  float pxMax = std::min(canvas_.maxX - MARGIN, partition.xMax + 50.0f);
+  float pyMin = std::max(canvas_.minY + MARGIN, partition.yMin - 50.0f);
+  float pyMax = std::min(canvas_.maxY - MARGIN, partition.yMax + 50.0f);
 
   float spanX = pxMax - pxMin;
   float spanY = pyMax - pyMin;
   float step = std::max(40.0f, std::min(spanX, spanY) / 8.0f);
+  candidates.reserve((static_cast<size_t>(spanX / step) + 1) *
+                         (static_cast<size_t>(spanY / step) + 1) +
+                     1);
 
   for (float x = pxMin; x <= pxMax; x += step) {
     for (float y = pyMin; y <= pyMax; y += step) {
@@ -163,11 +181,13 @@ std::vector<Vec2> DnCDPSolver::GenerateDPCandidates(const Partition &partition)
   return candidates;
 }
 
-std::vector<int> DnCDPSolver::OrderNodesByDegree(
-    const std::vector<int> &nodeIndices,
+std::pmr::vector<int> DnCDPSolver::OrderNodesByDegree(
+    const std::pmr::vector<int> &nodeIndices,
     const std::vector<Node> &nodes) {
+  ScopedPhaseTimer generation_timer(stats_.generationNs);
 
-  std::vector<std::pair<int, int>> degreeList;
+  std::pmr::vector<std::pair<int, int>> degreeList(&arena_);
+  degreeList.reserve(nodeIndices.size());
   for (int idx : nodeIndices) {
     int degree = static_cast<int>(nodes[idx].adjacencyList.size());
     degreeList.emplace_back(degree, idx);
@@ -176,7 +196,8 @@ std::vector<int> DnCDPSolver::OrderNodesByDegree(
   std::sort(degreeList.begin(), degreeList.end(),
             [](const auto &a, const auto &b) { return a.first > b.first; });
 
-  std::vector<int> ordered;
+  std::pmr::vector<int> ordered(&arena_);
+  ordered.reserve(degreeList.size());
   for (const auto &p : degreeList) {
     ordered.push_back(p.second);
   }
@@ -190,7 +211,7 @@ int DnCDPSolver::EvaluatePlacement(std::vector<Node> &nodes,
   Vec2 original = nodes[nodeIndex].position;
   nodes[nodeIndex].position = position;
 
-  int intersections = CountIntersections(nodes, edges);
+  int intersections = CountCrossings(nodes, edges);
 
   nodes[nodeIndex].position = original;
   return intersections;
@@ -199,8 +220,10 @@ int DnCDPSolver::EvaluatePlacement(std::vector<Node> &nodes,
 CPUMove DnCDPSolver::SolveDP(std::vector<Node> &nodes,
                               const std::vector<Edge> &edges,
                               const Partition &partition) {
-  std::vector<int> ordered = OrderNodesByDegree(partition.nodeIndices, nodes);
-  std::vector<Vec2> candidates = GenerateDPCandidates(partition);
+  GT_TRACE_SCOPE("SolveDP", "solver");
+  std::pmr::vector<int> ordered =
+      OrderNodesByDegree(partition.nodeIndices, nodes);
+  std::pmr::vector<Vec2> candidates = GenerateDPCandidates(partition);
 
   if (ordered.empty() || candidates.empty()) {
     return CPUMove();
@@ -209,26 +232,46 @@ CPUMove DnCDPSolver::SolveDP(std::vector<Node> &nodes,
   int numNodes = static_cast<int>(ordered.size());
   int numCandidates = static_cast<int>(candidates.size());
 
-  std::vector<std::vector<int>> dp(numNodes, std::vector<int>(numCandidates,
-      std::numeric_limits<int>::max()));
-  std::vector<std::vector<int>> bestPrev(numNodes, std::vector<int>(numCandidates, -1));
+  // Row-major numNodes x numCandidates tables, one arena block each
+  size_t cells = static_cast<size_t>(numNodes) * numCandidates;
+  std::pmr::vector<int> dpTable(cells, std::numeric_limits<int>::max(),
+                                &arena_);
+  std::pmr::vector<int> bestPrevTable(cells, -1, &arena_);
+  auto dp = [&](int i) { return dpTable.data() + size_t(i) * numCandidates; };
+  auto bestPrev = [&](int i) {
+    return bestPrevTable.data() + size_t(i) * numCandidates;
+  };
 
-  int currentTotal = CountIntersections(nodes, edges);
+  int currentTotal = CountCrossings(nodes, edges);
 
   int firstNode = ordered[0];
   // Vec2 firstOriginal = nodes[firstNode].position; // Unused
   for (int j = 0; j < numCandidates; ++j) {
     if (IsCancelled()) break;
     ++lastCandidatesEvaluated_;
-    dp[0][j] = EvaluatePlacement(nodes, edges, firstNode, candidates[j]);
+    SolverStats::Add(stats_.candidatesEvaluated);
+    dp(0)[j] = EvaluatePlacement(nodes, edges, firstNode, candidates[j]);
+
+    // First-row placements move a single node, so they are valid moves
+    if (dp(0)[j] < currentTotal) {
+      CPUMove improvement;
+      improvement.node_id = firstNode;
+      improvement.from_position = nodes[firstNode].position;
+      improvement.to_position = candidates[j];
+      improvement.intersections_before = currentTotal;
+      improvement.intersections_after = dp(0)[j];
+      improvement.intersection_reduction = currentTotal - dp(0)[j];
+      PublishImprovement(improvement);
+    }
   }
+  PublishProgress(lastCandidatesEvaluated_);
 
   for (int i = 1; i < numNodes && !IsCancelled(); ++i) {
     int nodeIdx = ordered[i];
 
     int prevBestJ = 0;
     for (int j = 1; j < numCandidates; ++j) {
-      if (dp[i - 1][j] < dp[i - 1][prevBestJ]) {
+      if (dp(i - 1)[j] < dp(i - 1)[prevBestJ]) {
         prevBestJ = j;
       }
     }
@@ -239,25 +282,27 @@ CPUMove DnCDPSolver::SolveDP(std::vector<Node> &nodes,
 
     for (int j = 0; j < numCandidates; ++j) {
       ++lastCandidatesEvaluated_;
-      dp[i][j] = EvaluatePlacement(nodes, edges, nodeIdx, candidates[j]);
-      bestPrev[i][j] = prevBestJ;
+      SolverStats::Add(stats_.candidatesEvaluated);
+      dp(i)[j] = EvaluatePlacement(nodes, edges, nodeIdx, candidates[j]);
+      bestPrev(i)[j] = prevBestJ;
     }
 
     nodes[prevNode].position = prevOriginal;
+    PublishProgress(lastCandidatesEvaluated_);
   }
 
   int bestJ = 0;
   for (int j = 1; j < numCandidates; ++j) {
-    if (dp[numNodes - 1][j] < dp[numNodes - 1][bestJ]) {
+    if (dp(numNodes - 1)[j] < dp(numNodes - 1)[bestJ]) {
       bestJ = j;
     }
   }
 
 
-  std::vector<int> tracedPositions(numNodes);
+  std::pmr::vector<int> tracedPositions(numNodes, &arena_);
   tracedPositions[numNodes - 1] = bestJ;
   for (int i = numNodes - 2; i >= 0; --i) {
-    tracedPositions[i] = bestPrev[i + 1][tracedPositions[i + 1]];
+    tracedPositions[i] = bestPrev(i + 1)[tracedPositions[i + 1]];
     if (tracedPositions[i] < 0) tracedPositions[i] = 0;
   }
 
@@ -280,6 +325,7 @@ CPUMove DnCDPSolver::SolveDP(std::vector<Node> &nodes,
       move.to_position = candidatePos;
       move.intersections_after = cost;
       move.intersection_reduction = reduction;
+      PublishImprovement(move);
     }
   }
 
@@ -292,17 +338,17 @@ CPUMove DnCDPSolver::SolvePartition(std::vector<Node> &nodes,
   int partSize = static_cast<int>(partition.nodeIndices.size());
 
   if (partSize <= BASE_CASE_THRESHOLD) {
-    std::cout << "[D&C+DP] Base case: " << partSize << " nodes" << std::endl;
+    GT_LOG_VERBOSE("D&C+DP", "Base case: {} nodes", partSize);
     return SolveBaseCase(nodes, edges, partition);
   }
 
-  std::cout << "[D&C+DP] Splitting partition of " << partSize << " nodes" << std::endl;
+  GT_LOG_VERBOSE("D&C+DP", "Splitting partition of {} nodes", partSize);
 
   auto [leftPartition, rightPartition] = SplitPartition(partition, nodes);
 
-  std::cout << "[D&C+DP] Left: " << leftPartition.nodeIndices.size()
-            << " nodes, Right: " << rightPartition.nodeIndices.size()
-            << " nodes" << std::endl;
+  GT_LOG_VERBOSE("D&C+DP", "Left: {} nodes, Right: {} nodes",
+                 leftPartition.nodeIndices.size(),
+                 rightPartition.nodeIndices.size());
 
   if (leftPartition.nodeIndices.empty()) {
     return SolveDP(nodes, edges, rightPartition);
@@ -314,11 +360,12 @@ CPUMove DnCDPSolver::SolvePartition(std::vector<Node> &nodes,
   CPUMove leftMove = SolveDP(nodes, edges, leftPartition);
   CPUMove rightMove = SolveDP(nodes, edges, rightPartition);
 
-  std::cout << "[D&C+DP] Left reduction: " << leftMove.intersection_reduction
-            << ", Right reduction: " << rightMove.intersection_reduction << std::endl;
+  GT_LOG_VERBOSE("D&C+DP", "Left reduction: {}, Right reduction: {}",
+                 leftMove.intersection_reduction,
+                 rightMove.intersection_reduction);
 
   if (!leftMove.isValid() && !rightMove.isValid()) {
-    std::cout << "[D&C+DP] Both partitions stuck, trying full partition DP" << std::endl;
+    GT_LOG_VERBOSE("D&C+DP", "Both partitions stuck, trying full partition DP");
     return SolveDP(nodes, edges, partition);
   }
 
@@ -334,6 +381,7 @@ CPUMove DnCDPSolver::SolvePartition(std::vector<Node> &nodes,
 void DnCDPSolver::BoundaryRefinement(std::vector<Node> &nodes,
                                       const std::vector<Edge> &edges,
                                       float splitX) {
+  GT_TRACE_SCOPE("BoundaryRefinement", "solver");
   std::vector<int> boundaryNodes;
   for (size_t i = 0; i < nodes.size(); ++i) {
     if (std::abs(nodes[i].position.x - splitX) < BOUNDARY_MARGIN) {
@@ -343,22 +391,24 @@ void DnCDPSolver::BoundaryRefinement(std::vector<Node> &nodes,
 
   if (boundaryNodes.empty()) return;
 
-  int currentCount = CountIntersections(nodes, edges);
+  int currentCount = CountCrossings(nodes, edges);
 
   for (int nodeIdx : boundaryNodes) {
     Vec2 original = nodes[nodeIdx].position;
     int bestCost = currentCount;
     Vec2 bestPos = original;
 
-    float startX = std::max(MARGIN, splitX - BOUNDARY_MARGIN);
-    float endX = std::min(WINDOW_WIDTH - MARGIN, splitX + BOUNDARY_MARGIN);
-    float step = 30.0f;
+    float startX = std::max(canvas_.minX + MARGIN, splitX - BOUNDARY_MARGIN);
+    float endX = std::min(canvas_.maxX - MARGIN, splitX + BOUNDARY_MARGIN);
+    float step = GridSpacingFor(canvas_, 30.0f);
 
     for (float x = startX; x <= endX; x += step) {
-      for (float y = MARGIN; y <= WINDOW_HEIGHT - MARGIN; y += step) {
+      for (float y = canvas_.minY + MARGIN; y <= canvas_.maxY - MARGIN;
+           y += step) {
         ++lastCandidatesEvaluated_;
+        SolverStats::Add(stats_.candidatesEvaluated);
         nodes[nodeIdx].position = Vec2(x, y);
-        int cost = CountIntersections(nodes, edges);
+        int cost = CountCrossings(nodes, edges);
         if (cost < bestCost) {
           bestCost = cost;
           bestPos = Vec2(x, y);
@@ -375,19 +425,32 @@ void DnCDPSolver::BoundaryRefinement(std::vector<Node> &nodes,
 
 CPUMove DnCDPSolver::SolveGreedyFallback(std::vector<Node> &nodes,
                                          const std::vector<Edge> &edges) {
-  std::cout << "[D&C+DP] Fallback to Greedy Solver (Local Minima Escape)..." << std::endl;
-  GreedySolver greedy;
+  GT_LOG_INFO("D&C+DP", "Fallback to Greedy Solver (Local Minima Escape)...");
+  GT_TRACE_SCOPE("Fallback", "solver");
+  ScopedPhaseTimer fallback_timer(stats_.fallbackNs);
+  GreedySolver &greedy = fallbackSolver_;
+  greedy.ResetStats();
+  greedy.SetCancelFlag(cancelFlag_);
+  greedy.SetProgressChannel(progressChannel_);
   CPUMove move = greedy.FindBestMove(nodes, edges);
   lastCandidatesEvaluated_ += greedy.GetLastCandidatesEvaluated();
+  stats_.Merge(greedy.GetStats().Snapshot());
   return move;
 }
 
 CPUMove DnCDPSolver::FindBestMove(std::vector<Node> nodes,
                                    const std::vector<Edge> &edges) {
   auto start_time = std::chrono::steady_clock::now();
+  GT_TRACE_SCOPE("DnCDP::FindBestMove", "solver");
+  ScopedPhaseTimer search_timer(stats_.searchNs);
+  ScopedSearchAllocations search_allocations(stats_);
+  SolverStats::Add(stats_.calls);
+  arena_.Reset();
+  canvas_ = SolverCanvas(nodes, MARGIN);
   lastCandidatesEvaluated_ = 0;
+  BeginProgress();
 
-  int current_intersections = CountIntersections(nodes, edges);
+  int current_intersections = CountCrossings(nodes, edges);
 
   if (current_intersections == 0 || IsCancelled()) {
     CPUMove move;
@@ -395,14 +458,30 @@ CPUMove DnCDPSolver::FindBestMove(std::vector<Node> nodes,
     return move;
   }
 
-  std::vector<int> allIndices;
+  std::pmr::vector<int> allIndices(&arena_);
+  allIndices.reserve(nodes.size());
   for (size_t i = 0; i < nodes.size(); ++i) {
     allIndices.push_back(static_cast<int>(i));
   }
 
-  Partition fullPartition = CreatePartition(allIndices, nodes);
+  // Evaluation time is the partition solve minus the generation and
+  // partitioning nested inside it
+  uint64_t generation_before =
+      stats_.generationNs.load(std::memory_order_relaxed);
+  auto solve_start = std::chrono::steady_clock::now();
+
+  Partition fullPartition = CreatePartition(std::move(allIndices), nodes);
   CPUMove best_move = SolvePartition(nodes, edges, fullPartition);
 
+  uint64_t solve_total = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - solve_start)
+          .count());
+  uint64_t generation =
+      stats_.generationNs.load(std::memory_order_relaxed) - generation_before;
+  SolverStats::Add(stats_.evaluationNs,
+                   solve_total > generation ? solve_total - generation : 0);
+
   // Fallback to Greedy if D&C+DP is stuck but intersections remain
   if ((!best_move.isValid() || best_move.intersection_reduction <= 0) && current_intersections > 0) {
     CPUMove fallbackMove = SolveGreedyFallback(nodes, edges);
@@ -420,12 +499,12 @@ CPUMove DnCDPSolver::FindBestMove(std::vector<Node> nodes,
           .count();
 
   if (best_move.isValid()) {
-    std::cout << "[D&C+DP] Found move: Node " << best_move.node_id << " -> ("
-              << best_move.to_position.x << ", " << best_move.to_position.y
-              << ") reduction=" << best_move.intersection_reduction
-              << " time=" << best_move.computation_time_ms << "ms" << std::endl;
+    GT_LOG_INFO("D&C+DP", "Found move: Node {} -> ({}, {}) reduction={} time={}ms",
+                best_move.node_id, best_move.to_position.x,
+                best_move.to_position.y, best_move.intersection_reduction,
+                best_move.computation_time_ms);
   } else {
-    std::cout << "[D&C+DP] No improving move found" << std::endl;
+    GT_LOG_INFO("D&C+DP", "No improving move found");
   }
 
   return best_move;
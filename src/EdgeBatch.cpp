@@ -0,0 +1,146 @@
+#include "EdgeBatch.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
+#include <cmath>
+
+namespace GreedyTangle {
+
+namespace {
+
+bool SameColor(const SDL_Color &a, const SDL_Color &b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+bool SamePoint(const Vec2 &a, const Vec2 &b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+} // namespace
+
+void EdgeBatch::Init(SDL_Renderer *renderer) {
+  renderer_ = renderer;
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+  geometrySupported_ = false;
+#endif
+}
+
+void EdgeBatch::WriteSlot(size_t index, const Slot &slot) {
+  SDL_Color color = colors_[slot.critical ? 1 : 0];
+  Vec2 from = camera_.WorldToScreen(slot.from);
+  Vec2 to = camera_.WorldToScreen(slot.to);
+
+  // Half the line width along the normal on each side
+  Vec2 direction = to - from;
+  float length = direction.magnitude();
+  Vec2 offset;
+  if (length > 0.0f) {
+    offset = Vec2(-direction.y, direction.x) * (0.5f * LINE_WIDTH / length);
+  }
+
+  // Bresenham lines cover pixel centers; shift onto them
+  from = from + Vec2(0.5f, 0.5f);
+  to = to + Vec2(0.5f, 0.5f);
+  Vec2 corners[4] = {from + offset, to + offset, to - offset, from - offset};
+
+  SDL_Vertex *vertex = &vertices_[index * 4];
+  for (const Vec2 &corner : corners) {
+    vertex->position = {corner.x, corner.y};
+    vertex->color = color;
+    vertex->tex_coord = {0.0f, 0.0f};
+    ++vertex;
+  }
+}
+
+void EdgeBatch::BuildGroups(const std::vector<int> &visible) {
+  groupIndices_[0].clear();
+  groupIndices_[1].clear();
+  for (int i : visible) {
+    std::vector<int> &indices = groupIndices_[slots_[i].critical ? 1 : 0];
+    int base = i * 4;
+    indices.insert(indices.end(),
+                   {base, base + 1, base + 2, base, base + 2, base + 3});
+  }
+}
+
+void EdgeBatch::Draw(const std::vector<Node> &nodes,
+                     const std::vector<Edge> &edges,
+                     const std::vector<int> &visible, const Camera &camera,
+                     SDL_Color safe, SDL_Color critical) {
+  GT_TRACE_SCOPE("EdgeBatch::Draw", "frame");
+  if (!SameColor(colors_[0], safe) || !SameColor(colors_[1], critical) ||
+      slots_.size() != edges.size() || camera_ != camera) {
+    ++version_;
+  }
+  colors_[0] = safe;
+  colors_[1] = critical;
+  camera_ = camera;
+  if (slots_.size() != edges.size()) {
+    slots_.resize(edges.size());
+    vertices_.resize(edges.size() * 4);
+  }
+
+  lastRewritten_ = 0;
+  for (int i : visible) {
+    const Vec2 &from = nodes[edges[i].u_id].position;
+    const Vec2 &to = nodes[edges[i].v_id].position;
+    Slot &slot = slots_[i];
+    if (slot.version == version_ && SamePoint(slot.from, from) &&
+        SamePoint(slot.to, to) && slot.critical == edges[i].isIntersecting) {
+      continue;
+    }
+    slot.from = from;
+    slot.to = to;
+    slot.critical = edges[i].isIntersecting;
+    slot.version = version_;
+    WriteSlot(i, slot);
+    ++lastRewritten_;
+  }
+  BuildGroups(visible);
+
+  if (!renderer_) {
+    return;
+  }
+  if (geometrySupported_) {
+    for (const std::vector<int> &indices : groupIndices_) {
+      if (indices.empty()) {
+        continue;
+      }
+      if (SDL_RenderGeometry(renderer_, nullptr, vertices_.data(),
+                             static_cast<int>(vertices_.size()),
+                             indices.data(),
+                             static_cast<int>(indices.size())) != 0) {
+        GT_LOG_WARN("Render", "SDL_RenderGeometry failed ({}), drawing edges "
+                              "with SDL_RenderDrawLine",
+                    SDL_GetError());
+        geometrySupported_ = false;
+        break;
+      }
+    }
+    if (geometrySupported_) {
+      return;
+    }
+  }
+  DrawLines(nodes, edges, visible);
+}
+
+void EdgeBatch::DrawLines(const std::vector<Node> &nodes,
+                          const std::vector<Edge> &edges,
+                          const std::vector<int> &visible) {
+  for (int group = 0; group < 2; ++group) {
+    const SDL_Color &color = colors_[group];
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    for (int i : visible) {
+      const Edge &edge = edges[i];
+      if (edge.isIntersecting != (group == 1)) {
+        continue;
+      }
+      Vec2 p1 = camera_.WorldToScreen(nodes[edge.u_id].position);
+      Vec2 p2 = camera_.WorldToScreen(nodes[edge.v_id].position);
+      SDL_RenderDrawLine(renderer_, static_cast<int>(p1.x),
+                         static_cast<int>(p1.y), static_cast<int>(p2.x),
+                         static_cast<int>(p2.y));
+    }
+  }
+}
+
+} // namespace GreedyTangle
@@ -0,0 +1,87 @@
+#include "FrameScheduler.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace GreedyTangle {
+
+void FrameScheduler::Init() {
+  Uint32 type = SDL_RegisterEvents(1);
+  if (type == static_cast<Uint32>(-1)) {
+    GT_LOG_WARN("Frame", "No SDL user events left, background results "
+                         "wait for the next timed frame");
+    return;
+  }
+  wakeEventType_ = type;
+}
+
+void FrameScheduler::MarkDirty(uint32_t reasons) {
+  dirty_.fetch_or(reasons, std::memory_order_release);
+
+  // One queued wake event is enough however many threads mark the frame
+  if (wakeEventType_ == 0 || wakePending_.exchange(true)) {
+    return;
+  }
+  SDL_Event event{};
+  event.type = wakeEventType_;
+  if (SDL_PushEvent(&event) < 0) {
+    wakePending_.store(false);
+  }
+}
+
+void FrameScheduler::WakeAt(Clock::time_point deadline) {
+  if (!hasDeadline_ || deadline < deadline_) {
+    deadline_ = deadline;
+    hasDeadline_ = true;
+  }
+}
+
+void FrameScheduler::WakeIn(float seconds) {
+  WakeAt(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<float>(seconds)));
+}
+
+void FrameScheduler::WaitForFrame() {
+  GT_TRACE_SCOPE("WaitForFrame", "frame");
+  auto now = Clock::now();
+  auto interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<float>(FRAME_INTERVAL));
+
+  if (animating_) {
+    // Fixed timestep: sleep out the rest of the tick. Render() may already
+    // have spent it waiting on vsync. Input is handled at the next tick.
+    if (now < nextTick_) {
+      std::this_thread::sleep_until(nextTick_);
+      now = Clock::now();
+    }
+    nextTick_ = std::max(nextTick_ + interval, now);
+  } else if (dirty_.load(std::memory_order_acquire) == 0) {
+    int timeoutMs = IDLE_WAKE_MS;
+    if (hasDeadline_) {
+      auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      deadline_ - now)
+                      .count();
+      timeoutMs = static_cast<int>(
+          std::clamp<int64_t>(wait, 0, IDLE_WAKE_MS));
+    }
+    // Leaves the event queued for HandleInput
+    if (timeoutMs > 0) {
+      SDL_WaitEventTimeout(nullptr, timeoutMs);
+    }
+    now = Clock::now();
+    nextTick_ = now + interval;
+  } else {
+    nextTick_ = now + interval;
+  }
+
+  wakePending_.store(false);
+  hasDeadline_ = false;
+}
+
+bool FrameScheduler::TakeRenderRequest() {
+  uint32_t reasons = dirty_.exchange(0, std::memory_order_acq_rel);
+  return reasons != 0 || animating_;
+}
+
+} // namespace GreedyTangle
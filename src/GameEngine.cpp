@@ -1,5 +1,9 @@
 #include "GameEngine.hpp"
+#include "GreedySolver.hpp"
 #include "MathUtils.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
+#include "AllocationTracker.hpp"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
@@ -12,34 +16,36 @@
 #include <stdexcept>
 #include <functional>
 #include <mutex>
+#include <thread>
 
 namespace GreedyTangle {
 
-class StreamRedirector : public std::streambuf {
-public:
-    StreamRedirector(std::ostream& stream, std::function<void(const std::string&)> callback)
-        : stream_(stream), callback_(callback), old_buf_(stream.rdbuf()) {
-        stream_.rdbuf(this);
-    }
-    ~StreamRedirector() {
-        stream_.rdbuf(old_buf_);
-    }
-protected:
-    virtual int_type overflow(int_type v) override {
-        if (v == '\n') {
-            callback_(buffer_);
-            buffer_.clear();
-        } else if (v != EOF) {
-            buffer_ += static_cast<char>(v);
-        }
-        return old_buf_->sputc(v); // Also print to terminal
-    }
-private:
-    std::ostream& stream_;
-    std::function<void(const std::string&)> callback_;
-    std::streambuf* old_buf_;
-    std::string buffer_;
-};
+namespace {
+// Compact human-readable count: 950, 12.3K, 4.5M, 1.2G
+std::string FormatCount(double value) {
+  const char *suffixes[] = {"", "K", "M", "G"};
+  int tier = 0;
+  while (value >= 1000.0 && tier < 3) {
+    value /= 1000.0;
+    ++tier;
+  }
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(tier == 0 ? 0 : 1) << value
+      << suffixes[tier];
+  return oss.str();
+}
+
+// 0.01ms, 1ms, 250ms, 1.5s ... for log-scale axis labels
+std::string FormatMs(double ms) {
+  std::ostringstream oss;
+  if (ms >= 1000.0) {
+    oss << std::setprecision(2) << ms / 1000.0 << "s";
+  } else {
+    oss << std::setprecision(2) << ms << "ms";
+  }
+  return oss.str();
+}
+} // namespace
 
 GameEngine::~GameEngine() { Cleanup(); }
 
@@ -48,6 +54,7 @@ void GameEngine::Init() {
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
     throw std::runtime_error(std::string("SDL_Init failed: ") + SDL_GetError());
   }
+  frameScheduler_.Init();
 
   window = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED,
                             SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH, WINDOW_HEIGHT,
@@ -68,11 +75,15 @@ void GameEngine::Init() {
 
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
+  nodeSprites_.Init(renderer);
+  edgeBatch_.Init(renderer);
+  densityLayer_.Init(renderer);
+  textCache_.Init(renderer);
+
   // Initialize menu bar
   menuBar = std::make_unique<MenuBar>();
   if (!menuBar->Init(renderer)) {
-    std::cerr << "[Game] MenuBar init failed, continuing without menu"
-              << std::endl;
+    GT_LOG_WARN("Game", "MenuBar init failed, continuing without menu");
     menuBar.reset();
   } else {
     SetupMenus();
@@ -80,10 +91,18 @@ void GameEngine::Init() {
 
   isRunning = true;
 
+  // One persistent executor for every background job (solver moves,
+  // heatmap, benchmarks) instead of a fresh thread per std::async call
+  threadPool_ = std::make_unique<ThreadPool>();
+  GT_LOG_INFO("Game", "Thread pool started with {} workers",
+              threadPool_->GetThreadCount());
+
   currentSolver_ = CreateSolver(static_cast<SolverMode>(currentMode));
+  currentSolver_->SetThreadPool(threadPool_.get());
+  currentSolver_->SetProgressChannel(&cpuProgress_);
   cpuReplayLogger_ = std::make_unique<ReplayLogger>();
 
-  std::cout << "[Game] Initialized successfully" << std::endl;
+  GT_LOG_INFO("Game", "Initialized successfully");
 
   // Load UI Fonts
   std::vector<std::string> fontPaths = {
@@ -100,28 +119,169 @@ void GameEngine::Init() {
     titleFont = TTF_OpenFont(path.c_str(), 64);
     if (titleFont) {
       uiFont = TTF_OpenFont(path.c_str(), 24);
-      std::cout << "[Game] Loaded UI fonts from: " << path << std::endl;
+      GT_LOG_INFO("Game", "Loaded UI fonts from: {}", path);
       break;
     }
   }
 
   if (!titleFont) {
-    std::cerr << "[Game] Failed to load UI fonts!" << std::endl;
+    GT_LOG_ERROR("Game", "Failed to load UI fonts!");
   }
 }
 
 void GameEngine::Run() {
+  GT_TRACE_THREAD_NAME("Main");
+
   while (isRunning) {
-    UpdatePhase();
-    HandleInput();
-    UpdateCPURace();   // Check CPU progress in race mode
-    UpdateAutoSolve(); // Animate auto-solve if active
-    Update();
-    Render();
+    frameScheduler_.WaitForFrame();
+
+    GT_TRACE_SCOPE("Frame", "frame");
+    {
+      GT_ALLOC_SCOPE(AllocTag::FRAME_UPDATE);
+      {
+        GT_TRACE_SCOPE("UpdatePhase", "frame");
+        UpdatePhase();
+      }
+      {
+        GT_TRACE_SCOPE("HandleInput", "frame");
+        HandleInput();
+      }
+      {
+        GT_TRACE_SCOPE("UpdateCPURace", "frame");
+        UpdateCPURace(); // Check CPU progress in race mode
+      }
+      {
+        GT_TRACE_SCOPE("UpdateAutoSolve", "frame");
+        UpdateAutoSolve(); // Animate auto-solve if active
+      }
+      {
+        GT_TRACE_SCOPE("Update", "frame");
+        Update();
+      }
+    }
+    if (frameScheduler_.TakeRenderRequest()) {
+      GT_ALLOC_SCOPE(AllocTag::FRAME_RENDER);
+      GT_TRACE_SCOPE("Render", "frame");
+      Render();
+    }
+    ScheduleNextFrame();
+    ++frameCounter_;
+  }
+}
+
+void GameEngine::InvalidateLayers() {
+  for (RetainedLayer *layer :
+       {&heatmapLegendLayer_, &algorithmPanelLayer_, &victoryLayer_,
+        &benchmarkLayer_, &scalabilityLayer_, &howItWorksLayer_}) {
+    layer->Invalidate();
+  }
+  if (menuBar) {
+    menuBar->InvalidateLayer();
+  }
+}
+
+void GameEngine::DestroyLayers() {
+  for (RetainedLayer *layer :
+       {&heatmapLegendLayer_, &algorithmPanelLayer_, &victoryLayer_,
+        &benchmarkLayer_, &scalabilityLayer_, &howItWorksLayer_}) {
+    layer->Destroy();
+  }
+}
+
+void GameEngine::ScheduleNextFrame() {
+  bool animating = false;
+
+  switch (currentPhase) {
+  case GamePhase::SHOWING_UNTANGLED:
+  case GamePhase::TANGLING:
+  case GamePhase::VICTORY_BLINK:
+  case GamePhase::COMPUTING_BENCHMARK: // Spinner
+  case GamePhase::COMPUTING_SCALABILITY:
+    animating = true;
+    break;
+
+  case GamePhase::PLAYING:
+    animating = autoSolveActive_;
+    // Collect the CPU's move and its streamed progress
+    if (cpuSolving_ && !cpuPaused_) {
+      frameScheduler_.WakeIn(JOB_POLL_INTERVAL);
+    }
+    if (heatmapEnabled_ && intersectionCount > 0) {
+      frameScheduler_.WakeAt(heatmapLastUpdate_ +
+                             std::chrono::duration_cast<
+                                 std::chrono::steady_clock::duration>(
+                                 std::chrono::duration<float>(
+                                     HEATMAP_UPDATE_INTERVAL)));
+    }
+    break;
+
+  case GamePhase::REPLAY_VIEWER:
+    animating = replayAnimating_;
+    if (replayCompleting_) {
+      frameScheduler_.WakeIn(JOB_POLL_INTERVAL);
+    }
+    if (replayPlaying_) {
+      frameScheduler_.WakeAt(replayLastStepTime_ +
+                             std::chrono::duration_cast<
+                                 std::chrono::steady_clock::duration>(
+                                 std::chrono::duration<float>(
+                                     REPLAY_STEP_INTERVAL)));
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  // The dialog's cursor blinks
+  if (showInputDialog) {
+    animating = true;
   }
+  if (heatmapFuture_.valid()) {
+    frameScheduler_.WakeIn(JOB_POLL_INTERVAL);
+  }
+  frameScheduler_.SetAnimating(animating);
+}
+
+void GameEngine::ToggleTraceCapture() {
+#if GREEDY_TANGLE_TRACING
+  if (!Tracer::IsEnabled()) {
+    Tracer::Clear();
+    Tracer::SetEnabled(true);
+    GT_LOG_INFO("Trace", "Capture started (F9 again to save)");
+    return;
+  }
+
+  Tracer::SetEnabled(false);
+  if (Tracer::WriteJSON(TRACE_OUTPUT_PATH)) {
+    GT_LOG_INFO("Trace", "Wrote {} (open in ui.perfetto.dev or chrome://tracing)",
+                TRACE_OUTPUT_PATH);
+  } else {
+    GT_LOG_ERROR("Trace", "Failed to write {}", TRACE_OUTPUT_PATH);
+  }
+#else
+  GT_LOG_INFO("Trace", "Tracing is compiled out of this build");
+#endif
 }
 
 void GameEngine::Cleanup() {
+  // Stop in-flight solver work and drain the pool while the engine state
+  // its jobs reference is still alive
+  if (threadPool_) {
+    cpuCancelFlag_.store(true);
+    replayCancelFlag_.store(true);
+    benchmarkCancelFlag_.store(true);
+    scalabilityCancelFlag_.store(true);
+    threadPool_.reset();
+  }
+  UnsubscribeComputingLogs();
+
+  // Textures go before the renderer that owns them
+  nodeSprites_.Destroy();
+  densityLayer_.Destroy();
+  textCache_.Clear();
+  DestroyLayers();
+  menuBar.reset();
   if (renderer) {
     SDL_DestroyRenderer(renderer);
     renderer = nullptr;
@@ -140,12 +300,32 @@ void GameEngine::Cleanup() {
   }
 
   SDL_Quit();
-  std::cout << "[Game] Cleanup complete" << std::endl;
+  GT_LOG_INFO("Game", "Cleanup complete");
+  Logger::Instance().Flush();
 }
 
 void GameEngine::HandleInput() {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
+    // Only there to end FrameScheduler's wait
+    if (frameScheduler_.IsWakeEvent(event)) {
+      continue;
+    }
+    frameScheduler_.MarkDirty(FrameScheduler::DIRTY_INPUT);
+
+    // Render target contents are lost with the device
+    if (event.type == SDL_RENDER_TARGETS_RESET ||
+        event.type == SDL_RENDER_DEVICE_RESET) {
+      InvalidateLayers();
+      continue;
+    }
+
+    // F9 starts/stops a trace capture from any screen
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F9) {
+      ToggleTraceCapture();
+      continue;
+    }
+
     // Let menu handle events first
     if (menuBar && menuBar->HandleEvent(event)) {
       continue;
@@ -201,9 +381,15 @@ void GameEngine::HandleInput() {
       break;
 
     case SDL_MOUSEBUTTONDOWN:
+      if (event.button.button == SDL_BUTTON_RIGHT ||
+          event.button.button == SDL_BUTTON_MIDDLE) {
+        isPanning = true;
+        break;
+      }
       if (event.button.button == SDL_BUTTON_LEFT) {
-        Vec2 clickPos(static_cast<float>(event.button.x),
-                      static_cast<float>(event.button.y));
+        Vec2 clickPos = camera_.ScreenToWorld(
+            Vec2(static_cast<float>(event.button.x),
+                 static_cast<float>(event.button.y)));
 
         // Check in-game buttons during PLAYING phase
         if (currentPhase == GamePhase::PLAYING) {
@@ -239,6 +425,10 @@ void GameEngine::HandleInput() {
       break;
 
     case SDL_MOUSEBUTTONUP:
+      if (event.button.button == SDL_BUTTON_RIGHT ||
+          event.button.button == SDL_BUTTON_MIDDLE) {
+        isPanning = false;
+      }
       if (event.button.button == SDL_BUTTON_LEFT) {
         if (selectedNodeID != -1 &&
             selectedNodeID < static_cast<int>(nodes.size())) {
@@ -253,16 +443,26 @@ void GameEngine::HandleInput() {
       break;
 
     case SDL_MOUSEMOTION:
-      mousePosition = Vec2(static_cast<float>(event.motion.x),
-                           static_cast<float>(event.motion.y));
+      if (isPanning) {
+        camera_.Pan(Vec2(static_cast<float>(event.motion.xrel),
+                         static_cast<float>(event.motion.yrel)));
+      }
+      SetMouseScreen(event.motion.x, event.motion.y);
+      break;
 
-      if (selectedNodeID != -1 &&
-          selectedNodeID < static_cast<int>(nodes.size())) {
-        nodes[selectedNodeID].position = mousePosition;
-      } else {
-        UpdateHoverState();
+    case SDL_MOUSEWHEEL: {
+      // Zoom about the cursor; a dragged node stays under it
+      int notches = event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED
+                        ? -event.wheel.y
+                        : event.wheel.y;
+      if (notches != 0) {
+        camera_.ZoomAt(mouseScreen,
+                       std::pow(ZOOM_STEP, static_cast<float>(notches)));
+        SetMouseScreen(static_cast<int>(mouseScreen.x),
+                       static_cast<int>(mouseScreen.y));
       }
       break;
+    }
 
     case SDL_KEYDOWN:
       // Handle input dialog first
@@ -278,7 +478,7 @@ void GameEngine::HandleInput() {
             int customCount = std::stoi(inputBuffer);
             showInputDialog = false;
             inputBuffer.clear();
-            SetNodeCount(customCount); // Will clamp to 3-200
+            SetNodeCount(customCount); // Will clamp to 3-MAX_NODE_COUNT
           }
           break;
         case SDLK_BACKSPACE:
@@ -306,6 +506,9 @@ void GameEngine::HandleInput() {
       case SDLK_h:
         ToggleHeatmap();
         break;
+      case SDLK_f:
+        FitCameraToGraph();
+        break;
       case SDLK_s:
         if (autoSolveActive_) {
           autoSolveActive_ = false;
@@ -320,7 +523,7 @@ void GameEngine::HandleInput() {
       // Only capture digits when dialog is open
       if (showInputDialog) {
         for (char c : std::string(event.text.text)) {
-          if (std::isdigit(c) && inputBuffer.length() < 3) {
+          if (std::isdigit(c) && inputBuffer.length() < 5) {
             inputBuffer += c;
           }
         }
@@ -330,6 +533,19 @@ void GameEngine::HandleInput() {
   }
 }
 
+void GameEngine::SetMouseScreen(int x, int y) {
+  mouseScreen = Vec2(static_cast<float>(x), static_cast<float>(y));
+  mousePosition = camera_.ScreenToWorld(mouseScreen);
+
+  if (selectedNodeID != -1 &&
+      selectedNodeID < static_cast<int>(nodes.size())) {
+    nodes[selectedNodeID].position = mousePosition;
+    sceneIndex_.MoveNode(nodes, selectedNodeID);
+  } else {
+    UpdateHoverState();
+  }
+}
+
 void GameEngine::UpdateHoverState() {
   int previousHovered = hoveredNodeID;
   hoveredNodeID = GetNodeAtPosition(mousePosition);
@@ -348,63 +564,34 @@ void GameEngine::UpdateHoverState() {
 void GameEngine::Update() {
   if (currentPhase == GamePhase::COMPUTING_BENCHMARK || currentPhase == GamePhase::COMPUTING_SCALABILITY) {
     if (backgroundTask_.valid() && backgroundTask_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-      if (logRedirector_) {
-        delete static_cast<StreamRedirector*>(logRedirector_);
-        logRedirector_ = nullptr;
-      }
+      UnsubscribeComputingLogs();
       if (currentPhase == GamePhase::COMPUTING_BENCHMARK) {
         currentPhase = GamePhase::BENCHMARK_RESULTS;
+        benchmarkLayer_.Invalidate();
       } else {
         currentPhase = GamePhase::SCALABILITY_RESULTS;
+        scalabilityLayer_.Invalidate();
       }
+      frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER);
     }
     return;
   }
 
-  for (Edge &edge : edges) {
-    edge.isIntersecting = false;
-  }
+  // Retests only the edges of nodes that moved since the last frame
+  intersectionCount = crossingTracker_.Update(nodes, edges);
 
-  size_t numEdges = edges.size();
-  intersectionCount = 0;
-
-  for (size_t i = 0; i < numEdges; ++i) {
-    for (size_t j = i + 1; j < numEdges; ++j) {
-      Edge &e1 = edges[i];
-      Edge &e2 = edges[j];
-
-      if (e1.sharesVertex(e2)) {
-        continue;
-      }
-
-      const Vec2 &a = nodes[e1.u_id].position;
-      const Vec2 &b = nodes[e1.v_id].position;
-      const Vec2 &c = nodes[e2.u_id].position;
-      const Vec2 &d = nodes[e2.v_id].position;
-
-      if (CheckIntersection(a, b, c, d)) {
-        e1.isIntersecting = true;
-        e2.isIntersecting = true;
-        ++intersectionCount;
-      }
-    }
+  // The density layer only redraws what the tracker saw change
+  if (crossingTracker_.LastRecounted()) {
+    densityLayer_.Invalidate();
+  } else {
+    densityLayer_.MarkEdges(crossingTracker_.ChangedEdges());
   }
 
   // Check for victory condition
   CheckVictory();
 
   // Periodically recalculate heatmap if enabled
-  if (heatmapEnabled_ && currentPhase == GamePhase::PLAYING &&
-      intersectionCount > 0) {
-    auto now = std::chrono::steady_clock::now();
-    float elapsed =
-        std::chrono::duration<float>(now - heatmapLastUpdate_).count();
-    if (elapsed >= HEATMAP_UPDATE_INTERVAL ||
-        nodeHeatmapScores_.size() != nodes.size()) {
-      CalculateHeatmap();
-      heatmapLastUpdate_ = now;
-    }
-  }
+  UpdateHeatmap();
 }
 
 void GameEngine::Render() {
@@ -482,13 +669,7 @@ void GameEngine::Render() {
     return;
   }
 
-  for (const Edge &edge : edges) {
-    DrawEdge(edge);
-  }
-
-  for (const Node &node : nodes) {
-    DrawNode(node);
-  }
+  RenderGraph();
 
   // Render victory screen overlay
   if (currentPhase == GamePhase::VICTORY) {
@@ -520,6 +701,70 @@ void GameEngine::Render() {
   SDL_RenderPresent(renderer);
 }
 
+void GameEngine::RenderGraph() {
+  GT_TRACE_SCOPE("RenderGraph", "frame");
+  sceneIndex_.Update(nodes, edges);
+
+  float nodePixels = nodes.empty() ? 0.0f : nodes[0].radius * camera_.Zoom();
+  if (nodePixels < LOD_NODE_PIXELS) {
+    RenderGraphDensity();
+    return;
+  }
+
+  // Only what intersects the window goes to the renderer
+  int winW, winH;
+  SDL_GetWindowSize(window, &winW, &winH);
+  sceneIndex_.Query(camera_.Viewport(winW, winH), visibleNodes_,
+                    visibleEdges_);
+
+  edgeBatch_.Draw(nodes, edges, visibleEdges_, camera_, Colors::EDGE_SAFE,
+                  Colors::EDGE_CRITICAL);
+
+  for (int id : visibleNodes_) {
+    DrawNode(nodes[id]);
+  }
+  nodeSprites_.Flush();
+}
+
+void GameEngine::RenderGraphDensity() {
+  int winW, winH;
+  SDL_GetWindowSize(window, &winW, &winH);
+  Rect viewport = camera_.Viewport(winW, winH);
+
+  if (!densityLayer_.Draw(nodes, edges, camera_, Colors::EDGE_SAFE,
+                          Colors::EDGE_CRITICAL)) {
+    sceneIndex_.Query(viewport, visibleNodes_, visibleEdges_);
+    edgeBatch_.Draw(nodes, edges, visibleEdges_, camera_, Colors::EDGE_SAFE,
+                    Colors::EDGE_CRITICAL);
+  } else {
+    sceneIndex_.QueryNodes(viewport, visibleNodes_);
+  }
+
+  // One point per node, in a single call
+  lodPoints_.clear();
+  for (int id : visibleNodes_) {
+    Vec2 point = camera_.WorldToScreen(nodes[id].position);
+    lodPoints_.push_back(
+        {static_cast<int>(point.x), static_cast<int>(point.y)});
+  }
+  SDL_SetRenderDrawColor(renderer, Colors::NODE_FILL.r, Colors::NODE_FILL.g,
+                         Colors::NODE_FILL.b, Colors::NODE_FILL.a);
+  SDL_RenderDrawPoints(renderer, lodPoints_.data(),
+                       static_cast<int>(lodPoints_.size()));
+
+  // The node being dragged or hovered stays findable
+  int lodRadius = static_cast<int>(LOD_NODE_PIXELS);
+  for (int id : {hoveredNodeID, selectedNodeID}) {
+    if (id < 0 || id >= static_cast<int>(nodes.size())) {
+      continue;
+    }
+    Vec2 center = camera_.WorldToScreen(nodes[id].position);
+    DrawNodeShape(static_cast<int>(center.x), static_cast<int>(center.y),
+                  lodRadius, Colors::NODE_DRAGGING, Colors::NODE_BORDER);
+  }
+  nodeSprites_.Flush();
+}
+
 void GameEngine::DrawFilledCircle(int cx, int cy, int radius) {
   for (int y = -radius; y <= radius; ++y) {
     int halfWidth = static_cast<int>(std::sqrt(radius * radius - y * y));
@@ -529,9 +774,10 @@ void GameEngine::DrawFilledCircle(int cx, int cy, int radius) {
 }
 
 void GameEngine::DrawNode(const Node &node) {
-  int cx = static_cast<int>(node.position.x);
-  int cy = static_cast<int>(node.position.y);
-  int r = static_cast<int>(node.radius);
+  Vec2 center = camera_.WorldToScreen(node.position);
+  int cx = static_cast<int>(center.x);
+  int cy = static_cast<int>(center.y);
+  int r = std::max(1, static_cast<int>(node.radius * camera_.Zoom()));
 
   SDL_Color fillColor;
   if (node.isDragging) {
@@ -546,17 +792,28 @@ void GameEngine::DrawNode(const Node &node) {
     fillColor = Colors::NODE_FILL;
   }
 
-  SDL_SetRenderDrawColor(renderer, fillColor.r, fillColor.g, fillColor.b,
-                         fillColor.a);
-  DrawFilledCircle(cx, cy, r);
-
   SDL_Color borderColor = (node.isDragging || node.isHovered)
                               ? SDL_Color{255, 255, 255, 255}
                               : Colors::NODE_BORDER;
 
-  SDL_SetRenderDrawColor(renderer, borderColor.r, borderColor.g, borderColor.b,
-                         borderColor.a);
+  DrawNodeShape(cx, cy, r, fillColor, borderColor);
+}
 
+void GameEngine::DrawNodeShape(int cx, int cy, int radius, SDL_Color fill,
+                               SDL_Color border) {
+  if (nodeSprites_.Add(cx, cy, radius, fill, border)) {
+    return;
+  }
+
+  // Keep the stacking order of the nodes already queued
+  nodeSprites_.Flush();
+  SDL_SetRenderDrawColor(renderer, fill.r, fill.g, fill.b, fill.a);
+  DrawFilledCircle(cx, cy, radius);
+  SDL_SetRenderDrawColor(renderer, border.r, border.g, border.b, border.a);
+  DrawCircleOutline(cx, cy, radius);
+}
+
+void GameEngine::DrawCircleOutline(int cx, int cy, int r) {
   int x = r, y = 0;
   int radiusError = 1 - x;
   while (x >= y) {
@@ -579,25 +836,13 @@ void GameEngine::DrawNode(const Node &node) {
   }
 }
 
-void GameEngine::DrawEdge(const Edge &edge) {
-  const Vec2 &p1 = nodes[edge.u_id].position;
-  const Vec2 &p2 = nodes[edge.v_id].position;
-
-  SDL_Color color =
-      edge.isIntersecting ? Colors::EDGE_CRITICAL : Colors::EDGE_SAFE;
-
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-  SDL_RenderDrawLine(renderer, static_cast<int>(p1.x), static_cast<int>(p1.y),
-                     static_cast<int>(p2.x), static_cast<int>(p2.y));
-}
-
 int GameEngine::GetNodeAtPosition(const Vec2 &pos) {
-  for (int i = static_cast<int>(nodes.size()) - 1; i >= 0; --i) {
-    if (nodes[i].containsPoint(pos)) {
-      return nodes[i].id;
-    }
+  // Only a new graph needs the full pass; moves are filed as they happen
+  if (!sceneIndex_.Tracks(nodes)) {
+    sceneIndex_.Update(nodes, edges);
   }
-  return -1;
+  int index = sceneIndex_.NodeAt(nodes, pos);
+  return index == -1 ? -1 : nodes[index].id;
 }
 
 void GameEngine::AddNode(const Vec2 &position) {
@@ -609,11 +854,10 @@ void GameEngine::AddEdge(int u_id, int v_id) {
   if (u_id >= 0 && u_id < static_cast<int>(nodes.size()) && v_id >= 0 &&
       v_id < static_cast<int>(nodes.size()) && u_id != v_id) {
 
-    for (const Edge &e : edges) {
-      if ((e.u_id == u_id && e.v_id == v_id) ||
-          (e.u_id == v_id && e.v_id == u_id)) {
-        return;
-      }
+    // Adjacency mirrors the edge list, and is far shorter on large graphs
+    const std::vector<int> &adjacent = nodes[u_id].adjacencyList;
+    if (std::find(adjacent.begin(), adjacent.end(), v_id) != adjacent.end()) {
+      return;
     }
 
     edges.emplace_back(u_id, v_id);
@@ -623,23 +867,28 @@ void GameEngine::AddEdge(int u_id, int v_id) {
 }
 
 void GameEngine::ClearGraph() {
+  // The completion job solves the graph about to go; finish with it
+  // before its moves could land in the next game's CPU state
+  StopReplayCompletion();
   selectedNodeID = -1;
   hoveredNodeID = -1;
   intersectionCount = 0;
   nodes.clear();
   edges.clear();
+  sceneIndex_.Invalidate();
 }
 
 void GameEngine::GenerateRandomGraph(int nodeCount) {
   if (nodeCount < 3)
     nodeCount = 3;
+  SetWorldForNodeCount(nodeCount);
 
   std::random_device rd;
   std::mt19937 gen(rd());
 
   const float margin = 60.0f;
-  std::uniform_real_distribution<float> xDist(margin, WINDOW_WIDTH - margin);
-  std::uniform_real_distribution<float> yDist(margin, WINDOW_HEIGHT - margin);
+  std::uniform_real_distribution<float> xDist(margin, world_.Width() - margin);
+  std::uniform_real_distribution<float> yDist(margin, world_.Height() - margin);
 
   for (int i = 0; i < nodeCount; ++i) {
     Vec2 pos(xDist(gen), yDist(gen));
@@ -669,13 +918,15 @@ void GameEngine::GenerateRandomGraph(int nodeCount) {
     ++attempts;
   }
 
-  std::cout << "[Game] Generated random graph: " << nodes.size()
-            << " nodes, " << edges.size() << " edges" << std::endl;
+  FitCameraToGraph();
+  GT_LOG_INFO("Game", "Generated random graph: {} nodes, {} edges",
+              nodes.size(), edges.size());
 }
 
 void GameEngine::GenerateTestGraph() {
-  float centerX = WINDOW_WIDTH / 2.0f;
-  float centerY = WINDOW_HEIGHT / 2.0f;
+  SetWorldForNodeCount(6);
+  float centerX = world_.Width() / 2.0f;
+  float centerY = world_.Height() / 2.0f;
   float spread = 150.0f;
 
   AddNode(Vec2(centerX - spread, centerY - spread * 0.5f));
@@ -695,15 +946,17 @@ void GameEngine::GenerateTestGraph() {
   AddEdge(4, 2);
   AddEdge(4, 3);
 
-  std::cout << "[Game] Generated test graph: " << nodes.size()
-            << " nodes, " << edges.size() << " edges" << std::endl;
+  FitCameraToGraph();
+  GT_LOG_INFO("Game", "Generated test graph: {} nodes, {} edges",
+              nodes.size(), edges.size());
 }
 
 void GameEngine::GenerateDynamicGraph(int nodeCount) {
   if (nodeCount < 3)
     nodeCount = 3;
-  if (nodeCount > 200)
-    nodeCount = 200;
+  if (nodeCount > MAX_NODE_COUNT)
+    nodeCount = MAX_NODE_COUNT;
+  SetWorldForNodeCount(nodeCount);
 
   // Dispatch to difficulty-specific generator
   switch (currentDifficulty) {
@@ -717,6 +970,29 @@ void GameEngine::GenerateDynamicGraph(int nodeCount) {
     GenerateHardGraph(nodeCount);
     break;
   }
+  FitCameraToGraph();
+}
+
+void GameEngine::SetWorldForNodeCount(int nodeCount) {
+  // Area grows with the node count, so side lengths grow with its root
+  float scale = std::sqrt(std::max(
+      1.0f, static_cast<float>(nodeCount) / NODES_PER_DEFAULT_CANVAS));
+  world_ = Rect(0.0f, 0.0f, DEFAULT_CANVAS.Width() * scale,
+                DEFAULT_CANVAS.Height() * scale);
+}
+
+void GameEngine::FitCameraToGraph() {
+  int winW = WINDOW_WIDTH, winH = WINDOW_HEIGHT;
+  if (window) {
+    SDL_GetWindowSize(window, &winW, &winH);
+  }
+  Rect area = world_;
+  if (!nodes.empty()) {
+    area = area.United(GraphBounds(nodes));
+  }
+  camera_.Fit(area, winW, winH);
+  SetMouseScreen(static_cast<int>(mouseScreen.x),
+                 static_cast<int>(mouseScreen.y));
 }
 
 void GameEngine::GenerateEasyGraph(int nodeCount) {
@@ -794,9 +1070,8 @@ void GameEngine::GenerateEasyGraph(int nodeCount) {
   currentPhase = GamePhase::SHOWING_UNTANGLED;
   phaseStartTime = std::chrono::steady_clock::now();
 
-  std::cout << "[Game] Easy graph: " << nodes.size() << " nodes, "
-            << edges.size() << " edges (cycle + " << added << " chords)"
-            << std::endl;
+  GT_LOG_INFO("Game", "Easy graph: {} nodes, {} edges (cycle + {} chords)",
+              nodes.size(), edges.size(), added);
 }
 
 void GameEngine::GenerateMediumGraph(int nodeCount) {
@@ -808,10 +1083,10 @@ void GameEngine::GenerateMediumGraph(int nodeCount) {
   int rows = (nodeCount + cols - 1) / cols;
 
   // Calculate grid spacing to center it on screen
-  float centerX = WINDOW_WIDTH / 2.0f;
-  float centerY = WINDOW_HEIGHT / 2.0f;
-  float spacing =
-      std::min(WINDOW_WIDTH, WINDOW_HEIGHT) / (std::max(rows, cols) + 1.0f);
+  float centerX = world_.Width() / 2.0f;
+  float centerY = world_.Height() / 2.0f;
+  float spacing = std::min(world_.Width(), world_.Height()) /
+                  (std::max(rows, cols) + 1.0f);
   float startX = centerX - (cols - 1) * spacing / 2.0f;
   float startY = centerY - (rows - 1) * spacing / 2.0f;
 
@@ -887,8 +1162,8 @@ void GameEngine::GenerateMediumGraph(int nodeCount) {
   currentPhase = GamePhase::SHOWING_UNTANGLED;
   phaseStartTime = std::chrono::steady_clock::now();
 
-  std::cout << "[Game] Medium graph: " << nodes.size() << " nodes, "
-            << edges.size() << " edges (grid mesh)" << std::endl;
+  GT_LOG_INFO("Game", "Medium graph: {} nodes, {} edges (grid mesh)",
+              nodes.size(), edges.size());
 }
 
 void GameEngine::GenerateHardGraph(int nodeCount) {
@@ -900,9 +1175,9 @@ void GameEngine::GenerateHardGraph(int nodeCount) {
   if (nodeCount < 3)
     nodeCount = 3;
 
-  float centerX = WINDOW_WIDTH / 2.0f;
-  float centerY = WINDOW_HEIGHT / 2.0f;
-  float radius = std::min(WINDOW_WIDTH, WINDOW_HEIGHT) / 2.8f;
+  float centerX = world_.Width() / 2.0f;
+  float centerY = world_.Height() / 2.0f;
+  float radius = std::min(world_.Width(), world_.Height()) / 2.8f;
 
   // Start with initial triangle - place at outer vertices
   Vec2 p0(centerX, centerY - radius);                          // Top
@@ -971,8 +1246,8 @@ void GameEngine::GenerateHardGraph(int nodeCount) {
   currentPhase = GamePhase::SHOWING_UNTANGLED;
   phaseStartTime = std::chrono::steady_clock::now();
 
-  std::cout << "[Game] Hard graph: " << nodes.size() << " nodes, "
-            << edges.size() << " edges (triangulation)" << std::endl;
+  GT_LOG_INFO("Game", "Hard graph: {} nodes, {} edges (triangulation)",
+              nodes.size(), edges.size());
 }
 
 void GameEngine::ApplyCircleScramble() {
@@ -990,9 +1265,9 @@ void GameEngine::ApplyCircleScramble() {
   std::shuffle(order.begin(), order.end(), gen);
 
   // Generate random target positions on a circle
-  float centerX = WINDOW_WIDTH / 2.0f;
-  float centerY = WINDOW_HEIGHT / 2.0f;
-  float radius = std::min(WINDOW_WIDTH, WINDOW_HEIGHT) / 2.5f;
+  float centerX = world_.Width() / 2.0f;
+  float centerY = world_.Height() / 2.0f;
+  float radius = std::min(world_.Width(), world_.Height()) / 2.5f;
 
   size_t n = nodes.size();
   targetPositions.resize(n);
@@ -1019,9 +1294,9 @@ void GameEngine::ApplyCircleScramble() {
 
 void GameEngine::GeneratePlanarLayout() {
   // Arrange nodes in a circle for guaranteed planar layout
-  float centerX = WINDOW_WIDTH / 2.0f;
-  float centerY = WINDOW_HEIGHT / 2.0f;
-  float radius = std::min(WINDOW_WIDTH, WINDOW_HEIGHT) / 2.5f;
+  float centerX = world_.Width() / 2.0f;
+  float centerY = world_.Height() / 2.0f;
+  float radius = std::min(world_.Width(), world_.Height()) / 2.5f;
 
   size_t n = nodes.size();
   for (size_t i = 0; i < n; ++i) {
@@ -1038,8 +1313,8 @@ void GameEngine::GenerateTangledTargets() {
   std::mt19937 gen(rd());
 
   const float margin = 80.0f;
-  std::uniform_real_distribution<float> xDist(margin, WINDOW_WIDTH - margin);
-  std::uniform_real_distribution<float> yDist(margin, WINDOW_HEIGHT - margin);
+  std::uniform_real_distribution<float> xDist(margin, world_.Width() - margin);
+  std::uniform_real_distribution<float> yDist(margin, world_.Height() - margin);
 
   startPositions.clear();
   targetPositions.clear();
@@ -1059,6 +1334,11 @@ void GameEngine::UpdatePhase() {
   auto now = std::chrono::steady_clock::now();
   float elapsed = std::chrono::duration<float>(now - phaseStartTime).count();
 
+  // Any way out of the viewer (menu, benchmark, new game) ends the job
+  if (replayCompleting_ && currentPhase != GamePhase::REPLAY_VIEWER) {
+    StopReplayCompletion();
+  }
+
   switch (currentPhase) {
   case GamePhase::MAIN_MENU:
     return;
@@ -1069,7 +1349,7 @@ void GameEngine::UpdatePhase() {
       currentPhase = GamePhase::TANGLING;
       phaseStartTime = now;
       animationProgress = 0.0f;
-      std::cout << "[Game] Starting tangle animation..." << std::endl;
+      GT_LOG_INFO("Game", "Starting tangle animation...");
     }
     break;
 
@@ -1084,8 +1364,7 @@ void GameEngine::UpdatePhase() {
       // Start CPU race mode
       StartCPURace();
 
-      std::cout << "[Game] Race started! Untangle the graph."
-                << std::endl;
+      GT_LOG_INFO("Game", "Race started! Untangle the graph.");
     }
 
     // Interpolate node positions with easing
@@ -1097,6 +1376,7 @@ void GameEngine::UpdatePhase() {
         nodes[i].position.y = startPositions[i].y +
                               t * (targetPositions[i].y - startPositions[i].y);
       }
+      sceneIndex_.Update(nodes, edges);
     }
     break;
 
@@ -1113,7 +1393,7 @@ void GameEngine::UpdatePhase() {
       if (currentBlink >= TOTAL_BLINKS * 2) {
         // Blinks complete, show victory screen
         currentPhase = GamePhase::VICTORY;
-        std::cout << "[Game] Victory! Showing analytics." << std::endl;
+        GT_LOG_INFO("Game", "Victory! Showing analytics.");
       }
     }
     break;
@@ -1127,6 +1407,8 @@ void GameEngine::UpdatePhase() {
     break;
 
   case GamePhase::REPLAY_VIEWER:
+    DrainReplayMoves();
+
     // Update replay animation
     if (replayAnimating_) {
       auto now = std::chrono::steady_clock::now();
@@ -1164,9 +1446,9 @@ void GameEngine::UpdatePhase() {
         ReplayGoToStep(replayCurrentStep_ + 1);
         replayLastStepTime_ = now;
       }
-    } else if (replayPlaying_ && cpuReplayLogger_ &&
+    } else if (replayPlaying_ && !replayCompleting_ && cpuReplayLogger_ &&
                replayCurrentStep_ >= cpuReplayLogger_->GetTotalMoves()) {
-      replayPlaying_ = false; // Stop at end
+      replayPlaying_ = false; // Stop at end (keep waiting while still solving)
     }
     break;
 
@@ -1222,7 +1504,7 @@ void GameEngine::SetupMenus() {
           currentMode == GameMode::BACKTRACKING)};
   menuBar->AddMenu("Mode", modeMenu);
 
-  // Settings menu - Node counts: 10, 15, 20, Custom (max 200)
+  // Settings menu - Node counts: 10, 15, 20, Custom (max MAX_NODE_COUNT)
   std::vector<MenuItem> settingsMenu = {
       MenuItem(
           "10 Nodes", [this]() { SetNodeCount(10); }, true,
@@ -1268,11 +1550,11 @@ void GameEngine::SetupMenus() {
 void GameEngine::StartNewGame() { GenerateDynamicGraph(currentNodeCount); }
 
 void GameEngine::SetNodeCount(int count) {
-  // Clamp to valid range (3-200)
+  // Clamp to valid range (3-MAX_NODE_COUNT)
   if (count < 3)
     count = 3;
-  if (count > 200)
-    count = 200;
+  if (count > MAX_NODE_COUNT)
+    count = MAX_NODE_COUNT;
   currentNodeCount = count;
 
   // Menu layout: 0: 10 Nodes, 1: 15 Nodes, 2: 20 Nodes, 3: Custom...
@@ -1309,7 +1591,7 @@ void GameEngine::SetDifficulty(Difficulty diff) {
 void GameEngine::SetGameMode(GameMode mode) {
   // Wait for any pending CPU task to finish before destroying the solver
   if (cpuSolving_ && cpuFuture_.valid()) {
-    std::cout << "[Game] Waiting for pending CPU move to finish before switching mode..." << std::endl;
+    GT_LOG_INFO("Game", "Waiting for pending CPU move to finish before switching mode...");
     cpuFuture_.wait();
     cpuSolving_ = false;
   }
@@ -1317,6 +1599,8 @@ void GameEngine::SetGameMode(GameMode mode) {
   currentMode = mode;
 
   currentSolver_ = CreateSolver(static_cast<SolverMode>(mode));
+  currentSolver_->SetThreadPool(threadPool_.get());
+  currentSolver_->SetProgressChannel(&cpuProgress_);
 
   if (menuBar) {
     menuBar->SetItemChecked(1, 0, mode == GameMode::GREEDY);
@@ -1346,16 +1630,16 @@ void GameEngine::CheckVictory() {
     if (cpuFinished_ && cpuGameDuration_ > 0.0f) {
       if (gameDuration < cpuGameDuration_) {
         winner_ = "human";
-        std::cout << "[Game] YOU WIN! " << gameDuration << "s vs CPU "
-                  << cpuGameDuration_ << "s" << std::endl;
+        GT_LOG_INFO("Game", "YOU WIN! {}s vs CPU {}s", gameDuration,
+                    cpuGameDuration_);
       } else {
         winner_ = "cpu";
-        std::cout << "[Game] CPU WINS! " << cpuGameDuration_ << "s vs YOU "
-                  << gameDuration << "s" << std::endl;
+        GT_LOG_INFO("Game", "CPU WINS! {}s vs YOU {}s", cpuGameDuration_,
+                    gameDuration);
       }
     } else {
       winner_ = "human";
-      std::cout << "[Game] YOU WIN! CPU didn't finish." << std::endl;
+      GT_LOG_INFO("Game", "YOU WIN! CPU didn't finish.");
     }
 
     // Start victory blink animation
@@ -1363,13 +1647,12 @@ void GameEngine::CheckVictory() {
     blinkCount = 0;
     currentPhase = GamePhase::VICTORY_BLINK;
 
-    std::cout << "[Game] Congratulations! Graph untangled in "
-              << gameDuration << "s with " << moveCount << " moves!"
-              << std::endl;
+    GT_LOG_INFO("Game", "Congratulations! Graph untangled in {}s with {} moves!",
+                gameDuration, moveCount);
   }
 }
 
-void GameEngine::RenderVictoryScreen() {
+void GameEngine::PaintVictoryScreen() {
   // Semi-transparent dark overlay
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
@@ -1478,6 +1761,16 @@ void GameEngine::RenderVictoryScreen() {
     menuBar->RenderTextCentered("Game > New Game to play again", hintBox,
                                 {180, 180, 185, 255});
   }
+}
+
+void GameEngine::RenderVictoryScreen() {
+  SDL_Rect bounds = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+  RetainedLayer::Key key;
+  key.Add(std::string_view(winner_)).Add(gameDuration).Add(cpuGameDuration_);
+  key.Add(moveCount).Add(cpuMoveCount_).Add(menuBar != nullptr);
+  key.Add(static_cast<uint64_t>(nodes.size()))
+      .Add(static_cast<uint64_t>(edges.size()));
+  victoryLayer_.Draw(renderer, bounds, key, [&] { PaintVictoryScreen(); });
 
   // Print analytics to console (visible confirmation)
   static bool printed = false;
@@ -1526,8 +1819,9 @@ void GameEngine::RenderInputDialog() {
   // Title
   SDL_Rect titleRect = {panelX + 10, panelY + 15, panelW - 20, 25};
   if (menuBar) {
-    menuBar->RenderTextCentered("Enter Node Count (3-200)", titleRect,
-                                {200, 200, 210, 255});
+    menuBar->RenderTextCentered("Enter Node Count (3-" +
+                                    std::to_string(MAX_NODE_COUNT) + ")",
+                                titleRect, {200, 200, 210, 255});
   }
 
   // Input field
@@ -1583,8 +1877,8 @@ void GameEngine::StartCPURace() {
   // Initialize replay logger with initial state
   cpuReplayLogger_->StartMatch(cpuNodes_, edges, cpuIntersectionCount_);
 
-  std::cout << "[Game] Starting race mode! H: " << intersectionCount
-            << " | CPU: " << cpuIntersectionCount_ << std::endl;
+  GT_LOG_INFO("Game", "Starting race mode! H: {} | CPU: {}", intersectionCount,
+              cpuIntersectionCount_);
 
   // Note: Don't call StartNextCPUMove() immediately - let the delay timer work
   // The UpdateCPURace() loop will trigger it after the delay
@@ -1605,9 +1899,8 @@ void GameEngine::StartNextCPUMove() {
           std::chrono::duration<float>(now - gameStartTime).count();
 
       if (winner_.empty()) {
-        std::cout << "[Game] CPU finished in " << cpuMoveCount_ << " moves (" 
-                  << std::fixed << std::setprecision(2) << cpuGameDuration_ << "s)."
-                  << std::endl;
+        GT_LOG_INFO("Game", "CPU finished in {} moves ({:.2f}s).", cpuMoveCount_,
+                    cpuGameDuration_);
       }
     }
     return;
@@ -1624,19 +1917,115 @@ void GameEngine::StartNextCPUMove() {
     }
   }
 
+  currentSolver_->SetCancelFlag(&cpuCancelFlag_);
+  LaunchCPUSearch();
+}
+
+void GameEngine::LaunchCPUSearch() {
   cpuSolving_ = true;
   cpuCancelFlag_.store(false);
-  currentSolver_->SetCancelFlag(&cpuCancelFlag_);
+
+  // Anything left in the channel belongs to a search that already returned
+  cpuProgress_.Clear();
+  cpuLiveBest_ = CPUMove();
+  cpuLiveEvaluated_ = 0;
+  cpuCommitEarly_ = false;
+  cpuSearchStartTime_ = std::chrono::steady_clock::now();
 
   // Deep copy for thread safety
   auto nodes_copy = cpuNodes_;
   auto edges_copy = edges;
 
-  cpuFuture_ = std::async(std::launch::async, [this, nodes_copy, edges_copy]() {
+  cpuFuture_ = threadPool_->Submit([this, nodes_copy, edges_copy]() {
+    GT_TRACE_SCOPE("CPUMoveSearch", "job");
     return currentSolver_->FindBestMove(nodes_copy, edges_copy);
   });
 }
 
+void GameEngine::SampleSolverThroughput() {
+  if (!currentSolver_) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  float elapsed =
+      std::chrono::duration<float>(now - cpuStatsSampleTime_).count();
+  if (elapsed < STATS_SAMPLE_INTERVAL) {
+    return;
+  }
+
+  SolverStatsSnapshot sample = currentSolver_->GetStats().Snapshot();
+  if (cpuSolving_) {
+    frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER); // Panel rates
+  }
+  // Counters only grow unless the solver was swapped or reset
+  if (sample.candidatesEvaluated >= cpuStatsSample_.candidatesEvaluated &&
+      sample.pairTests >= cpuStatsSample_.pairTests) {
+    SolverStatsSnapshot delta = sample - cpuStatsSample_;
+    cpuEvalRate_ = delta.candidatesEvaluated / elapsed;
+    cpuPairRate_ = delta.pairTests / elapsed;
+  }
+  cpuStatsSample_ = sample;
+  cpuStatsSampleTime_ = now;
+}
+
+void GameEngine::SampleFrameAllocations() {
+  if (!AllocationTracker::IsEnabled()) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  float elapsed = std::chrono::duration<float>(now - allocSampleTime_).count();
+  if (elapsed < STATS_SAMPLE_INTERVAL || frameCounter_ == allocSampleFrame_) {
+    return;
+  }
+
+  AllocCounters update = AllocationTracker::TagTotals(AllocTag::FRAME_UPDATE);
+  AllocCounters render = AllocationTracker::TagTotals(AllocTag::FRAME_RENDER);
+  double frames = static_cast<double>(frameCounter_ - allocSampleFrame_);
+  updateAllocsPerFrame_ =
+      (update - updateAllocSample_).allocations / frames;
+  renderAllocsPerFrame_ =
+      (render - renderAllocSample_).allocations / frames;
+  updateAllocSample_ = update;
+  renderAllocSample_ = render;
+  allocSampleFrame_ = frameCounter_;
+  allocSampleTime_ = now;
+}
+
+void GameEngine::DrainCPUProgress() {
+  SolverProgress progress;
+  while (cpuProgress_.TryPop(progress)) {
+    frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER);
+    if (progress.kind == SolverProgress::Kind::IMPROVED_MOVE) {
+      if (progress.move.intersection_reduction >
+          cpuLiveBest_.intersection_reduction) {
+        cpuLiveBest_ = progress.move;
+      }
+    } else {
+      cpuLiveEvaluated_ = std::max(cpuLiveEvaluated_,
+                                   progress.candidatesEvaluated);
+    }
+  }
+
+  if (!cpuSolving_ || cpuCommitEarly_ || !cpuLiveBest_.isValid()) {
+    return;
+  }
+
+  // Past the deadline with an improving move in hand: stop the search and
+  // take what we have rather than letting the race stall
+  float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() -
+                                               cpuSearchStartTime_)
+                      .count();
+  if (elapsed >= CPU_COMMIT_DEADLINE &&
+      cpuLiveBest_.intersection_reduction > 0) {
+    cpuCommitEarly_ = true;
+    cpuCancelFlag_.store(true);
+    GT_LOG_INFO("CPU", "Deadline reached, committing best-so-far move (-{})",
+                cpuLiveBest_.intersection_reduction);
+  }
+}
+
 float GameEngine::GetCPUDelay() const {
   switch (currentDifficulty) {
   case Difficulty::EASY:
@@ -1677,17 +2066,18 @@ void GameEngine::UpdateCPURace() {
       if (cpuFinished_) {
           if (cpuGameDuration_ < gameDuration) {
               winner_ = "cpu";
-              std::cout << "[Game] CPU WINS! Time: " << cpuGameDuration_ << "s vs " << gameDuration << "s" << std::endl;
+              GT_LOG_INFO("Game", "CPU WINS! Time: {}s vs {}s", cpuGameDuration_, gameDuration);
           } else {
               winner_ = "human";
-              std::cout << "[Game] YOU WIN! Time: " << gameDuration << "s vs " << cpuGameDuration_ << "s" << std::endl;
+              GT_LOG_INFO("Game", "YOU WIN! Time: {}s vs {}s", gameDuration, cpuGameDuration_);
           }
       } else {
           winner_ = "human";
-           std::cout << "[Game] YOU WIN! CPU didn't finish." << std::endl;
+           GT_LOG_INFO("Game", "YOU WIN! CPU didn't finish.");
       }
       
       // Trigger Victory Animation
+      frameScheduler_.MarkDirty(FrameScheduler::DIRTY_STATE);
       victoryStartTime = now;
       blinkCount = 0;
       currentPhase = GamePhase::VICTORY_BLINK;
@@ -1697,12 +2087,34 @@ void GameEngine::UpdateCPURace() {
 
   // === CPU Background Solving (runs as fast as possible) ===
 
+  // Pick up streamed best-so-far results from the running search
+  DrainCPUProgress();
+  SampleSolverThroughput();
+  SampleFrameAllocations();
+
   // Check if CPU move computation completed
   if (cpuSolving_ && cpuFuture_.valid()) {
     if (cpuFuture_.wait_for(std::chrono::milliseconds(0)) ==
         std::future_status::ready) {
       CPUMove move = cpuFuture_.get();
       cpuSolving_ = false;
+      frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER);
+
+      // A search stopped at the deadline may return nothing; fall back to
+      // the best move it streamed before cancelling
+      if (cpuCommitEarly_) {
+        DrainCPUProgress();
+        if (!move.isValid() || move.intersection_reduction <
+                                   cpuLiveBest_.intersection_reduction) {
+          move = cpuLiveBest_;
+          move.computation_time_ms =
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - cpuSearchStartTime_)
+                  .count();
+        }
+        cpuCommitEarly_ = false;
+        cpuCancelFlag_.store(false);
+      }
 
       if (move.isValid()) {
         // Apply the move to CPU's graph
@@ -1718,20 +2130,18 @@ void GameEngine::UpdateCPURace() {
         // Log the move
         cpuReplayLogger_->RecordMove(move);
 
-        std::cout << "[CPU] Move #" << cpuMoveCount_ << ": Node "
-                  << move.node_id
-                  << " | Intersections: " << cpuIntersectionCount_ << std::endl;
+        GT_LOG_INFO("CPU", "Move #{}: Node {} | Intersections: {}",
+                    cpuMoveCount_, move.node_id, cpuIntersectionCount_);
 
         // Check if CPU finished
         if (cpuIntersectionCount_ == 0) {
           cpuFinished_ = true;
-          std::cout << "[CPU] Solved in " << cpuMoveCount_ << " moves!"
-                    << std::endl;
+          GT_LOG_INFO("CPU", "Solved in {} moves!", cpuMoveCount_);
 
           // CPU finished - just mark it and log
           if (intersectionCount > 0 && winner_.empty()) {
              // Do not declare winner yet - let user play until they finish
-             std::cout << "[Game] CPU finished! Keep going to beat the time!" << std::endl;
+             GT_LOG_INFO("Game", "CPU finished! Keep going to beat the time!");
           }
         }
       } else {
@@ -1785,8 +2195,9 @@ void GameEngine::UpdateCPURace() {
                 // Add small random offset to avoid exact overlap
                 centroid.x += static_cast<float>((cpuStuckCount_ * 37) % 30 - 15);
                 centroid.y += static_cast<float>((cpuStuckCount_ * 53) % 30 - 15);
-                centroid.x = std::max(60.0f, std::min(964.0f, centroid.x));
-                centroid.y = std::max(60.0f, std::min(708.0f, centroid.y));
+                centroid = SolverCanvas(cpuNodes_, PERTURB_MARGIN)
+                               .Expanded(-PERTURB_MARGIN)
+                               .Clamp(centroid);
 
                 perturbMove.to_position = centroid;
                 cpuNodes_[idx].position = centroid;
@@ -1797,10 +2208,8 @@ void GameEngine::UpdateCPURace() {
                 ++cpuMoveCount_;
                 cpuReplayLogger_->RecordMove(perturbMove);
 
-                std::cout << "[CPU] Perturbation #" << cpuStuckCount_
-                          << ": Node " << idx
-                          << " -> centroid | Intersections: "
-                          << cpuIntersectionCount_ << std::endl;
+                GT_LOG_INFO("CPU", "Perturbation #{}: Node {} -> centroid | Intersections: {}",
+                            cpuStuckCount_, idx, cpuIntersectionCount_);
 
                 if (cpuIntersectionCount_ == 0) {
                   cpuFinished_ = true;
@@ -1810,9 +2219,8 @@ void GameEngine::UpdateCPURace() {
           }
         } else {
           cpuFinished_ = true;
-          std::cout << "[CPU] Stuck after " << cpuStuckCount_
-                    << " perturbations at " << cpuIntersectionCount_
-                    << " intersections" << std::endl;
+          GT_LOG_INFO("CPU", "Stuck after {} perturbations at {} intersections",
+                      cpuStuckCount_, cpuIntersectionCount_);
         }
       }
     }
@@ -1820,14 +2228,7 @@ void GameEngine::UpdateCPURace() {
 
   // Start next CPU move if not done
   if (!cpuSolving_ && !cpuFinished_) {
-    cpuSolving_ = true;
-    auto nodes_copy = cpuNodes_;
-    auto edges_copy = edges;
-
-    cpuFuture_ =
-        std::async(std::launch::async, [this, nodes_copy, edges_copy]() {
-          return currentSolver_->FindBestMove(nodes_copy, edges_copy);
-        });
+    LaunchCPUSearch();
   }
 }
 
@@ -1871,6 +2272,15 @@ void GameEngine::RenderScoreboard() {
                   " moves)"
             : solverName + ": " + std::to_string(cpuIntersectionCount_) +
                   " left";
+    // Live search state streamed from the solver while it is thinking
+    if (!cpuFinished_ && cpuSolving_ && cpuLiveEvaluated_ > 0) {
+      cpuStatus += " (" + std::to_string(cpuLiveEvaluated_) + " evals";
+      if (cpuLiveBest_.isValid()) {
+        cpuStatus +=
+            ", best -" + std::to_string(cpuLiveBest_.intersection_reduction);
+      }
+      cpuStatus += ")";
+    }
     std::string scoreText =
         "Human: " + std::to_string(intersectionCount) + " left  |  " + cpuStatus;
     menuBar->RenderTextCentered(scoreText, scoreRect, {255, 255, 255, 255});
@@ -1933,7 +2343,7 @@ void GameEngine::EndGame() {
   gameDuration = std::chrono::duration<float>(now - gameStartTime).count();
 
   currentPhase = GamePhase::GAME_ENDED;
-  std::cout << "[Game] Game ended by player. You lost!" << std::endl;
+  GT_LOG_INFO("Game", "Game ended by player. You lost!");
 }
 
 void GameEngine::TogglePauseCPU() {
@@ -1950,12 +2360,12 @@ void GameEngine::TogglePauseCPU() {
       cpuFuture_.wait(); // Wait for cancelled solver to return
       cpuSolving_ = false;
     }
-    std::cout << "[Game] CPU paused." << std::endl;
+    GT_LOG_INFO("Game", "CPU paused.");
   } else {
     // Reset delay timer so CPU resumes cleanly
     cpuCancelFlag_.store(false);
     cpuLastMoveTime_ = std::chrono::steady_clock::now();
-    std::cout << "[Game] CPU resumed." << std::endl;
+    GT_LOG_INFO("Game", "CPU resumed.");
   }
 }
 
@@ -2049,8 +2459,7 @@ void GameEngine::StartAutoSolve() {
   autoSolveActive_ = true;
   autoSolveAnimating_ = false;
 
-  std::cout << "[AutoSolve] Human forfeited. Showing CPU solution..."
-            << std::endl;
+  GT_LOG_INFO("AutoSolve", "Human forfeited. Showing CPU solution...");
 }
 
 void GameEngine::UpdateAutoSolve() {
@@ -2082,13 +2491,14 @@ void GameEngine::UpdateAutoSolve() {
               t * (autoSolveCurrentMove_.to_position.y -
                    autoSolveCurrentMove_.from_position.y);
     }
+    sceneIndex_.MoveNode(nodes, autoSolveCurrentMove_.node_id);
     return;
   }
 
   // Check if solved
   if (intersectionCount == 0) {
     autoSolveActive_ = false;
-    std::cout << "[AutoSolve] Complete! Solution shown." << std::endl;
+    GT_LOG_INFO("AutoSolve", "Complete! Solution shown.");
     return;
   }
 
@@ -2100,12 +2510,12 @@ void GameEngine::UpdateAutoSolve() {
     autoSolveAnimProgress_ = 0.0f;
     cpuLastMoveTime_ = std::chrono::steady_clock::now();
 
-    std::cout << "[AutoSolve] Move: Node " << move.node_id
-              << " | Reduction: " << move.intersection_reduction << std::endl;
+    GT_LOG_INFO("AutoSolve", "Move: Node {} | Reduction: {}", move.node_id,
+                move.intersection_reduction);
   } else {
     // Stuck - can't solve further
     autoSolveActive_ = false;
-    std::cout << "[AutoSolve] Stuck in local minimum." << std::endl;
+    GT_LOG_INFO("AutoSolve", "Stuck in local minimum.");
   }
 }
 
@@ -2116,14 +2526,7 @@ void GameEngine::DrawTextCentered(int x, int y, const std::string &text,
   if (!font)
     return;
 
-  SDL_Surface *surf = TTF_RenderText_Blended(font, text.c_str(), color);
-  if (surf) {
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, surf);
-    SDL_Rect dst = {x - surf->w / 2, y - surf->h / 2, surf->w, surf->h};
-    SDL_RenderCopy(renderer, tex, NULL, &dst);
-    SDL_DestroyTexture(tex);
-    SDL_FreeSurface(surf);
-  }
+  textCache_.Draw(font, text, color, x, y, TextCache::Align::CENTER);
 }
 
 void GameEngine::DrawButton(const SDL_Rect &rect, const std::string &text,
@@ -2296,10 +2699,28 @@ void GameEngine::RenderAlgorithmPanel() {
 
   // Panel dimensions and position (right side of screen)
   int panelW = 220;
-  int panelH = 200;
+  int panelH = AllocationTracker::IsEnabled() ? 254 : 218;
   int panelX = winW - panelW - 10;
   int panelY = MenuBar::BAR_HEIGHT + 10;
 
+  // Repainted when the mode changes or a stats sample lands
+  SDL_Rect bounds = {panelX, panelY, panelW, panelH};
+  RetainedLayer::Key key;
+  key.Add(panelX).Add(panelH).Add(static_cast<int>(currentMode));
+  key.Add(menuBar != nullptr).Add(currentSolver_ != nullptr);
+  if (currentSolver_) {
+    key.Add(currentSolver_->GetLastCandidatesEvaluated());
+    key.Add(cpuEvalRate_).Add(cpuPairRate_);
+    key.Add(cpuStatsSample_.AllocationsPerCall())
+        .Add(static_cast<uint64_t>(cpuStatsSample_.peakBytes));
+    key.Add(updateAllocsPerFrame_).Add(renderAllocsPerFrame_);
+  }
+  algorithmPanelLayer_.Draw(renderer, bounds, key,
+                            [&] { PaintAlgorithmPanel(panelX, panelY, panelW, panelH); });
+}
+
+void GameEngine::PaintAlgorithmPanel(int panelX, int panelY, int panelW,
+                                     int panelH) {
   // Semi-transparent background
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 25, 25, 30, 200);
@@ -2395,6 +2816,32 @@ void GameEngine::RenderAlgorithmPanel() {
     std::string candStr = "Last eval: " + std::to_string(candidates) + " pos";
     SDL_Rect candRect = {panelX + 8, textY, panelW - 16, 16};
     menuBar->RenderTextCentered(candStr, candRect, {150, 150, 155, 255});
+
+    // Live throughput sampled from the solver's stats block
+    textY += 18;
+    std::string rateStr = FormatCount(cpuEvalRate_) + " evals/s | " +
+                          FormatCount(cpuPairRate_) + " pairs/s";
+    SDL_Rect rateRect = {panelX + 8, textY, panelW - 16, 16};
+    menuBar->RenderTextCentered(rateStr, rateRect, {150, 150, 155, 255});
+
+    if (AllocationTracker::IsEnabled()) {
+      textY += 18;
+      std::string searchAllocStr =
+          FormatCount(cpuStatsSample_.AllocationsPerCall()) +
+          " allocs/move | peak " +
+          FormatCount(static_cast<double>(cpuStatsSample_.peakBytes)) + "B";
+      SDL_Rect searchAllocRect = {panelX + 8, textY, panelW - 16, 16};
+      menuBar->RenderTextCentered(searchAllocStr, searchAllocRect,
+                                  {150, 150, 155, 255});
+
+      textY += 18;
+      std::string frameAllocStr =
+          "Frame allocs: " + FormatCount(updateAllocsPerFrame_) + " upd | " +
+          FormatCount(renderAllocsPerFrame_) + " draw";
+      SDL_Rect frameAllocRect = {panelX + 8, textY, panelW - 16, 16};
+      menuBar->RenderTextCentered(frameAllocStr, frameAllocRect,
+                                  {150, 150, 155, 255});
+    }
   }
 }
 
@@ -2404,10 +2851,11 @@ void GameEngine::ToggleHeatmap() {
   heatmapEnabled_ = !heatmapEnabled_;
   if (heatmapEnabled_) {
     heatmapLastUpdate_ = std::chrono::steady_clock::time_point{}; // Force recalc
-    std::cout << "[Heatmap] Enabled" << std::endl;
+    heatmapNeedsFullPass_ = true;
+    GT_LOG_INFO("Heatmap", "Enabled");
   } else {
     nodeHeatmapScores_.clear();
-    std::cout << "[Heatmap] Disabled" << std::endl;
+    GT_LOG_INFO("Heatmap", "Disabled");
   }
 
   // Update menu checkbox (Game menu index 0, heatmap item index 4)
@@ -2440,32 +2888,142 @@ SDL_Color GameEngine::GetHeatmapColor(float score) const {
   return {r, g, b, 255};
 }
 
-void GameEngine::CalculateHeatmap() {
-  size_t n = nodes.size();
-  nodeHeatmapScores_.assign(n, 0.0f);
+void GameEngine::UpdateHeatmap() {
+  // Publish a finished job: the swap is the only heatmap work on this thread
+  if (heatmapFuture_.valid()) {
+    if (heatmapFuture_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return;
+    }
+    heatmapFuture_.get();
+    if (heatmapEnabled_) {
+      nodeHeatmapScores_.swap(heatmapBackScores_);
+      frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER);
+    }
+  }
 
-  if (intersectionCount == 0 || n == 0)
+  if (!heatmapEnabled_ || currentPhase != GamePhase::PLAYING ||
+      intersectionCount == 0) {
     return;
+  }
 
-  // Coarse grid for fast evaluation
-  const float gridSpacing = 120.0f;
-  const float margin = 60.0f;
-  int winW, winH;
-  SDL_GetWindowSize(window, &winW, &winH);
+  auto now = std::chrono::steady_clock::now();
+  float elapsed =
+      std::chrono::duration<float>(now - heatmapLastUpdate_).count();
+  if (elapsed < HEATMAP_UPDATE_INTERVAL &&
+      nodeHeatmapScores_.size() == nodes.size()) {
+    return;
+  }
+
+  // Graph replaced or resized since the cached scores: start over
+  if (heatmapSnapshot_.size() != nodes.size() ||
+      heatmapEdgeCount_ != edges.size() ||
+      heatmapPassesSinceFull_ >= HEATMAP_FULL_PASS_INTERVAL) {
+    heatmapNeedsFullPass_ = true;
+  }
+  bool fullPass = heatmapNeedsFullPass_;
+  heatmapNeedsFullPass_ = false;
+  heatmapPassesSinceFull_ = fullPass ? 0 : heatmapPassesSinceFull_ + 1;
+  heatmapEdgeCount_ = edges.size();
+
+  heatmapFuture_ = threadPool_->Submit(
+      [this, current = nodes, edgesCopy = edges, fullPass]() mutable {
+        CalculateHeatmap(std::move(current), std::move(edgesCopy), fullPass);
+      });
+  heatmapLastUpdate_ = now;
+}
+
+void GameEngine::CalculateHeatmap(std::vector<Node> current,
+                                  std::vector<Edge> edges, bool fullPass) {
+  GT_TRACE_SCOPE("CalculateHeatmap", "job");
+  size_t n = current.size();
+
+  std::vector<std::vector<int>> incidentEdges(n);
+  for (size_t e = 0; e < edges.size(); ++e) {
+    incidentEdges[edges[e].u_id].push_back(static_cast<int>(e));
+    incidentEdges[edges[e].v_id].push_back(static_cast<int>(e));
+  }
+
+  // Pick the nodes whose score may have changed since the last pass: moved
+  // nodes, their neighbors, and the endpoints of any edge a moved edge
+  // crossed before or crosses now. Other nodes can still drift slightly
+  // (a moved edge may block or clear one of their candidate spots), which
+  // the periodic full pass corrects.
+  std::vector<char> dirty(n, fullPass ? 1 : 0);
+  if (!fullPass) {
+    std::vector<char> moved(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+      if (current[i].position.x != heatmapSnapshot_[i].position.x ||
+          current[i].position.y != heatmapSnapshot_[i].position.y) {
+        moved[i] = 1;
+        dirty[i] = 1;
+        for (int neighbor : current[i].adjacencyList) {
+          if (neighbor >= 0 && neighbor < static_cast<int>(n)) {
+            dirty[neighbor] = 1;
+          }
+        }
+      }
+    }
 
-  std::vector<int> bestReduction(n, 0);
-  int globalMaxReduction = 0;
+    for (const Edge &movedEdge : edges) {
+      if (!moved[movedEdge.u_id] && !moved[movedEdge.v_id]) {
+        continue;
+      }
+      for (const Edge &other : edges) {
+        if (movedEdge.sharesVertex(other)) {
+          continue;
+        }
+        bool crossedBefore = CheckIntersection(
+            heatmapSnapshot_[movedEdge.u_id].position,
+            heatmapSnapshot_[movedEdge.v_id].position,
+            heatmapSnapshot_[other.u_id].position,
+            heatmapSnapshot_[other.v_id].position);
+        bool crossesNow = CheckIntersection(
+            current[movedEdge.u_id].position, current[movedEdge.v_id].position,
+            current[other.u_id].position, current[other.v_id].position);
+        if (crossedBefore || crossesNow) {
+          dirty[other.u_id] = 1;
+          dirty[other.v_id] = 1;
+        }
+      }
+    }
+  }
 
+  heatmapRawScores_.resize(n, 0);
+  std::vector<int> dirtyNodes;
   for (size_t i = 0; i < n; ++i) {
-    Vec2 originalPos = nodes[i].position;
-    int currentCount = intersectionCount;
+    if (dirty[i]) {
+      dirtyNodes.push_back(static_cast<int>(i));
+    }
+  }
+
+  // Coarse grid over the graph's canvas for fast evaluation
+  const float margin = 60.0f;
+  const Rect canvas = SolverCanvas(current, margin);
+  const float gridSpacing = GridSpacingFor(canvas, 120.0f);
+  const std::vector<Node> &snapshot = current;
+
+  // Only node i's incident edges are recounted, with i placed at each trial
+  // position on the shared snapshot: moving node i changes the total
+  // crossing count by exactly the change in crossings on i's edges
+  threadPool_->ParallelFor(0, dirtyNodes.size(), [&](size_t k) {
+    size_t i = static_cast<size_t>(dirtyNodes[k]);
+    const int id = static_cast<int>(i);
+    const std::vector<int> &incident = incidentEdges[i];
+    const int currentCount =
+        CountIncidentIntersections(snapshot, edges, incident);
+    auto countAt = [&](const Vec2 &position) {
+      return CountIncidentIntersectionsWithMove(snapshot, edges, incident, id,
+                                                position);
+    };
     int nodeBest = 0;
 
     // Test coarse grid positions
-    for (float x = margin; x <= winW - margin; x += gridSpacing) {
-      for (float y = margin; y <= winH - margin; y += gridSpacing) {
-        nodes[i].position = Vec2(x, y);
-        int newCount = CountIntersections(nodes, edges);
+    for (float x = canvas.minX + margin; x <= canvas.maxX - margin;
+         x += gridSpacing) {
+      for (float y = canvas.minY + margin; y <= canvas.maxY - margin;
+           y += gridSpacing) {
+        int newCount = countAt(Vec2(x, y));
         int reduction = currentCount - newCount;
         if (reduction > nodeBest) {
           nodeBest = reduction;
@@ -2474,36 +3032,38 @@ void GameEngine::CalculateHeatmap() {
     }
 
     // Also test centroid of neighbors
-    if (!nodes[i].adjacencyList.empty()) {
+    const std::vector<int> &neighbors = snapshot[i].adjacencyList;
+    if (!neighbors.empty()) {
       Vec2 centroid(0, 0);
-      for (int neighbor : nodes[i].adjacencyList) {
+      for (int neighbor : neighbors) {
         if (neighbor >= 0 && neighbor < static_cast<int>(n)) {
-          centroid = centroid + nodes[neighbor].position;
+          centroid = centroid + snapshot[neighbor].position;
         }
       }
-      centroid =
-          centroid * (1.0f / static_cast<float>(nodes[i].adjacencyList.size()));
-      nodes[i].position = centroid;
-      int newCount = CountIntersections(nodes, edges);
+      centroid = centroid * (1.0f / static_cast<float>(neighbors.size()));
+      int newCount = countAt(centroid);
       int reduction = currentCount - newCount;
       if (reduction > nodeBest) {
         nodeBest = reduction;
       }
     }
 
-    // Restore original position
-    nodes[i].position = originalPos;
-    bestReduction[i] = nodeBest;
-    if (nodeBest > globalMaxReduction) {
-      globalMaxReduction = nodeBest;
-    }
-  }
+    heatmapRawScores_[i] = nodeBest;
+  });
+
+  heatmapSnapshot_ = std::move(current);
+
+  int globalMaxReduction =
+      n > 0 ? *std::max_element(heatmapRawScores_.begin(),
+                                heatmapRawScores_.end())
+            : 0;
 
   // Normalize scores to [0, 1]
+  heatmapBackScores_.assign(n, 0.0f);
   if (globalMaxReduction > 0) {
     for (size_t i = 0; i < n; ++i) {
-      nodeHeatmapScores_[i] =
-          static_cast<float>(bestReduction[i]) / globalMaxReduction;
+      heatmapBackScores_[i] =
+          static_cast<float>(heatmapRawScores_[i]) / globalMaxReduction;
     }
   }
 }
@@ -2521,6 +3081,16 @@ void GameEngine::RenderHeatmapLegend() {
   int legendX = 10;
   int legendY = winH - legendH - 60; // Above scoreboard area
 
+  // Only moves with the window height; the gradient is the costly part
+  SDL_Rect bounds = {legendX, legendY, legendW, legendH};
+  RetainedLayer::Key key;
+  key.Add(legendY).Add(menuBar != nullptr);
+  heatmapLegendLayer_.Draw(renderer, bounds, key,
+                           [&] { PaintHeatmapLegend(legendX, legendY, legendW, legendH); });
+}
+
+void GameEngine::PaintHeatmapLegend(int legendX, int legendY, int legendW,
+                                    int legendH) {
   // Background
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(renderer, 25, 25, 30, 200);
@@ -2579,14 +3149,15 @@ void GameEngine::ComputeCpuVisCandidates(int nodeId) {
   int currentIntersections = CountIntersections(cpuNodes_, edges);
 
   // Generate candidate positions (same grid as solvers)
-  constexpr float GRID_SPACING = 80.0f;
   constexpr float MARGIN = 60.0f;
-  constexpr float W = 1024.0f;
-  constexpr float H = 768.0f;
+  Rect canvas = SolverCanvas(cpuNodes_, MARGIN);
+  float gridSpacing = GridSpacingFor(canvas, 80.0f);
 
   std::vector<Vec2> candidatePositions;
-  for (float x = MARGIN; x <= W - MARGIN; x += GRID_SPACING) {
-    for (float y = MARGIN; y <= H - MARGIN; y += GRID_SPACING) {
+  for (float x = canvas.minX + MARGIN; x <= canvas.maxX - MARGIN;
+       x += gridSpacing) {
+    for (float y = canvas.minY + MARGIN; y <= canvas.maxY - MARGIN;
+         y += gridSpacing) {
       candidatePositions.emplace_back(x, y);
     }
   }
@@ -2607,8 +3178,10 @@ void GameEngine::ComputeCpuVisCandidates(int nodeId) {
             2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / 8.0f;
         Vec2 candidate(npos.x + std::cos(angle) * radius,
                        npos.y + std::sin(angle) * radius);
-        candidate.x = std::max(MARGIN, std::min(W - MARGIN, candidate.x));
-        candidate.y = std::max(MARGIN, std::min(H - MARGIN, candidate.y));
+        candidate.x = std::max(canvas.minX + MARGIN,
+                               std::min(canvas.maxX - MARGIN, candidate.x));
+        candidate.y = std::max(canvas.minY + MARGIN,
+                               std::min(canvas.maxY - MARGIN, candidate.y));
         candidatePositions.push_back(candidate);
       }
     }
@@ -2757,10 +3330,14 @@ void GameEngine::RenderCpuVisualization() {
 
 void GameEngine::StartReplayViewer() {
   if (!cpuReplayLogger_) {
-    std::cout << "[Replay] No replay logger available." << std::endl;
+    GT_LOG_WARN("Replay", "No replay logger available.");
     return;
   }
 
+  // A job left from an earlier visit records into this logger; settle it
+  // before the logger may be restarted below
+  StopReplayCompletion();
+
   // Cancel any in-flight CPU task
   if (cpuSolving_ && cpuFuture_.valid()) {
     cpuCancelFlag_.store(true);
@@ -2780,47 +3357,107 @@ void GameEngine::StartReplayViewer() {
   if (cpuReplayLogger_->GetTotalMoves() == 0) {
     if (cpuNodes_.empty()) {
       // No game state available - can't replay
-      std::cout << "[Replay] No game data. Play a game first." << std::endl;
+      GT_LOG_INFO("Replay", "No game data. Play a game first.");
       return;
     }
     cpuReplayLogger_->StartMatch(cpuNodes_, edges,
                                  CountIntersections(cpuNodes_, edges));
   }
 
-  // === Complete the solution synchronously ===
-  // Continue solving from CPU's current state until solved or stuck
-  cpuCancelFlag_.store(false);
-  if (currentSolver_) {
-    currentSolver_->SetCancelFlag(&cpuCancelFlag_);
+  // === Complete the solution in the background ===
+  // The viewer opens right away on the moves recorded so far; the job keeps
+  // solving from the CPU's current state and streams further moves in
+  replayCancelFlag_.store(false);
+  replayCompleting_ = true;
+  replayCompletionFuture_ = threadPool_->Submit(
+      [this, solveNodes = cpuNodes_, solveEdges = edges,
+       mode = static_cast<SolverMode>(currentMode)]() mutable {
+        CompleteReplay(std::move(solveNodes), std::move(solveEdges), mode);
+      });
+
+  currentPhase = GamePhase::REPLAY_VIEWER;
+  replayCurrentStep_ = 0;
+  replayPlaying_ = false;
+
+  // Build initial graph state from replay logger
+  const auto &initialPositions = cpuReplayLogger_->GetInitialPositions();
+  replayNodes_.resize(initialPositions.size());
+  for (size_t i = 0; i < initialPositions.size(); ++i) {
+    replayNodes_[i] = Node(static_cast<int>(i), initialPositions[i]);
+    // Copy adjacency lists from cpuNodes_ (the game's graph)
+    if (i < cpuNodes_.size()) {
+      replayNodes_[i].adjacencyList = cpuNodes_[i].adjacencyList;
+    } else if (i < nodes.size()) {
+      replayNodes_[i].adjacencyList = nodes[i].adjacencyList;
+    }
   }
 
-  int currentIntersections = CountIntersections(cpuNodes_, edges);
+  // Build edges from ReplayLogger's stored edge data
+  const auto &edgePairs = cpuReplayLogger_->GetEdgePairs();
+  replayEdges_.clear();
+  replayEdges_.reserve(edgePairs.size());
+  for (const auto &[u, v] : edgePairs) {
+    replayEdges_.emplace_back(u, v);
+  }
+
+  // Moves stay on the solver canvas, so the initial layout's canvas holds
+  // the whole replay; up to 200 nodes it is the window-sized default
+  replayArea_ = SolverCanvas(replayNodes_, GreedySolver::MARGIN);
+
+  GT_LOG_INFO("Replay", "Entering replay viewer. Total moves: {}, Edges: {}",
+              cpuReplayLogger_->GetTotalMoves(), replayEdges_.size());
+}
+
+void GameEngine::CompleteReplay(std::vector<Node> solveNodes,
+                                std::vector<Edge> solveEdges, SolverMode mode) {
+  GT_TRACE_SCOPE("ReplayCompletion", "job");
+
+  // A private solver instance, so the race solver's progress channel and
+  // cancel flag stay untouched
+  std::unique_ptr<ICPUSolver> solver = CreateSolver(mode);
+  solver->SetThreadPool(threadPool_.get());
+  solver->SetCancelFlag(&replayCancelFlag_);
+
+  auto cancelled = [this]() { return replayCancelFlag_.load(); };
+
+  // Hand a move to the UI thread, waiting while its queue is full
+  auto stream = [&](const CPUMove &move) {
+    while (!replayMoves_.TryPush(move)) {
+      if (cancelled()) {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER);
+  };
+
+  int currentIntersections = CountIntersections(solveNodes, solveEdges);
   int stuckCount = 0;
   int extraMoves = 0;
   auto solveStart = std::chrono::steady_clock::now();
 
-  std::cout << "[Replay] Completing solution... Current crossings: "
-            << currentIntersections << std::endl;
-
-  while (currentIntersections > 0 && extraMoves < 100 && stuckCount < MAX_PERTURBATIONS) {
-    // Keep app responsive
-    SDL_PumpEvents();
+  GT_LOG_INFO("Replay", "Completing solution... Current crossings: {}",
+              currentIntersections);
 
-    // Time limit: 15 seconds
+  while (currentIntersections > 0 && extraMoves < REPLAY_COMPLETION_MAX_MOVES &&
+         stuckCount < MAX_PERTURBATIONS && !cancelled()) {
     auto now = std::chrono::steady_clock::now();
     float elapsed = std::chrono::duration<float>(now - solveStart).count();
-    if (elapsed > 15.0f) {
-      std::cout << "[Replay] Time limit reached." << std::endl;
+    if (elapsed > REPLAY_COMPLETION_TIME_LIMIT) {
+      GT_LOG_INFO("Replay", "Time limit reached.");
       break;
     }
 
-    CPUMove move = currentSolver_->FindBestMove(cpuNodes_, edges);
+    CPUMove move = solver->FindBestMove(solveNodes, solveEdges);
+    if (cancelled()) {
+      break;
+    }
 
     if (move.isValid()) {
-      cpuNodes_[move.node_id].position = move.to_position;
-      currentIntersections = CountIntersections(cpuNodes_, edges);
+      solveNodes[move.node_id].position = move.to_position;
+      currentIntersections = CountIntersections(solveNodes, solveEdges);
       move.intersections_after = currentIntersections;
-      cpuReplayLogger_->RecordMove(move);
+      stream(move);
       ++extraMoves;
 
       if (move.intersection_reduction > 0) {
@@ -2836,17 +3473,17 @@ void GameEngine::StartReplayViewer() {
 
       // Find nodes involved in crossings and perturb one
       std::vector<int> crossedNodes;
-      for (const Edge &e1 : edges) {
-        for (const Edge &e2 : edges) {
+      for (const Edge &e1 : solveEdges) {
+        for (const Edge &e2 : solveEdges) {
           if (e1.sharesVertex(e2)) continue;
-          if (e1.u_id >= static_cast<int>(cpuNodes_.size()) ||
-              e1.v_id >= static_cast<int>(cpuNodes_.size()) ||
-              e2.u_id >= static_cast<int>(cpuNodes_.size()) ||
-              e2.v_id >= static_cast<int>(cpuNodes_.size())) continue;
-          const Vec2 &a = cpuNodes_[e1.u_id].position;
-          const Vec2 &b = cpuNodes_[e1.v_id].position;
-          const Vec2 &c = cpuNodes_[e2.u_id].position;
-          const Vec2 &d = cpuNodes_[e2.v_id].position;
+          if (e1.u_id >= static_cast<int>(solveNodes.size()) ||
+              e1.v_id >= static_cast<int>(solveNodes.size()) ||
+              e2.u_id >= static_cast<int>(solveNodes.size()) ||
+              e2.v_id >= static_cast<int>(solveNodes.size())) continue;
+          const Vec2 &a = solveNodes[e1.u_id].position;
+          const Vec2 &b = solveNodes[e1.v_id].position;
+          const Vec2 &c = solveNodes[e2.u_id].position;
+          const Vec2 &d = solveNodes[e2.v_id].position;
           if (CheckIntersection(a, b, c, d)) {
             crossedNodes.push_back(e1.u_id);
             crossedNodes.push_back(e1.v_id);
@@ -2856,18 +3493,18 @@ void GameEngine::StartReplayViewer() {
 
       if (!crossedNodes.empty()) {
         int idx = crossedNodes[stuckCount % crossedNodes.size()];
-        if (idx >= 0 && idx < static_cast<int>(cpuNodes_.size()) &&
-            !cpuNodes_[idx].adjacencyList.empty()) {
+        if (idx >= 0 && idx < static_cast<int>(solveNodes.size()) &&
+            !solveNodes[idx].adjacencyList.empty()) {
           CPUMove perturbMove;
           perturbMove.node_id = idx;
-          perturbMove.from_position = cpuNodes_[idx].position;
+          perturbMove.from_position = solveNodes[idx].position;
           perturbMove.intersections_before = currentIntersections;
 
           Vec2 centroid(0, 0);
           int count = 0;
-          for (int nid : cpuNodes_[idx].adjacencyList) {
-            if (nid >= 0 && nid < static_cast<int>(cpuNodes_.size())) {
-              centroid = centroid + cpuNodes_[nid].position;
+          for (int nid : solveNodes[idx].adjacencyList) {
+            if (nid >= 0 && nid < static_cast<int>(solveNodes.size())) {
+              centroid = centroid + solveNodes[nid].position;
               ++count;
             }
           }
@@ -2875,16 +3512,17 @@ void GameEngine::StartReplayViewer() {
             centroid = centroid * (1.0f / static_cast<float>(count));
             centroid.x += static_cast<float>((stuckCount * 37) % 30 - 15);
             centroid.y += static_cast<float>((stuckCount * 53) % 30 - 15);
-            centroid.x = std::max(60.0f, std::min(964.0f, centroid.x));
-            centroid.y = std::max(60.0f, std::min(708.0f, centroid.y));
+            centroid = SolverCanvas(solveNodes, PERTURB_MARGIN)
+                           .Expanded(-PERTURB_MARGIN)
+                           .Clamp(centroid);
 
             perturbMove.to_position = centroid;
-            cpuNodes_[idx].position = centroid;
-            currentIntersections = CountIntersections(cpuNodes_, edges);
+            solveNodes[idx].position = centroid;
+            currentIntersections = CountIntersections(solveNodes, solveEdges);
             perturbMove.intersections_after = currentIntersections;
             perturbMove.intersection_reduction =
                 perturbMove.intersections_before - currentIntersections;
-            cpuReplayLogger_->RecordMove(perturbMove);
+            stream(perturbMove);
             ++extraMoves;
           }
         }
@@ -2892,38 +3530,51 @@ void GameEngine::StartReplayViewer() {
     }
   }
 
-  std::cout << "[Replay] Solution complete. Total moves: "
-            << cpuReplayLogger_->GetTotalMoves()
-            << ", Final crossings: " << currentIntersections << std::endl;
+  GT_LOG_INFO("Replay", "Solution complete. Extra moves: {}, Final crossings: {}",
+              extraMoves, currentIntersections);
+}
 
-  currentPhase = GamePhase::REPLAY_VIEWER;
-  replayCurrentStep_ = 0;
-  replayPlaying_ = false;
+void GameEngine::DrainReplayMoves() {
+  if (!replayCompleting_) {
+    return;
+  }
 
-  // Build initial graph state from replay logger
-  const auto &initialPositions = cpuReplayLogger_->GetInitialPositions();
-  replayNodes_.resize(initialPositions.size());
-  for (size_t i = 0; i < initialPositions.size(); ++i) {
-    replayNodes_[i] = Node(static_cast<int>(i), initialPositions[i]);
-    // Copy adjacency lists from cpuNodes_ (the game's graph)
-    if (i < cpuNodes_.size()) {
-      replayNodes_[i].adjacencyList = cpuNodes_[i].adjacencyList;
-    } else if (i < nodes.size()) {
-      replayNodes_[i].adjacencyList = nodes[i].adjacencyList;
+  // Check completion before draining so moves pushed just before the job
+  // finished are never left behind in the channel
+  bool finished = replayCompletionFuture_.valid() &&
+                  replayCompletionFuture_.wait_for(std::chrono::seconds(0)) ==
+                      std::future_status::ready;
+
+  if (finished) {
+    frameScheduler_.MarkDirty(FrameScheduler::DIRTY_SOLVER);
+  }
+
+  CPUMove move;
+  while (replayMoves_.TryPop(move)) {
+    // Advance the CPU's own state too, so re-entering the viewer continues
+    // from where this run stopped
+    if (move.node_id >= 0 && move.node_id < static_cast<int>(cpuNodes_.size())) {
+      cpuNodes_[move.node_id].position = move.to_position;
+      cpuIntersectionCount_ = move.intersections_after;
+    }
+    if (cpuReplayLogger_) {
+      cpuReplayLogger_->RecordMove(move);
     }
   }
 
-  // Build edges from ReplayLogger's stored edge data
-  const auto &edgePairs = cpuReplayLogger_->GetEdgePairs();
-  replayEdges_.clear();
-  replayEdges_.reserve(edgePairs.size());
-  for (const auto &[u, v] : edgePairs) {
-    replayEdges_.emplace_back(u, v);
+  if (finished) {
+    replayCompletionFuture_.get();
+    replayCompleting_ = false;
   }
+}
 
-  std::cout << "[Replay] Entering replay viewer. Total moves: "
-            << cpuReplayLogger_->GetTotalMoves()
-            << ", Edges: " << replayEdges_.size() << std::endl;
+void GameEngine::StopReplayCompletion() {
+  if (!replayCompleting_) {
+    return;
+  }
+  replayCancelFlag_.store(true);
+  replayCompletionFuture_.wait();
+  DrainReplayMoves();
 }
 
 void GameEngine::ReplayGoToStep(int step) {
@@ -2938,32 +3589,19 @@ void GameEngine::ReplayGoToStep(int step) {
 
   int prevStep = replayCurrentStep_;
 
-  // Rebuild graph state from initial positions up to step-1
-  // (the last move will be animated if stepping forward by 1)
-  const auto &initialPositions = cpuReplayLogger_->GetInitialPositions();
-  replayNodes_.resize(initialPositions.size());
-  for (size_t i = 0; i < initialPositions.size(); ++i) {
-    replayNodes_[i] = Node(static_cast<int>(i), initialPositions[i]);
-    if (i < cpuNodes_.size()) {
-      replayNodes_[i].adjacencyList = cpuNodes_[i].adjacencyList;
-    } else if (i < nodes.size()) {
-      replayNodes_[i].adjacencyList = nodes[i].adjacencyList;
-    }
+  // replayNodes_ holds the layout after prevStep once an in-flight
+  // animation lands; seek it in place from there (adjacency never changes)
+  if (replayAnimating_ && replayAnimNodeId_ >= 0 &&
+      replayAnimNodeId_ < static_cast<int>(replayNodes_.size())) {
+    replayNodes_[replayAnimNodeId_].position = replayAnimTo_;
   }
+  replayAnimating_ = false;
+  cpuReplayLogger_->Seek(replayNodes_, prevStep, step);
 
   // Check if we should animate (stepping forward by exactly 1)
   bool shouldAnimate = (step == prevStep + 1) && (step > 0);
 
   if (shouldAnimate) {
-    // Apply moves 1..step-1 (everything before the animated move)
-    for (int s = 1; s < step; ++s) {
-      const CPUMove &move = cpuReplayLogger_->GetMoveAt(s);
-      if (move.isValid() &&
-          move.node_id < static_cast<int>(replayNodes_.size())) {
-        replayNodes_[move.node_id].position = move.to_position;
-      }
-    }
-
     // Start animation for the current step's move
     const CPUMove &move = cpuReplayLogger_->GetMoveAt(step);
     if (move.isValid() &&
@@ -2977,16 +3615,6 @@ void GameEngine::ReplayGoToStep(int step) {
       // Node starts at old position, will be interpolated in UpdatePhase
       replayNodes_[move.node_id].position = move.from_position;
     }
-  } else {
-    // Instant jump (going backward or jumping multiple steps)
-    for (int s = 1; s <= step; ++s) {
-      const CPUMove &move = cpuReplayLogger_->GetMoveAt(s);
-      if (move.isValid() &&
-          move.node_id < static_cast<int>(replayNodes_.size())) {
-        replayNodes_[move.node_id].position = move.to_position;
-      }
-    }
-    replayAnimating_ = false;
   }
 
   replayCurrentStep_ = step;
@@ -3011,19 +3639,17 @@ void GameEngine::ComputeReplayCandidates() {
   if (!move.isValid())
     return;
 
-  // Build the graph state BEFORE this move (replay steps 1..step-1)
-  const auto &initialPositions = cpuReplayLogger_->GetInitialPositions();
-  std::vector<Node> preNodes(initialPositions.size());
-  for (size_t i = 0; i < initialPositions.size(); ++i) {
-    preNodes[i] = Node(static_cast<int>(i), initialPositions[i]);
+  // Build the graph state BEFORE this move by stepping the shown one back
+  std::vector<Node> preNodes(replayNodes_.size());
+  for (size_t i = 0; i < replayNodes_.size(); ++i) {
+    preNodes[i] = Node(static_cast<int>(i), replayNodes_[i].position);
   }
-  for (int s = 1; s < replayCurrentStep_; ++s) {
-    const CPUMove &prevMove = cpuReplayLogger_->GetMoveAt(s);
-    if (prevMove.isValid() &&
-        prevMove.node_id < static_cast<int>(preNodes.size())) {
-      preNodes[prevMove.node_id].position = prevMove.to_position;
-    }
+  if (replayAnimating_ && replayAnimNodeId_ >= 0 &&
+      replayAnimNodeId_ < static_cast<int>(preNodes.size())) {
+    preNodes[replayAnimNodeId_].position = replayAnimTo_;
   }
+  cpuReplayLogger_->Seek(preNodes, replayCurrentStep_,
+                         replayCurrentStep_ - 1);
 
   int nodeId = move.node_id;
   if (nodeId < 0 || nodeId >= static_cast<int>(preNodes.size()))
@@ -3031,17 +3657,18 @@ void GameEngine::ComputeReplayCandidates() {
 
   int currentIntersections = CountIntersections(preNodes, replayEdges_);
 
-  // Generate candidate positions (same grid as GreedySolver)
-  constexpr float GRID_SPACING = 80.0f;
-  constexpr float MARGIN = 60.0f;
-  constexpr float W = 1024.0f;
-  constexpr float H = 768.0f;
+  // Generate candidate positions (same canvas and grid as GreedySolver)
+  constexpr float MARGIN = GreedySolver::MARGIN;
+  const Rect canvas = SolverCanvas(preNodes, MARGIN);
+  const Rect inner = canvas.Expanded(-MARGIN);
+  const float gridSpacing =
+      GridSpacingFor(canvas, GreedySolver::GRID_SPACING);
 
   std::vector<Vec2> candidatePositions;
 
   // Grid candidates
-  for (float x = MARGIN; x <= W - MARGIN; x += GRID_SPACING) {
-    for (float y = MARGIN; y <= H - MARGIN; y += GRID_SPACING) {
+  for (float x = inner.minX; x <= inner.maxX; x += gridSpacing) {
+    for (float y = inner.minY; y <= inner.maxY; y += gridSpacing) {
       candidatePositions.emplace_back(x, y);
     }
   }
@@ -3064,20 +3691,25 @@ void GameEngine::ComputeReplayCandidates() {
               2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / 8.0f;
           Vec2 candidate(npos.x + std::cos(angle) * radius,
                          npos.y + std::sin(angle) * radius);
-          candidate.x = std::max(MARGIN, std::min(W - MARGIN, candidate.x));
-          candidate.y = std::max(MARGIN, std::min(H - MARGIN, candidate.y));
-          candidatePositions.push_back(candidate);
+          candidatePositions.push_back(inner.Clamp(candidate));
         }
       }
     }
   }
 
-  // Evaluate each candidate
-  Vec2 originalPos = preNodes[nodeId].position;
+  // Evaluate each candidate; only the moved node's edges change crossings
+  std::vector<int> incident;
+  for (size_t e = 0; e < replayEdges_.size(); ++e) {
+    if (replayEdges_[e].u_id == nodeId || replayEdges_[e].v_id == nodeId) {
+      incident.push_back(static_cast<int>(e));
+    }
+  }
+  const int incidentBefore =
+      CountIncidentIntersections(preNodes, replayEdges_, incident);
   for (const Vec2 &cpos : candidatePositions) {
-    preNodes[nodeId].position = cpos;
-    int newCount = CountIntersections(preNodes, replayEdges_);
-    preNodes[nodeId].position = originalPos;
+    int newCount = currentIntersections - incidentBefore +
+                   CountIncidentIntersectionsWithMove(preNodes, replayEdges_,
+                                                      incident, nodeId, cpos);
 
     ReplayCandidate rc;
     rc.position = cpos;
@@ -3093,6 +3725,7 @@ void GameEngine::HandleReplayInput(const SDL_Event &event) {
     case SDLK_ESCAPE:
       // Return to main menu
       replayAnimating_ = false;
+      StopReplayCompletion();
       currentPhase = GamePhase::MAIN_MENU;
       return;
     case SDLK_RIGHT:
@@ -3167,6 +3800,7 @@ void GameEngine::HandleReplayInput(const SDL_Event &event) {
     SDL_Rect exitBtn = {winW - 110, btnY, 100, btnH};
     if (SDL_PointInRect(&pt, &exitBtn)) {
       replayAnimating_ = false;
+      StopReplayCompletion();
       currentPhase = GamePhase::MAIN_MENU;
       return;
     }
@@ -3181,6 +3815,12 @@ void GameEngine::RenderReplayViewer() {
   SDL_GetWindowSize(window, &winW, &winH);
   int totalMoves = cpuReplayLogger_->GetTotalMoves();
 
+  // World-space parts go through a camera fitted to the replay; markers
+  // and panels keep their pixel sizes
+  Camera camera;
+  camera.Fit(replayArea_, winW, winH);
+  constexpr int LABEL_MIN_RADIUS = 8; // Node IDs only fit from here up
+
   // Get current move info
   int movedNodeId = -1;
   CPUMove currentMove;
@@ -3225,10 +3865,12 @@ void GameEngine::RenderReplayViewer() {
     SDL_Color color = isIntersecting ? Colors::EDGE_CRITICAL : Colors::EDGE_SAFE;
 
     // Draw thicker edges for the moved node's connections
+    Vec2 s1 = camera.WorldToScreen(p1);
+    Vec2 s2 = camera.WorldToScreen(p2);
     if (isMovedEdge) {
       // Draw 3-pixel-wide line for emphasis
-      int x1 = static_cast<int>(p1.x), y1 = static_cast<int>(p1.y);
-      int x2 = static_cast<int>(p2.x), y2 = static_cast<int>(p2.y);
+      int x1 = static_cast<int>(s1.x), y1 = static_cast<int>(s1.y);
+      int x2 = static_cast<int>(s2.x), y2 = static_cast<int>(s2.y);
       if (isIntersecting) {
         // Bright pulsing red for crossing edges being fixed
         SDL_SetRenderDrawColor(renderer, 255, 60, 60, 255);
@@ -3242,16 +3884,17 @@ void GameEngine::RenderReplayViewer() {
       }
     } else {
       SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-      SDL_RenderDrawLine(renderer, static_cast<int>(p1.x),
-                         static_cast<int>(p1.y), static_cast<int>(p2.x),
-                         static_cast<int>(p2.y));
+      SDL_RenderDrawLine(renderer, static_cast<int>(s1.x),
+                         static_cast<int>(s1.y), static_cast<int>(s2.x),
+                         static_cast<int>(s2.y));
     }
   }
 
   // === Ghost marker at old position (before animation completes) ===
   if (replayCurrentStep_ > 0 && currentMove.isValid()) {
-    int fromX = static_cast<int>(currentMove.from_position.x);
-    int fromY = static_cast<int>(currentMove.from_position.y);
+    Vec2 from = camera.WorldToScreen(currentMove.from_position);
+    int fromX = static_cast<int>(from.x);
+    int fromY = static_cast<int>(from.y);
 
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
@@ -3286,8 +3929,9 @@ void GameEngine::RenderReplayViewer() {
     }
 
     // Draw thick arrow from old to new position
-    int toX = static_cast<int>(currentMove.to_position.x);
-    int toY = static_cast<int>(currentMove.to_position.y);
+    Vec2 to = camera.WorldToScreen(currentMove.to_position);
+    int toX = static_cast<int>(to.x);
+    int toY = static_cast<int>(to.y);
 
     SDL_SetRenderDrawColor(renderer, 255, 215, 0, 200);
     float dx = static_cast<float>(toX - fromX);
@@ -3362,9 +4006,10 @@ void GameEngine::RenderReplayViewer() {
   // Draw nodes - highlight the moved node at current step
 
   for (const Node &node : replayNodes_) {
-    int cx = static_cast<int>(node.position.x);
-    int cy = static_cast<int>(node.position.y);
-    int r = static_cast<int>(node.radius);
+    Vec2 center = camera.WorldToScreen(node.position);
+    int cx = static_cast<int>(center.x);
+    int cy = static_cast<int>(center.y);
+    int r = std::max(1, static_cast<int>(node.radius * camera.Zoom()));
 
     SDL_Color fillColor;
     if (node.id == movedNodeId) {
@@ -3381,34 +4026,22 @@ void GameEngine::RenderReplayViewer() {
       fillColor = {80, 200, 100, 255};
     }
 
-    SDL_SetRenderDrawColor(renderer, fillColor.r, fillColor.g, fillColor.b,
-                           fillColor.a);
-    DrawFilledCircle(cx, cy, r);
-
     // Border
     SDL_Color borderColor =
         (node.id == movedNodeId) ? SDL_Color{255, 255, 255, 255}
                                  : Colors::NODE_BORDER;
-    SDL_SetRenderDrawColor(renderer, borderColor.r, borderColor.g,
-                           borderColor.b, borderColor.a);
-    int bx = r, by = 0;
-    int radiusError = 1 - bx;
-    while (bx >= by) {
-      SDL_RenderDrawPoint(renderer, cx + bx, cy + by);
-      SDL_RenderDrawPoint(renderer, cx + by, cy + bx);
-      SDL_RenderDrawPoint(renderer, cx - by, cy + bx);
-      SDL_RenderDrawPoint(renderer, cx - bx, cy + by);
-      SDL_RenderDrawPoint(renderer, cx - bx, cy - by);
-      SDL_RenderDrawPoint(renderer, cx - by, cy - bx);
-      SDL_RenderDrawPoint(renderer, cx + by, cy - bx);
-      SDL_RenderDrawPoint(renderer, cx + bx, cy - by);
-      ++by;
-      if (radiusError < 0) {
-        radiusError += 2 * by + 1;
-      } else {
-        --bx;
-        radiusError += 2 * (by - bx + 1);
-      }
+    DrawNodeShape(cx, cy, r, fillColor, borderColor);
+  }
+  nodeSprites_.Flush();
+
+  // Labels after the batched circles, so no node covers another's label
+  for (const Node &node : replayNodes_) {
+    Vec2 center = camera.WorldToScreen(node.position);
+    int cx = static_cast<int>(center.x);
+    int cy = static_cast<int>(center.y);
+    int r = std::max(1, static_cast<int>(node.radius * camera.Zoom()));
+    if (r < LABEL_MIN_RADIUS) {
+      continue; // Too small to hold a label
     }
 
     // Draw crossing count label on hot nodes
@@ -3447,8 +4080,9 @@ void GameEngine::RenderReplayViewer() {
     // Draw all candidate positions as color-coded dots
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     for (const auto &c : replayCandidates_) {
-      int cx = static_cast<int>(c.position.x);
-      int cy = static_cast<int>(c.position.y);
+      Vec2 point = camera.WorldToScreen(c.position);
+      int cx = static_cast<int>(point.x);
+      int cy = static_cast<int>(point.y);
 
       // Color: red (worst) → yellow (neutral) → green (best)
       SDL_Color dotColor;
@@ -3604,6 +4238,9 @@ void GameEngine::RenderReplayViewer() {
 
     std::string titleText = "Step " + std::to_string(replayCurrentStep_) +
                             " / " + std::to_string(totalMoves);
+    if (replayCompleting_) {
+      titleText += " (solving...)";
+    }
     menuBar->RenderTextCentered(titleText, titleRect, {255, 255, 255, 255});
 
     int textY = panelY + 32;
@@ -3797,111 +4434,86 @@ void GameEngine::RunBenchmark() {
     cpuSolving_ = false;
   }
 
-  // If we're at main menu or have no graph, generate a fresh one
-  if (nodes.empty() || currentPhase == GamePhase::MAIN_MENU ||
-      currentPhase == GamePhase::BENCHMARK_RESULTS) {
-    ClearGraph();
-    for (int i = 0; i < currentNodeCount; ++i) {
-      AddNode(Vec2(0, 0));
-    }
-    for (int i = 0; i < currentNodeCount; ++i) {
-      AddEdge(i, (i + 1) % currentNodeCount);
-    }
-    // Add chord edges for complexity
-    std::mt19937 rng(42);
-    int chords = std::max(1, currentNodeCount / 3);
-    for (int c = 0; c < chords; ++c) {
-      int a = rng() % currentNodeCount;
-      int b = rng() % currentNodeCount;
-      if (a != b && std::abs(a - b) > 1) {
-        AddEdge(a, b);
-      }
-    }
-    GeneratePlanarLayout();
-    ApplyCircleScramble();
-    for (size_t i = 0; i < nodes.size(); ++i) {
-      nodes[i].position = targetPositions[i];
-    }
-  }
-
-  // Snapshot the current tangled graph (use cpuNodes_ if available, else nodes)
-  std::vector<Node> snapshotNodes =
-      cpuNodes_.empty() ? nodes : cpuNodes_;
-
-  int initialIntersections = CountIntersections(snapshotNodes, edges);
-  if (initialIntersections == 0) {
-    std::cout << "[Benchmark] Graph has no intersections. Nothing to solve."
-              << std::endl;
-    return;
+  BenchmarkConfig config;
+  config.nodeCount = currentNodeCount;
+  config.maxMoves = BENCHMARK_MAX_MOVES;
+  config.trialTimeLimit = BENCHMARK_TRIAL_MAX_TIME;
+  config.sweepTimeLimit = BENCHMARK_MAX_TIME;
+  config.seeds.clear();
+  for (int s = 1; s <= BENCHMARK_SEEDS; ++s) {
+    config.seeds.push_back(static_cast<uint32_t>(s));
   }
+  benchmarkCancelFlag_.store(false);
+  config.cancelFlag = &benchmarkCancelFlag_;
 
   benchmarkResults_.clear();
   benchmarkShowPlot_ = false;
-  std::cout << "[Benchmark] Starting comparison on " << snapshotNodes.size()
-            << " nodes, " << edges.size() << " edges, "
-            << initialIntersections << " intersections..." << std::endl;
-
-  // Run each solver
-  SolverMode modes[] = {SolverMode::GREEDY, SolverMode::BACKTRACKING,
-                        SolverMode::DIVIDE_AND_CONQUER_DP};
-
-  for (SolverMode mode : modes) {
+  GT_LOG_INFO("Benchmark", "Starting sweep: {} solvers x {} families x {} seeds at N={} on {} workers...",
+              config.modes.size(), config.families.size(), config.seeds.size(),
+              config.nodeCount, threadPool_->GetThreadCount());
+
+  auto sweepStart = std::chrono::steady_clock::now();
+  BenchmarkRunner runner(*threadPool_);
+  std::vector<BenchmarkTrial> trials = runner.Run(config);
+  std::vector<BenchmarkAggregate> aggregates =
+      BenchmarkRunner::Aggregate(trials, config.modes);
+  auto sweepMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - sweepStart)
+                     .count();
+
+  benchmarkNodeCount_ = config.nodeCount;
+  benchmarkTrialCount_ = 0;
+  benchmarkSkippedTrials_ = 0;
+  for (const BenchmarkTrial &t : trials) {
+    if (t.completed) {
+      ++benchmarkTrialCount_;
+    } else {
+      ++benchmarkSkippedTrials_;
+    }
+  }
 
-    auto solver = CreateSolver(mode);
+  for (const BenchmarkAggregate &agg : aggregates) {
     BenchmarkResult result;
-    result.solverName = solver->GetName();
-    result.initialIntersections = initialIntersections;
-    result.intersectionHistory.push_back(initialIntersections);
-
-    // Clone graph for this solver
-    std::vector<Node> solverNodes = snapshotNodes;
-    int currentCount = initialIntersections;
-
-    auto startTime = std::chrono::steady_clock::now();
-
-    for (int moveNum = 0; moveNum < BENCHMARK_MAX_MOVES; ++moveNum) {
-      // Check time limit
-      auto now = std::chrono::steady_clock::now();
-      float elapsed =
-          std::chrono::duration<float>(now - startTime).count();
-      if (elapsed >= BENCHMARK_MAX_TIME)
-        break;
-
-      if (currentCount == 0)
-        break;
-
-      CPUMove move = solver->FindBestMove(solverNodes, edges);
-      result.totalCandidatesEvaluated += solver->GetLastCandidatesEvaluated();
-
-      if (!move.isValid() || move.intersection_reduction <= 0)
+    result.solverName = agg.solverName;
+    result.trials = agg.trials;
+    result.solvedTrials = agg.solvedTrials;
+    result.timeMsDist = agg.timeMs;
+    result.movesDist = agg.moves;
+    result.finalDist = agg.finalIntersections;
+    result.totalMoves = static_cast<int>(std::lround(agg.moves.median));
+    result.totalTimeMs = static_cast<int64_t>(std::llround(agg.timeMs.median));
+    result.finalIntersections =
+        static_cast<int>(std::lround(agg.finalIntersections.median));
+    result.solved = agg.trials > 0 && agg.solvedTrials == agg.trials;
+    result.totalCandidatesEvaluated =
+        static_cast<int>(std::min<uint64_t>(agg.candidatesEvaluated, INT_MAX));
+    result.pairTests = agg.pairTests;
+    result.evalsPerSecond = agg.evalsPerSecond.median;
+    result.pairTestsPerSecond = agg.pairTestsPerSecond.median;
+
+    // Convergence plot: the first puzzle of the sweep, same for every solver
+    for (const BenchmarkTrial &t : trials) {
+      if (t.mode == agg.mode && t.completed &&
+          t.family == config.families.front() &&
+          t.seed == config.seeds.front()) {
+        result.initialIntersections = t.initialIntersections;
+        result.intersectionHistory = t.intersectionHistory;
         break;
+      }
+    }
 
-      // Apply move
-      solverNodes[move.node_id].position = move.to_position;
-      currentCount = CountIntersections(solverNodes, edges);
-      ++result.totalMoves;
-      result.intersectionHistory.push_back(currentCount);
-    }
-
-    auto endTime = std::chrono::steady_clock::now();
-    result.totalTimeMs =
-        std::chrono::duration_cast<std::chrono::milliseconds>(endTime -
-                                                              startTime)
-            .count();
-    result.finalIntersections = currentCount;
-    result.solved = (currentCount == 0);
-
-    std::cout << "[Benchmark] " << result.solverName << ": "
-              << result.totalMoves << " moves, " << result.totalTimeMs
-              << "ms, final=" << result.finalIntersections
-              << (result.solved ? " (SOLVED)" : "") << std::endl;
+    GT_LOG_INFO("Benchmark", "{}: solved {}/{}, time median {}ms p95 {}ms",
+                agg.solverName, agg.solvedTrials, agg.trials, agg.timeMs.median,
+                agg.timeMs.p95);
+    GT_LOG_INFO("Benchmark", "  moves median {} p95 {}, final median {} p95 {}, {} evals/s, {} pair tests/s",
+                agg.moves.median, agg.moves.p95, agg.finalIntersections.median,
+                agg.finalIntersections.p95, FormatCount(result.evalsPerSecond),
+                FormatCount(result.pairTestsPerSecond));
     benchmarkResults_.push_back(result);
   }
 
-  // Restore original graph
-  nodes = snapshotNodes;
-
-  std::cout << "[Benchmark] Complete. Showing results." << std::endl;
+  GT_LOG_INFO("Benchmark", "Complete in {}ms ({} trials, {} skipped at deadline). Showing results.",
+              sweepMs, benchmarkTrialCount_, benchmarkSkippedTrials_);
 }
 
 void GameEngine::HandleBenchmarkInput(const SDL_Event &event) {
@@ -3965,6 +4577,15 @@ void GameEngine::RenderBenchmarkResults() {
   if (numSolvers == 0)
     return;
 
+  // New results invalidate the layer when the sweep finishes
+  SDL_Rect bounds = {0, 0, winW, winH};
+  RetainedLayer::Key key;
+  key.Add(winW).Add(winH).Add(benchmarkShowPlot_).Add(menuBar != nullptr);
+  benchmarkLayer_.Draw(renderer, bounds, key,
+                       [&] { PaintBenchmarkResults(winW, winH, numSolvers); });
+}
+
+void GameEngine::PaintBenchmarkResults(int winW, int winH, int numSolvers) {
   // If showing convergence plot, delegate to that renderer
   if (benchmarkShowPlot_) {
     RenderConvergencePlot();
@@ -3975,15 +4596,14 @@ void GameEngine::RenderBenchmarkResults() {
   DrawTextCentered(winW / 2, 55, "ALGORITHM COMPARISON",
                    {231, 76, 60, 255}, 48);
 
-  // Graph info subtitle
+  // Sweep info subtitle
   std::string graphInfo =
-      "Nodes: " +
-      std::to_string(benchmarkResults_[0].initialIntersections > 0
-                         ? static_cast<int>(nodes.size())
-                         : 0) +
-      "  |  Edges: " + std::to_string(edges.size()) +
-      "  |  Initial Crossings: " +
-      std::to_string(benchmarkResults_[0].initialIntersections);
+      "Nodes: " + std::to_string(benchmarkNodeCount_) + "  |  " +
+      std::to_string(BENCHMARK_SEEDS) + " seeds x 3 families  |  Trials: " +
+      std::to_string(benchmarkTrialCount_);
+  if (benchmarkSkippedTrials_ > 0) {
+    graphInfo += " (" + std::to_string(benchmarkSkippedTrials_) + " skipped)";
+  }
   DrawTextCentered(winW / 2, 90, graphInfo, {180, 180, 185, 255}, 24);
 
   // Column layout for solver cards
@@ -4034,19 +4654,24 @@ void GameEngine::RenderBenchmarkResults() {
       menuBar->RenderTextCentered(r.solverName, header, {255, 255, 255, 255});
     }
 
-    // Solved badge
+    // Solved badge: trials solved out of trials run
     int textY = cardY + 46;
     if (menuBar) {
+      std::string badgeText = "SOLVED " + std::to_string(r.solvedTrials) +
+                              "/" + std::to_string(r.trials);
+      SDL_Rect badge = {cx + cardW / 2 - 60, textY, 120, 22};
       if (r.solved) {
-        SDL_Rect badge = {cx + cardW / 2 - 40, textY, 80, 22};
         SDL_SetRenderDrawColor(renderer, 50, 205, 50, 255);
         SDL_RenderFillRect(renderer, &badge);
-        menuBar->RenderTextCentered("SOLVED", badge, {20, 20, 25, 255});
+        menuBar->RenderTextCentered(badgeText, badge, {20, 20, 25, 255});
+      } else if (r.solvedTrials > 0) {
+        SDL_SetRenderDrawColor(renderer, 220, 140, 30, 255);
+        SDL_RenderFillRect(renderer, &badge);
+        menuBar->RenderTextCentered(badgeText, badge, {20, 20, 25, 255});
       } else {
-        SDL_Rect badge = {cx + cardW / 2 - 50, textY, 100, 22};
         SDL_SetRenderDrawColor(renderer, 180, 40, 40, 255);
         SDL_RenderFillRect(renderer, &badge);
-        menuBar->RenderTextCentered("NOT SOLVED", badge, {255, 255, 255, 255});
+        menuBar->RenderTextCentered(badgeText, badge, {255, 255, 255, 255});
       }
     }
 
@@ -4066,28 +4691,38 @@ void GameEngine::RenderBenchmarkResults() {
       menuBar->RenderTextCentered(value, valRect, valColor);
     };
 
+    // "median (mean x, p95 y)" for one distribution
+    auto formatDist = [](const Distribution &d, int precision,
+                         const char *unit) {
+      std::ostringstream oss;
+      oss << std::fixed << std::setprecision(precision) << d.median << unit
+          << "  (mean " << std::setprecision(1) << d.mean << ", p95 "
+          << std::setprecision(precision) << d.p95 << ")";
+      return oss.str();
+    };
+
     // Total Moves
-    drawStat(textY, "Total Moves", std::to_string(r.totalMoves),
+    drawStat(textY, "Moves (median)", formatDist(r.movesDist, 0, ""),
              r.totalMoves == bestMoves && r.totalMoves > 0);
     textY += 50;
 
     // Total Time
     std::string timeStr;
-    if (r.totalTimeMs < 1000) {
-      timeStr = std::to_string(r.totalTimeMs) + " ms";
+    if (r.timeMsDist.p95 < 1000) {
+      timeStr = formatDist(r.timeMsDist, 0, " ms");
     } else {
-      std::ostringstream oss;
-      oss << std::fixed << std::setprecision(2)
-          << (r.totalTimeMs / 1000.0) << " s";
-      timeStr = oss.str();
+      Distribution seconds = r.timeMsDist;
+      seconds.median /= 1000.0;
+      seconds.mean /= 1000.0;
+      seconds.p95 /= 1000.0;
+      timeStr = formatDist(seconds, 2, " s");
     }
-    drawStat(textY, "Total Time", timeStr,
+    drawStat(textY, "Time (median)", timeStr,
              static_cast<int>(r.totalTimeMs) == bestTime);
     textY += 50;
 
     // Final Intersections
-    drawStat(textY, "Final Crossings",
-             std::to_string(r.finalIntersections),
+    drawStat(textY, "Final Crossings (median)", formatDist(r.finalDist, 0, ""),
              r.finalIntersections == bestFinal);
     textY += 50;
 
@@ -4101,13 +4736,13 @@ void GameEngine::RenderBenchmarkResults() {
     } else {
       candStr = std::to_string(r.totalCandidatesEvaluated);
     }
+    candStr += " (" + FormatCount(r.pairTestsPerSecond) + " pairs/s)";
     drawStat(textY, "Candidates Evaluated", candStr, false);
     textY += 50;
 
     // Avg time per move
-    if (r.totalMoves > 0) {
-      float avgMs =
-          static_cast<float>(r.totalTimeMs) / r.totalMoves;
+    if (r.movesDist.mean > 0.0) {
+      float avgMs = static_cast<float>(r.timeMsDist.mean / r.movesDist.mean);
       std::ostringstream avgStr;
       avgStr << std::fixed << std::setprecision(1) << avgMs << " ms/move";
       drawStat(textY, "Avg Time/Move", avgStr.str(), false);
@@ -4352,127 +4987,40 @@ void GameEngine::RunScalabilityTest() {
     cpuSolving_ = false;
   }
 
-  scalabilityResults_.clear();
-  std::cout << "[Complexity] Starting empirical complexity analysis..."
-            << std::endl;
-
-  SolverMode modes[] = {SolverMode::GREEDY, SolverMode::BACKTRACKING,
-                        SolverMode::DIVIDE_AND_CONQUER_DP};
-
-  // Save current graph state
-  auto savedNodes = nodes;
-  auto savedEdges = edges;
-
-  for (int sizeIdx = 0; sizeIdx < SCALABILITY_NUM_SIZES; ++sizeIdx) {
-    int N = SCALABILITY_SIZES[sizeIdx];
-    std::cout << "[Complexity] Testing N=" << N << "..." << std::endl;
-
-    // Generate a fresh graph of size N
-    ClearGraph();
-    for (int i = 0; i < N; ++i) {
-      AddNode(Vec2(0, 0));
-    }
-    // Build cycle edges
-    for (int i = 0; i < N; ++i) {
-      AddEdge(i, (i + 1) % N);
-    }
-    // Add some chord edges for complexity
-    std::mt19937 rng(42 + N); // Deterministic seed per size for fairness
-    int chords = std::max(1, N / 3);
-    for (int c = 0; c < chords; ++c) {
-      int a = rng() % N;
-      int b = rng() % N;
-      if (a != b && std::abs(a - b) > 1 && !(a == 0 && b == N - 1) &&
-          !(b == 0 && a == N - 1)) {
-        // Check if edge already exists
-        bool exists = false;
-        for (const auto &e : edges) {
-          if ((e.u_id == a && e.v_id == b) || (e.u_id == b && e.v_id == a)) {
-            exists = true;
-            break;
-          }
-        }
-        if (!exists) {
-          AddEdge(a, b);
-        }
-      }
-    }
-    GeneratePlanarLayout();
-    ApplyCircleScramble();
-    // Apply tangled positions
-    for (size_t i = 0; i < nodes.size(); ++i) {
-      nodes[i].position = targetPositions[i];
-    }
-
-    int initialIntersections = CountIntersections(nodes, edges);
-    if (initialIntersections == 0) {
-      // Graph isn't tangled enough, still record zero times
-      for (SolverMode mode : modes) {
-        auto solver = CreateSolver(mode);
-        ScalabilityDataPoint dp;
-        dp.solverName = solver->GetName();
-        dp.nodeCount = N;
-        dp.timeMs = 0;
-        dp.moves = 0;
-        dp.solved = true;
-        scalabilityResults_.push_back(dp);
-      }
-      continue;
-    }
-
-    // Snapshot the tangled graph
-    std::vector<Node> snapshotNodes = nodes;
-    std::vector<Edge> snapshotEdges = edges;
-
-    for (SolverMode mode : modes) {
-
-      auto solver = CreateSolver(mode);
-      ScalabilityDataPoint dp;
-      dp.solverName = solver->GetName();
-      dp.nodeCount = N;
-
-      // Clone graph for this solver
-      std::vector<Node> solverNodes = snapshotNodes;
-      int currentCount = initialIntersections;
-
-      auto startTime = std::chrono::steady_clock::now();
-
-      for (int moveNum = 0; moveNum < SCALABILITY_MAX_MOVES; ++moveNum) {
-        auto now = std::chrono::steady_clock::now();
-        float elapsed = std::chrono::duration<float>(now - startTime).count();
-        if (elapsed >= SCALABILITY_MAX_TIME)
-          break;
-        if (currentCount == 0)
-          break;
-
-        CPUMove move = solver->FindBestMove(solverNodes, snapshotEdges);
-        if (!move.isValid() || move.intersection_reduction <= 0)
-          break;
-
-        solverNodes[move.node_id].position = move.to_position;
-        currentCount = CountIntersections(solverNodes, snapshotEdges);
-        ++dp.moves;
-      }
+  ScalabilityConfig config;
+  config.minNodes = SCALABILITY_MIN_NODES;
+  config.maxNodes = SCALABILITY_MAX_NODES;
+  config.maxMoves = SCALABILITY_MAX_MOVES;
+  config.trialTimeLimit = SCALABILITY_MAX_TIME;
+  config.sweepTimeLimit = SCALABILITY_SWEEP_MAX_TIME;
+  config.seeds.clear();
+  for (int s = 1; s <= SCALABILITY_SEEDS; ++s) {
+    config.seeds.push_back(static_cast<uint32_t>(s));
+  }
+  scalabilityCancelFlag_.store(false);
+  config.cancelFlag = &scalabilityCancelFlag_;
 
-      auto endTime = std::chrono::steady_clock::now();
-      dp.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      endTime - startTime)
-                      .count();
-      dp.solved = (currentCount == 0);
+  scalabilityReport_ = ScalabilityReport();
+  GT_LOG_INFO("Complexity", "Starting empirical complexity analysis: N={}..{}, {} seeds per size on {} workers...",
+              config.minNodes, config.maxNodes, config.seeds.size(),
+              threadPool_->GetThreadCount());
 
-      std::cout << "[Complexity] " << dp.solverName << " N=" << N << ": "
-                << dp.moves << " moves, " << dp.timeMs << "ms"
-                << (dp.solved ? " (SOLVED)" : "") << std::endl;
+  ScalabilityAnalysis analysis(*threadPool_);
+  ScalabilityReport report = analysis.Run(config);
 
-      scalabilityResults_.push_back(dp);
-    }
+  if (ScalabilityAnalysis::WriteCSV(report, SCALABILITY_CSV_PATH) &&
+      ScalabilityAnalysis::WriteJSON(report, SCALABILITY_JSON_PATH)) {
+    GT_LOG_INFO("Complexity", "Wrote {} and {}", SCALABILITY_CSV_PATH,
+                SCALABILITY_JSON_PATH);
+  } else {
+    GT_LOG_ERROR("Complexity", "Failed to export results to {} / {}",
+                 SCALABILITY_CSV_PATH, SCALABILITY_JSON_PATH);
   }
 
-  // Restore original graph state
-  nodes = savedNodes;
-  edges = savedEdges;
-
-  std::cout << "[Complexity] Complete. Showing results." << std::endl;
+  GT_LOG_INFO("Complexity", "Complete in {}ms ({} trials{}). Showing results.",
+              report.sweepMs, report.trials.size(),
+              report.cutShort ? ", time budget reached" : "");
+  scalabilityReport_ = std::move(report);
 }
 
 void GameEngine::HandleScalabilityInput(const SDL_Event &event) {
@@ -4510,9 +5058,20 @@ void GameEngine::RenderScalabilityResults() {
   int winW, winH;
   SDL_GetWindowSize(window, &winW, &winH);
 
-  if (scalabilityResults_.empty())
+  const ScalabilityReport &report = scalabilityReport_;
+  if (report.points.empty() || report.sizes.empty())
     return;
 
+  // A new report invalidates the layer when the analysis finishes
+  SDL_Rect bounds = {0, 0, winW, winH};
+  RetainedLayer::Key key;
+  key.Add(winW).Add(winH).Add(menuBar != nullptr);
+  scalabilityLayer_.Draw(renderer, bounds, key,
+                         [&] { PaintScalabilityResults(winW, winH, report); });
+}
+
+void GameEngine::PaintScalabilityResults(int winW, int winH,
+                                         const ScalabilityReport &report) {
   // Background
   SDL_SetRenderDrawColor(renderer, 20, 20, 25, 255);
   SDL_RenderClear(renderer);
@@ -4520,8 +5079,9 @@ void GameEngine::RenderScalabilityResults() {
   // Title
   if (menuBar) {
     SDL_Rect titleRect = {0, 30, winW, 40};
-    menuBar->RenderTextCentered("Complexity Analysis: Runtime vs Graph Size",
-                                titleRect, {255, 255, 255, 255});
+    menuBar->RenderTextCentered(
+        "Complexity Analysis: Time per Move vs Graph Size (log-log)",
+        titleRect, {255, 255, 255, 255});
   }
 
   // Chart area
@@ -4540,50 +5100,66 @@ void GameEngine::RenderScalabilityResults() {
   SDL_SetRenderDrawColor(renderer, 60, 60, 80, 255);
   SDL_RenderDrawRect(renderer, &chartBg);
 
-  // Find max time for Y-axis scaling
-  int64_t maxTime = 1;
-  for (const auto &dp : scalabilityResults_) {
-    maxTime = std::max(maxTime, dp.timeMs);
-  }
-  // Round up to nice number
-  int64_t yMax = maxTime;
-  if (yMax < 10) yMax = 10;
-  else if (yMax < 100) yMax = ((yMax / 10) + 1) * 10;
-  else if (yMax < 1000) yMax = ((yMax / 100) + 1) * 100;
-  else yMax = ((yMax / 1000) + 1) * 1000;
+  // Log-log axes: a power law N^k shows up as a straight line of slope k.
+  // The Y range snaps to whole decades around the measured medians.
+  double minMs = 0.0;
+  double maxMs = 0.0;
+  for (const auto &point : report.points) {
+    double ms = point.msPerMove.median;
+    if (ms <= 0.0)
+      continue;
+    minMs = (minMs == 0.0) ? ms : std::min(minMs, ms);
+    maxMs = std::max(maxMs, ms);
+  }
+  if (maxMs <= 0.0) {
+    minMs = 0.1;
+    maxMs = 1.0;
+  }
+  int decadeLow = static_cast<int>(std::floor(std::log10(minMs)));
+  int decadeHigh = static_cast<int>(std::ceil(std::log10(maxMs)));
+  if (decadeHigh <= decadeLow)
+    decadeHigh = decadeLow + 1;
+
+  double logNMin = std::log(static_cast<double>(report.sizes.front()));
+  double logNMax = std::log(static_cast<double>(report.sizes.back()));
+  if (logNMax <= logNMin)
+    logNMax = logNMin + 1.0;
+
+  auto toX = [&](double n) {
+    return chartLeft + static_cast<int>((std::log(n) - logNMin) /
+                                        (logNMax - logNMin) * chartWidth);
+  };
+  auto toY = [&](double ms) {
+    double t = (std::log10(ms) - decadeLow) / (decadeHigh - decadeLow);
+    int y = chartBottom - static_cast<int>(t * chartHeight);
+    return std::max(chartTop, std::min(chartBottom, y));
+  };
 
-  // Draw grid lines
-  int numGridLines = 5;
-  SDL_SetRenderDrawColor(renderer, 40, 40, 55, 255);
-  for (int i = 0; i <= numGridLines; ++i) {
-    int y = chartBottom - (i * chartHeight / numGridLines);
+  // Horizontal grid line per decade
+  for (int decade = decadeLow; decade <= decadeHigh; ++decade) {
+    double ms = std::pow(10.0, decade);
+    int y = toY(ms);
+    SDL_SetRenderDrawColor(renderer, 40, 40, 55, 255);
     SDL_RenderDrawLine(renderer, chartLeft, y, chartRight, y);
 
     // Y-axis label
     if (menuBar) {
-      int64_t val = (yMax * i) / numGridLines;
-      std::string label;
-      if (yMax >= 1000) {
-        label = std::to_string(val / 1000) + "." +
-                std::to_string((val % 1000) / 100) + "s";
-      } else {
-        label = std::to_string(val) + "ms";
-      }
       SDL_Rect labelRect = {chartLeft - 90, y - 8, 80, 16};
-      menuBar->RenderTextCentered(label, labelRect, {150, 150, 170, 255});
+      menuBar->RenderTextCentered(FormatMs(ms), labelRect,
+                                  {150, 150, 170, 255});
     }
   }
 
-  // Draw vertical grid lines for each N value
-  for (int i = 0; i < SCALABILITY_NUM_SIZES; ++i) {
-    int x = chartLeft + (i * chartWidth) / (SCALABILITY_NUM_SIZES - 1);
+  // Vertical grid line per ladder size
+  for (int n : report.sizes) {
+    int x = toX(n);
     SDL_SetRenderDrawColor(renderer, 40, 40, 55, 255);
     SDL_RenderDrawLine(renderer, x, chartTop, x, chartBottom);
 
     // X-axis label
     if (menuBar) {
-      std::string label = "N=" + std::to_string(SCALABILITY_SIZES[i]);
-      SDL_Rect labelRect = {x - 25, chartBottom + 5, 50, 16};
+      std::string label = "N=" + std::to_string(n);
+      SDL_Rect labelRect = {x - 30, chartBottom + 5, 60, 16};
       menuBar->RenderTextCentered(label, labelRect, {150, 150, 170, 255});
     }
   }
@@ -4594,83 +5170,64 @@ void GameEngine::RenderScalabilityResults() {
       {255, 165, 0, 255},   // Orange - Backtracking
       {100, 180, 255, 255}  // Blue - D&C+DP
   };
-  std::string solverNames[] = {"Greedy", "Backtracking", "D&C + DP"};
-
-  // Group data by solver
-  for (int s = 0; s < 3; ++s) {
-    SDL_Color color = solverColors[s];
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  auto colorFor = [&](SolverMode mode) {
+    switch (mode) {
+    case SolverMode::BACKTRACKING:
+      return solverColors[1];
+    case SolverMode::DIVIDE_AND_CONQUER_DP:
+      return solverColors[2];
+    default:
+      return solverColors[0];
+    }
+  };
 
-    // Collect data points for this solver
-    std::vector<std::pair<int, int64_t>> points; // (sizeIdx, timeMs)
-    for (const auto &dp : scalabilityResults_) {
-      if (dp.solverName == solverNames[s]) {
-        // Find size index
-        for (int i = 0; i < SCALABILITY_NUM_SIZES; ++i) {
-          if (SCALABILITY_SIZES[i] == dp.nodeCount) {
-            points.emplace_back(i, dp.timeMs);
-            break;
-          }
+  auto drawDot = [&](int x, int y, bool filled) {
+    for (int dy = -4; dy <= 4; ++dy) {
+      for (int dx = -4; dx <= 4; ++dx) {
+        int d2 = dx * dx + dy * dy;
+        if (filled ? d2 <= 16 : (d2 <= 16 && d2 >= 9)) {
+          SDL_RenderDrawPoint(renderer, x + dx, y + dy);
         }
       }
     }
+  };
 
-    // Draw connecting lines (thick: 3 pixel offsets)
-    for (size_t i = 1; i < points.size(); ++i) {
-      int x1 =
-          chartLeft + (points[i - 1].first * chartWidth) / (SCALABILITY_NUM_SIZES - 1);
-      int y1 = chartBottom -
-               static_cast<int>((static_cast<double>(points[i - 1].second) /
-                                 static_cast<double>(yMax)) *
-                                chartHeight);
-      int x2 =
-          chartLeft + (points[i].first * chartWidth) / (SCALABILITY_NUM_SIZES - 1);
-      int y2 = chartBottom -
-               static_cast<int>((static_cast<double>(points[i].second) /
-                                 static_cast<double>(yMax)) *
-                                chartHeight);
-
-      // Clamp to chart area
-      y1 = std::max(chartTop, std::min(chartBottom, y1));
-      y2 = std::max(chartTop, std::min(chartBottom, y2));
-
-      // Draw thick line (3 offsets)
-      for (int offset = -1; offset <= 1; ++offset) {
-        SDL_RenderDrawLine(renderer, x1, y1 + offset, x2, y2 + offset);
+  for (const SolverScaling &scaling : report.solvers) {
+    SDL_Color color = colorFor(scaling.mode);
+
+    // Fitted power law across the sizes it was fitted on (thin line)
+    if (scaling.perMove.IsValid()) {
+      double nLo = 0.0;
+      double nHi = 0.0;
+      for (const auto &point : report.points) {
+        if (point.mode != scaling.mode || point.tooSlow)
+          continue;
+        nLo = (nLo == 0.0) ? point.nodeCount : std::min<double>(nLo, point.nodeCount);
+        nHi = std::max<double>(nHi, point.nodeCount);
       }
+      SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 140);
+      SDL_RenderDrawLine(renderer, toX(nLo), toY(scaling.perMove.Predict(nLo)),
+                         toX(nHi), toY(scaling.perMove.Predict(nHi)));
     }
 
-    // Draw data points (filled circles)
-    for (const auto &pt : points) {
-      int x =
-          chartLeft + (pt.first * chartWidth) / (SCALABILITY_NUM_SIZES - 1);
-      int y = chartBottom -
-              static_cast<int>((static_cast<double>(pt.second) /
-                                static_cast<double>(yMax)) *
-                               chartHeight);
-      y = std::max(chartTop, std::min(chartBottom, y));
-
-      // Draw filled circle (radius 4)
-      for (int dy = -4; dy <= 4; ++dy) {
-        for (int dx = -4; dx <= 4; ++dx) {
-          if (dx * dx + dy * dy <= 16) {
-            SDL_RenderDrawPoint(renderer, x + dx, y + dy);
-          }
-        }
-      }
-
-      // Draw time label near each point
-      if (menuBar) {
-        std::string timeStr;
-        if (pt.second >= 1000) {
-          timeStr = std::to_string(pt.second / 1000) + "." +
-                    std::to_string((pt.second % 1000) / 100) + "s";
-        } else {
-          timeStr = std::to_string(pt.second) + "ms";
+    // Median per ladder size; hollow where some trial hit the time limit
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    int prevX = -1;
+    int prevY = -1;
+    for (const auto &point : report.points) {
+      if (point.mode != scaling.mode || point.msPerMove.median <= 0.0)
+        continue;
+      int x = toX(point.nodeCount);
+      int y = toY(point.msPerMove.median);
+      if (prevX >= 0) {
+        // Draw thick line (3 offsets)
+        for (int offset = -1; offset <= 1; ++offset) {
+          SDL_RenderDrawLine(renderer, prevX, prevY + offset, x, y + offset);
         }
-        SDL_Rect labelRect = {x - 20, y - 18, 40, 14};
-        menuBar->RenderTextCentered(timeStr, labelRect, color);
       }
+      drawDot(x, y, !point.censored);
+      prevX = x;
+      prevY = y;
     }
   }
 
@@ -4687,20 +5244,31 @@ void GameEngine::RenderScalabilityResults() {
 
     // Y-axis label (rendered horizontally due to SDL limitations)
     SDL_Rect yLabel = {5, chartTop + chartHeight / 2 - 10, 80, 20};
-    menuBar->RenderTextCentered("Runtime", yLabel, {200, 200, 210, 255});
+    menuBar->RenderTextCentered("ms / move", yLabel, {200, 200, 210, 255});
+
+    std::string exportNote = "Exported to " + std::string(SCALABILITY_CSV_PATH) +
+                             " and " + SCALABILITY_JSON_PATH;
+    if (report.cutShort) {
+      exportNote += "  (time budget reached)";
+    }
+    SDL_Rect noteRect = {0, chartBottom + 45, winW, 16};
+    menuBar->RenderTextCentered(exportNote, noteRect, {110, 110, 130, 255});
   }
 
-  // Legend
-  int legendX = chartRight - 200;
+  // Legend: fitted exponent with its 95% confidence interval
+  int legendW = 380;
+  int legendX = chartLeft + 15;
   int legendY = chartTop + 10;
-  SDL_Rect legendBg = {legendX - 5, legendY - 5, 195, 80};
+  int legendRows = static_cast<int>(report.solvers.size());
+  SDL_Rect legendBg = {legendX - 5, legendY - 5, legendW, legendRows * 22 + 14};
   SDL_SetRenderDrawColor(renderer, 30, 30, 40, 220);
   SDL_RenderFillRect(renderer, &legendBg);
   SDL_SetRenderDrawColor(renderer, 80, 80, 100, 255);
   SDL_RenderDrawRect(renderer, &legendBg);
 
-  for (int s = 0; s < 3; ++s) {
-    SDL_Color color = solverColors[s];
+  for (int s = 0; s < legendRows; ++s) {
+    const SolverScaling &scaling = report.solvers[s];
+    SDL_Color color = colorFor(scaling.mode);
     int ly = legendY + s * 22;
 
     // Color swatch line
@@ -4709,18 +5277,23 @@ void GameEngine::RenderScalabilityResults() {
       SDL_RenderDrawLine(renderer, legendX + 5, ly + 8 + offset,
                          legendX + 30, ly + 8 + offset);
     }
-    // Dot
-    for (int dy = -3; dy <= 3; ++dy) {
-      for (int dx = -3; dx <= 3; ++dx) {
-        if (dx * dx + dy * dy <= 9) {
-          SDL_RenderDrawPoint(renderer, legendX + 17 + dx, ly + 8 + dy);
-        }
-      }
-    }
+    drawDot(legendX + 17, ly + 8, true);
 
     if (menuBar) {
-      SDL_Rect nameRect = {legendX + 35, ly, 150, 16};
-      menuBar->RenderTextCentered(solverNames[s], nameRect, color);
+      std::ostringstream text;
+      text << scaling.solverName << ": ";
+      if (scaling.perMove.IsValid()) {
+        text << std::fixed << std::setprecision(2) << "N^"
+             << scaling.perMove.exponent << " [" << scaling.perMove.ciLow
+             << ", " << scaling.perMove.ciHigh << "]";
+      } else {
+        text << "too few sizes to fit";
+      }
+      if (scaling.largestCompleted > 0) {
+        text << ", done to N=" << scaling.largestCompleted;
+      }
+      SDL_Rect nameRect = {legendX + 35, ly, legendW - 45, 16};
+      menuBar->RenderTextCentered(text.str(), nameRect, color);
     }
   }
 
@@ -4813,6 +5386,14 @@ void GameEngine::RenderHowItWorks() {
   int winW, winH;
   SDL_GetWindowSize(window, &winW, &winH);
 
+  SDL_Rect bounds = {0, 0, winW, winH};
+  RetainedLayer::Key key;
+  key.Add(winW).Add(winH).Add(howItWorksTab_).Add(menuBar != nullptr);
+  howItWorksLayer_.Draw(renderer, bounds, key,
+                        [&] { PaintHowItWorks(winW, winH); });
+}
+
+void GameEngine::PaintHowItWorks(int winW, int winH) {
   // Background
   SDL_SetRenderDrawColor(renderer, 20, 20, 25, 255);
   SDL_RenderClear(renderer);
@@ -5057,6 +5638,24 @@ void GameEngine::RenderHowItWorks() {
   }
 }
 
+void GameEngine::SubscribeComputingLogs() {
+  {
+    std::lock_guard<std::mutex> lock(logMutex_);
+    computingLogs_.clear();
+  }
+
+  UnsubscribeComputingLogs();
+  logSubscription_ = Logger::Instance().Subscribe(
+      [this](LogLevel, const std::string &line) { this->PushLog(line); });
+}
+
+void GameEngine::UnsubscribeComputingLogs() {
+  if (logSubscription_ != 0) {
+    Logger::Instance().Unsubscribe(logSubscription_);
+    logSubscription_ = 0;
+  }
+}
+
 void GameEngine::PushLog(const std::string& message) {
   std::lock_guard<std::mutex> lock(logMutex_);
   if (!message.empty()) {
@@ -5065,6 +5664,7 @@ void GameEngine::PushLog(const std::string& message) {
       computingLogs_.erase(computingLogs_.begin());
     }
   }
+  frameScheduler_.MarkDirty(FrameScheduler::DIRTY_LOGS);
 }
 
 void GameEngine::RenderComputingScreen(const std::string& title) {
@@ -5115,39 +5715,23 @@ void GameEngine::RenderComputingScreen(const std::string& title) {
 }
 
 void GameEngine::StartComputingBenchmark() {
+  StopReplayCompletion();
   currentPhase = GamePhase::COMPUTING_BENCHMARK;
-  {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    computingLogs_.clear();
-  }
-  
-  if (logRedirector_) {
-    delete static_cast<StreamRedirector*>(logRedirector_);
-  }
-  logRedirector_ = new StreamRedirector(std::cout, [this](const std::string& msg) {
-      this->PushLog(msg);
-  });
-  
-  backgroundTask_ = std::async(std::launch::async, [this]() {
+  SubscribeComputingLogs();
+
+  backgroundTask_ = threadPool_->Submit([this]() {
+      GT_TRACE_SCOPE("RunBenchmark", "job");
       this->RunBenchmark();
   });
 }
 
 void GameEngine::StartComputingScalability() {
+  StopReplayCompletion();
   currentPhase = GamePhase::COMPUTING_SCALABILITY;
-  {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    computingLogs_.clear();
-  }
-  
-  if (logRedirector_) {
-    delete static_cast<StreamRedirector*>(logRedirector_);
-  }
-  logRedirector_ = new StreamRedirector(std::cout, [this](const std::string& msg) {
-      this->PushLog(msg);
-  });
-  
-  backgroundTask_ = std::async(std::launch::async, [this]() {
+  SubscribeComputingLogs();
+
+  backgroundTask_ = threadPool_->Submit([this]() {
+      GT_TRACE_SCOPE("RunScalabilityTest", "job");
       this->RunScalabilityTest();
   });
 }
@@ -1,9 +1,12 @@
 #include "GreedySolver.hpp"
+#include "CrossingValidator.hpp"
+#include "Logger.hpp"
 #include "MathUtils.hpp"
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
-#include <iostream>
 #include <limits>
 
 namespace GreedyTangle {
@@ -11,9 +14,17 @@ namespace GreedyTangle {
 CPUMove GreedySolver::FindBestMove(std::vector<Node> nodes,
                                    const std::vector<Edge> &edges) {
   auto start_time = std::chrono::steady_clock::now();
-
-  int current_intersections = CountIntersections(nodes, edges);
+  GT_TRACE_SCOPE("Greedy::FindBestMove", "solver");
+  ScopedPhaseTimer search_timer(stats_.searchNs);
+  ScopedSearchAllocations search_allocations(stats_);
+  SolverStats::Add(stats_.calls);
+  arena_.Reset();
+  canvas_ = SolverCanvas(nodes, MARGIN);
+  gridSpacing_ = GridSpacingFor(canvas_, GRID_SPACING);
+
+  int current_intersections = CountCrossings(nodes, edges);
   lastCandidatesEvaluated_ = 0;
+  BeginProgress();
 
   CPUMove best_move;
   best_move.intersections_before = current_intersections;
@@ -23,41 +34,108 @@ CPUMove GreedySolver::FindBestMove(std::vector<Node> nodes,
     return best_move;
   }
 
-  for (size_t node_idx = 0; node_idx < nodes.size() && !IsCancelled(); ++node_idx) {
-    Vec2 original_position = nodes[node_idx].position;
+  // Best improving candidate per node. Nodes are scanned in parallel when a
+  // pool is attached and reduced in node order, so ties resolve exactly as
+  // in a serial scan.
+  struct NodeBest {
+    int reduction = 0;
+    int intersections_after = 0;
+    int evaluated = 0;
+    Vec2 position;
+  };
+  std::pmr::vector<NodeBest> per_node(nodes.size(), &arena_);
+  std::atomic<int> evaluated_so_far{0};
+
+  // One candidate buffer per thread, sized once for the largest node
+  size_t max_degree = 0;
+  for (const Node &node : nodes) {
+    max_degree = std::max(max_degree, node.adjacencyList.size());
+  }
+  size_t max_candidates = GridCandidates() + 9 * max_degree + edges.size() + 1;
+  size_t slots = threadPool_ ? threadPool_->GetThreadCount() + 1 : 1;
+  std::pmr::vector<std::pmr::vector<Vec2>> candidate_buffers(slots, &arena_);
+  for (auto &buffer : candidate_buffers) {
+    buffer.reserve(max_candidates);
+  }
 
-    std::vector<Vec2> candidates =
-        GenerateCandidatePositions(static_cast<int>(node_idx), nodes);
+  auto evaluate_node = [&](size_t node_idx) {
+    if (IsCancelled()) return;
+    NodeBest &result = per_node[node_idx];
+
+    std::pmr::vector<Vec2> &candidates =
+        candidate_buffers[threadPool_ ? threadPool_->CurrentThreadSlot() : 0];
+    {
+      GT_TRACE_SCOPE("GenerateCandidates", "solver");
+      ScopedPhaseTimer generation_timer(stats_.generationNs);
+      GenerateCandidatePositions(static_cast<int>(node_idx), nodes, candidates);
+    }
 
+    GT_TRACE_SCOPE("EvaluateCandidates", "solver");
+    ScopedPhaseTimer evaluation_timer(stats_.evaluationNs);
     for (const Vec2 &candidate : candidates) {
       if (IsCancelled()) break;
-      ++lastCandidatesEvaluated_;
+      ++result.evaluated;
+      SolverStats::Add(stats_.candidatesEvaluated);
 
       int new_intersections = CountIntersectionsWithMove(
           nodes, edges, static_cast<int>(node_idx), candidate);
 
       int reduction = current_intersections - new_intersections;
 
-      if (reduction > best_reduction) {
-        best_reduction = reduction;
-        best_move.node_id = static_cast<int>(node_idx);
-        best_move.from_position = original_position;
-        best_move.to_position = candidate;
-        best_move.intersections_after = new_intersections;
-        best_move.intersection_reduction = reduction;
+      if (reduction > result.reduction) {
+        result.reduction = reduction;
+        result.position = candidate;
+        result.intersections_after = new_intersections;
+
+        CPUMove improvement;
+        improvement.node_id = static_cast<int>(node_idx);
+        improvement.from_position = nodes[node_idx].position;
+        improvement.to_position = candidate;
+        improvement.intersections_before = current_intersections;
+        improvement.intersections_after = new_intersections;
+        improvement.intersection_reduction = reduction;
+        PublishImprovement(improvement);
       }
     }
+
+    PublishProgress(evaluated_so_far.fetch_add(result.evaluated) +
+                    result.evaluated);
+  };
+
+  if (threadPool_) {
+    threadPool_->ParallelFor(0, nodes.size(), evaluate_node);
+  } else {
+    for (size_t node_idx = 0; node_idx < nodes.size(); ++node_idx) {
+      evaluate_node(node_idx);
+    }
+  }
+
+  for (size_t node_idx = 0; node_idx < nodes.size(); ++node_idx) {
+    const NodeBest &result = per_node[node_idx];
+    lastCandidatesEvaluated_ += result.evaluated;
+
+    if (result.reduction > best_reduction) {
+      best_reduction = result.reduction;
+      best_move.node_id = static_cast<int>(node_idx);
+      best_move.from_position = nodes[node_idx].position;
+      best_move.to_position = result.position;
+      best_move.intersections_after = result.intersections_after;
+      best_move.intersection_reduction = result.reduction;
+    }
   }
 
   if (best_reduction == 0) {
+    GT_TRACE_SCOPE("Fallback", "solver");
+    ScopedPhaseTimer fallback_timer(stats_.fallbackNs);
     float max_min_distance = 0.0f;
+    std::pmr::vector<Vec2> &candidates = candidate_buffers[0];
 
     for (size_t node_idx = 0; node_idx < nodes.size(); ++node_idx) {
       Vec2 original_position = nodes[node_idx].position;
-      std::vector<Vec2> candidates =
-          GenerateCandidatePositions(static_cast<int>(node_idx), nodes);
+      GenerateCandidatePositions(static_cast<int>(node_idx), nodes, candidates);
 
       for (const Vec2 &candidate : candidates) {
+        SolverStats::Add(stats_.candidatesEvaluated);
         int new_intersections = CountIntersectionsWithMove(
             nodes, edges, static_cast<int>(node_idx), candidate);
 
@@ -93,25 +171,26 @@ CPUMove GreedySolver::FindBestMove(std::vector<Node> nodes,
           .count();
 
   if (best_move.isValid()) {
-    std::cout << "[Greedy] Found move: Node " << best_move.node_id << " -> ("
-              << best_move.to_position.x << ", " << best_move.to_position.y
-              << ") reduction=" << best_move.intersection_reduction
-              << " time=" << best_move.computation_time_ms << "ms" << std::endl;
+    GT_LOG_INFO("Greedy", "Found move: Node {} -> ({}, {}) reduction={} time={}ms",
+                best_move.node_id, best_move.to_position.x,
+                best_move.to_position.y, best_move.intersection_reduction,
+                best_move.computation_time_ms);
   } else {
-    std::cout << "[Greedy] No valid move found (stuck in local minimum)"
-              << std::endl;
+    GT_LOG_INFO("Greedy", "No valid move found (stuck in local minimum)");
   }
 
   return best_move;
 }
 
-std::vector<Vec2>
-GreedySolver::GenerateCandidatePositions(int node_id,
-                                         const std::vector<Node> &nodes) {
-  std::vector<Vec2> candidates;
+void GreedySolver::GenerateCandidatePositions(
+    int node_id, const std::vector<Node> &nodes,
+    std::pmr::vector<Vec2> &candidates) {
+  candidates.clear();
 
-  for (float x = MARGIN; x <= WINDOW_WIDTH - MARGIN; x += GRID_SPACING) {
-    for (float y = MARGIN; y <= WINDOW_HEIGHT - MARGIN; y += GRID_SPACING) {
+  for (float x = canvas_.minX + MARGIN; x <= canvas_.maxX - MARGIN;
+       x += gridSpacing_) {
+    for (float y = canvas_.minY + MARGIN; y <= canvas_.maxY - MARGIN;
+         y += gridSpacing_) {
       candidates.emplace_back(x, y);
     }
   }
@@ -128,22 +207,13 @@ GreedySolver::GenerateCandidatePositions(int node_id,
         for (int i = 0; i < 8; ++i) {
           float angle = 2.0f * M_PI * static_cast<float>(i) / 8.0f;
           Vec2 offset(std::cos(angle) * radius, std::sin(angle) * radius);
-          Vec2 candidate = neighbor_pos + offset;
-
-          candidate.x =
-              std::max(MARGIN, std::min(WINDOW_WIDTH - MARGIN, candidate.x));
-          candidate.y =
-              std::max(MARGIN, std::min(WINDOW_HEIGHT - MARGIN, candidate.y));
-
-          candidates.push_back(candidate);
+          candidates.push_back(ClampToCanvas(neighbor_pos + offset));
         }
 
         // Midpoint between target and neighbor
         Vec2 midpoint((target.position.x + neighbor_pos.x) * 0.5f,
                       (target.position.y + neighbor_pos.y) * 0.5f);
-        midpoint.x = std::max(MARGIN, std::min(WINDOW_WIDTH - MARGIN, midpoint.x));
-        midpoint.y = std::max(MARGIN, std::min(WINDOW_HEIGHT - MARGIN, midpoint.y));
-        candidates.push_back(midpoint);
+        candidates.push_back(ClampToCanvas(midpoint));
       }
     }
 
@@ -153,9 +223,7 @@ GreedySolver::GenerateCandidatePositions(int node_id,
         if (b > static_cast<int>(a) && b < static_cast<int>(nodes.size())) {
           Vec2 mid((nodes[a].position.x + nodes[b].position.x) * 0.5f,
                    (nodes[a].position.y + nodes[b].position.y) * 0.5f);
-          mid.x = std::max(MARGIN, std::min(WINDOW_WIDTH - MARGIN, mid.x));
-          mid.y = std::max(MARGIN, std::min(WINDOW_HEIGHT - MARGIN, mid.y));
-          candidates.push_back(mid);
+          candidates.push_back(ClampToCanvas(mid));
         }
       }
     }
@@ -175,18 +243,39 @@ GreedySolver::GenerateCandidatePositions(int node_id,
       candidates.push_back(centroid);
     }
   }
+}
+
+size_t GreedySolver::GridCandidates() const {
+  auto pointsAlong = [&](float extent) {
+    return static_cast<size_t>((extent - 2 * MARGIN) / gridSpacing_) + 1;
+  };
+  return pointsAlong(canvas_.Width()) * pointsAlong(canvas_.Height());
+}
 
-  return candidates;
+Vec2 GreedySolver::ClampToCanvas(Vec2 position) const {
+  position.x = std::max(canvas_.minX + MARGIN,
+                        std::min(canvas_.maxX - MARGIN, position.x));
+  position.y = std::max(canvas_.minY + MARGIN,
+                        std::min(canvas_.maxY - MARGIN, position.y));
+  return position;
 }
 
-int GreedySolver::CountIntersectionsWithMove(std::vector<Node> nodes,
+int GreedySolver::CountIntersectionsWithMove(const std::vector<Node> &nodes,
                                              const std::vector<Edge> &edges,
                                              int node_id, Vec2 new_position) {
-  if (node_id >= 0 && node_id < static_cast<int>(nodes.size())) {
-    nodes[node_id].position = new_position;
+  if (node_id < 0 || node_id >= static_cast<int>(nodes.size())) {
+    return CountCrossings(nodes, edges);
   }
 
-  return CountIntersections(nodes, edges);
+  uint64_t e = edges.size();
+  if (e > 1) {
+    SolverStats::Add(stats_.pairTests, e * (e - 1) / 2);
+  }
+  int count = GreedyTangle::CountIntersectionsWithMove(nodes, edges, node_id,
+                                                       new_position);
+  GT_VALIDATE_CROSSINGS("with-move", count, nodes, edges, node_id,
+                        new_position);
+  return count;
 }
 
 }
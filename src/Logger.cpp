@@ -0,0 +1,217 @@
+#include "Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+namespace GreedyTangle {
+
+namespace {
+
+// How long the drain thread sleeps when the ring is empty. Producers never
+// signal it, so this bounds the latency from Log() to the console.
+constexpr auto IDLE_POLL = std::chrono::milliseconds(5);
+
+} // namespace
+
+Logger &Logger::Instance() {
+  static Logger logger;
+  return logger;
+}
+
+Logger::Logger() {
+  for (size_t i = 0; i < CAPACITY; ++i) {
+    records_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  drainThread_ = std::thread([this]() { DrainLoop(); });
+}
+
+Logger::~Logger() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    stopping_ = true;
+  }
+  wakeCv_.notify_one();
+  if (drainThread_.joinable()) {
+    drainThread_.join();
+  }
+}
+
+Logger::Record *Logger::Claim() {
+  size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  for (;;) {
+    Record &record = records_[pos & (CAPACITY - 1)];
+    size_t sequence = record.sequence.load(std::memory_order_acquire);
+    intptr_t diff =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+        return &record;
+      }
+    } else if (diff < 0) {
+      return nullptr; // Full: drop rather than wait for the drain thread
+    } else {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void Logger::Publish(Record &record) {
+  size_t pos = record.sequence.load(std::memory_order_relaxed);
+  record.sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool Logger::DrainOne(std::string &line, LogLevel &level) {
+  Record &record = records_[dequeuePos_ & (CAPACITY - 1)];
+  size_t sequence = record.sequence.load(std::memory_order_acquire);
+  if (sequence != dequeuePos_ + 1) {
+    return false;
+  }
+  level = record.level;
+  line.clear();
+  Format(record, line);
+  record.sequence.store(dequeuePos_ + CAPACITY, std::memory_order_release);
+  ++dequeuePos_;
+  return true;
+}
+
+void Logger::Format(const Record &record, std::string &out) {
+  std::ostringstream oss;
+  if (record.tag) {
+    oss << '[' << record.tag << "] ";
+  }
+
+  size_t next = 0;
+  const char *p = record.format ? record.format : "";
+  while (*p) {
+    if (p[0] == '{' && p[1] == '{') {
+      oss << '{';
+      p += 2;
+      continue;
+    }
+    if (p[0] == '}' && p[1] == '}') {
+      oss << '}';
+      p += 2;
+      continue;
+    }
+    if (p[0] != '{') {
+      oss << *p++;
+      continue;
+    }
+
+    // "{}" or "{:.Nf}"
+    const char *close = p + 1;
+    while (*close && *close != '}') {
+      ++close;
+    }
+    if (!*close) {
+      oss << p;
+      break;
+    }
+    int precision = -1;
+    if (p[1] == ':' && p[2] == '.') {
+      precision = std::atoi(p + 3);
+    }
+    p = close + 1;
+
+    if (next >= record.argCount) {
+      oss << "{?}";
+      continue;
+    }
+    const Arg &arg = record.args[next++];
+    switch (arg.type) {
+    case ArgType::INT:
+      oss << arg.i;
+      break;
+    case ArgType::UINT:
+      oss << arg.u;
+      break;
+    case ArgType::BOOL:
+      oss << (arg.u ? "true" : "false");
+      break;
+    case ArgType::DOUBLE:
+      if (precision >= 0) {
+        oss << std::fixed << std::setprecision(precision) << arg.d
+            << std::defaultfloat << std::setprecision(6);
+      } else {
+        oss << arg.d;
+      }
+      break;
+    case ArgType::TEXT:
+      oss.write(record.text.data() + arg.text.offset, arg.text.length);
+      break;
+    }
+  }
+  out = oss.str();
+}
+
+void Logger::DrainLoop() {
+  std::string line;
+  uint64_t reportedDropped = 0;
+  for (;;) {
+    size_t drained = 0;
+    LogLevel level;
+    while (DrainOne(line, level)) {
+      std::FILE *stream = level >= LogLevel::WARN ? stderr : stdout;
+      std::fputs(line.c_str(), stream);
+      std::fputc('\n', stream);
+      {
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        for (auto &[id, subscriber] : subscribers_) {
+          subscriber(level, line);
+        }
+      }
+      ++drained;
+      written_.fetch_add(1, std::memory_order_release);
+    }
+
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped) {
+      std::fprintf(stderr, "[Logger] Ring full, dropped %llu message(s)\n",
+                   static_cast<unsigned long long>(dropped - reportedDropped));
+      reportedDropped = dropped;
+    }
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    if (drained > 0) {
+      // One flush per batch instead of std::endl per line
+      std::fflush(stdout);
+      flushedCv_.notify_all();
+      continue;
+    }
+    if (stopping_) {
+      return;
+    }
+    wakeCv_.wait_for(lock, IDLE_POLL);
+  }
+}
+
+int Logger::Subscribe(Subscriber subscriber) {
+  std::lock_guard<std::mutex> lock(subscriberMutex_);
+  int id = nextSubscriberId_++;
+  subscribers_.emplace_back(id, std::move(subscriber));
+  return id;
+}
+
+void Logger::Unsubscribe(int id) {
+  std::lock_guard<std::mutex> lock(subscriberMutex_);
+  for (auto it = subscribers_.begin(); it != subscribers_.end(); ++it) {
+    if (it->first == id) {
+      subscribers_.erase(it);
+      return;
+    }
+  }
+}
+
+void Logger::Flush() {
+  uint64_t target = enqueuePos_.load(std::memory_order_acquire);
+  std::unique_lock<std::mutex> lock(wakeMutex_);
+  wakeCv_.notify_one();
+  flushedCv_.wait(lock, [&]() {
+    return written_.load(std::memory_order_acquire) >= target;
+  });
+}
+
+} // namespace GreedyTangle
@@ -1,9 +1,11 @@
 #include "MenuBar.hpp"
-#include <iostream>
+#include "Logger.hpp"
+#include <algorithm>
 
 namespace GreedyTangle {
 
 MenuBar::~MenuBar() {
+  textCache.Clear(); // Before the font its glyph atlas was built from
   if (font) {
     TTF_CloseFont(font);
     font = nullptr;
@@ -12,9 +14,10 @@ MenuBar::~MenuBar() {
 
 bool MenuBar::Init(SDL_Renderer *rend, const std::string &fontPath) {
   renderer = rend;
+  textCache.Init(renderer);
 
   if (TTF_Init() == -1) {
-    std::cerr << "[MenuBar] TTF_Init failed: " << TTF_GetError() << std::endl;
+    GT_LOG_ERROR("MenuBar", "TTF_Init failed: {}", TTF_GetError());
     return false;
   }
 
@@ -69,13 +72,13 @@ bool MenuBar::Init(SDL_Renderer *rend, const std::string &fontPath) {
       continue;
     font = TTF_OpenFont(path.c_str(), 13);
     if (font) {
-      std::cout << "[MenuBar] Loaded font: " << path << std::endl;
+      GT_LOG_INFO("MenuBar", "Loaded font: {}", path);
       break;
     }
   }
 
   if (!font) {
-    std::cerr << "[MenuBar] Could not load any font!" << std::endl;
+    GT_LOG_ERROR("MenuBar", "Could not load any font!");
     return false;
   }
 
@@ -240,12 +243,34 @@ void MenuBar::CloseAllMenus() {
 }
 
 void MenuBar::Render() {
+  int windowWidth;
+  SDL_GetRendererOutputSize(renderer, &windowWidth, nullptr);
+
+  // The bar plus any open dropdown; repainted on hover, open or check
+  SDL_Rect bounds = {0, 0, windowWidth, BAR_HEIGHT};
+  RetainedLayer::Key key;
+  key.Add(windowWidth).Add(hoveredMenuIndex).Add(hoveredItemIndex);
+  for (const Menu &menu : menus) {
+    key.Add(menu.isOpen);
+    for (const MenuItem &item : menu.items) {
+      key.Add(item.isChecked);
+    }
+    if (menu.isOpen) {
+      int right = menu.dropdownRect.x + menu.dropdownRect.w + 1;
+      int bottom = menu.dropdownRect.y + menu.dropdownRect.h + 1;
+      bounds.w = std::max(bounds.w, right);
+      bounds.h = std::max(bounds.h, bottom);
+    }
+  }
+
+  layer.Draw(renderer, bounds, key, [&] { Paint(windowWidth); });
+}
+
+void MenuBar::Paint(int windowWidth) {
   // Draw bar background
   SDL_SetRenderDrawColor(renderer, Colors::BAR_BG.r, Colors::BAR_BG.g,
                          Colors::BAR_BG.b, Colors::BAR_BG.a);
 
-  int windowWidth;
-  SDL_GetRendererOutputSize(renderer, &windowWidth, nullptr);
   SDL_Rect barRect = {0, 0, windowWidth, BAR_HEIGHT};
   SDL_RenderFillRect(renderer, &barRect);
 
@@ -272,19 +297,9 @@ void MenuBar::Render() {
 
     // Render text
     if (font) {
-      SDL_Surface *surface =
-          TTF_RenderText_Blended(font, menu.title.c_str(), Colors::TEXT);
-      if (surface) {
-        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-        if (texture) {
-          int textX = menu.titleRect.x + PADDING;
-          int textY = (BAR_HEIGHT - surface->h) / 2;
-          SDL_Rect dst = {textX, textY, surface->w, surface->h};
-          SDL_RenderCopy(renderer, texture, nullptr, &dst);
-          SDL_DestroyTexture(texture);
-        }
-        SDL_FreeSurface(surface);
-      }
+      int textHeight = textCache.Measure(font, menu.title).h;
+      textCache.Draw(font, menu.title, Colors::TEXT,
+                     menu.titleRect.x + PADDING, (BAR_HEIGHT - textHeight) / 2);
     }
   }
 
@@ -338,37 +353,17 @@ void MenuBar::RenderDropdown(const Menu &menu) {
     // Checkmark
     if (item.isCheckable && item.isChecked) {
       if (font) {
-        SDL_Surface *checkSurf =
-            TTF_RenderText_Blended(font, "✓", Colors::CHECKMARK);
-        if (checkSurf) {
-          SDL_Texture *checkTex =
-              SDL_CreateTextureFromSurface(renderer, checkSurf);
-          if (checkTex) {
-            SDL_Rect checkDst = {menu.dropdownRect.x + 8, y + 3, checkSurf->w,
-                                 checkSurf->h};
-            SDL_RenderCopy(renderer, checkTex, nullptr, &checkDst);
-            SDL_DestroyTexture(checkTex);
-          }
-          SDL_FreeSurface(checkSurf);
-        }
+        textCache.Draw(font, "✓", Colors::CHECKMARK, menu.dropdownRect.x + 8,
+                       y + 3);
       }
     }
 
     // Item text
     if (font) {
-      SDL_Surface *surface =
-          TTF_RenderText_Blended(font, item.text.c_str(), Colors::TEXT);
-      if (surface) {
-        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-        if (texture) {
-          int textX = menu.dropdownRect.x + (item.isCheckable ? 28 : 12);
-          int textY = y + (ITEM_HEIGHT - surface->h) / 2;
-          SDL_Rect dst = {textX, textY, surface->w, surface->h};
-          SDL_RenderCopy(renderer, texture, nullptr, &dst);
-          SDL_DestroyTexture(texture);
-        }
-        SDL_FreeSurface(surface);
-      }
+      int textX = menu.dropdownRect.x + (item.isCheckable ? 28 : 12);
+      int textHeight = textCache.Measure(font, item.text).h;
+      textCache.Draw(font, item.text, Colors::TEXT, textX,
+                     y + (ITEM_HEIGHT - textHeight) / 2);
     }
 
     y += ITEM_HEIGHT;
@@ -389,16 +384,7 @@ void MenuBar::RenderText(const std::string &text, int x, int y,
   if (!font || !renderer)
     return;
 
-  SDL_Surface *surface = TTF_RenderText_Blended(font, text.c_str(), color);
-  if (surface) {
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (texture) {
-      SDL_Rect dst = {x, y, surface->w, surface->h};
-      SDL_RenderCopy(renderer, texture, nullptr, &dst);
-      SDL_DestroyTexture(texture);
-    }
-    SDL_FreeSurface(surface);
-  }
+  textCache.Draw(font, text, color, x, y);
 }
 
 void MenuBar::RenderTextCentered(const std::string &text, SDL_Rect rect,
@@ -406,18 +392,8 @@ void MenuBar::RenderTextCentered(const std::string &text, SDL_Rect rect,
   if (!font || !renderer)
     return;
 
-  SDL_Surface *surface = TTF_RenderText_Blended(font, text.c_str(), color);
-  if (surface) {
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (texture) {
-      int x = rect.x + (rect.w - surface->w) / 2;
-      int y = rect.y + (rect.h - surface->h) / 2;
-      SDL_Rect dst = {x, y, surface->w, surface->h};
-      SDL_RenderCopy(renderer, texture, nullptr, &dst);
-      SDL_DestroyTexture(texture);
-    }
-    SDL_FreeSurface(surface);
-  }
+  textCache.Draw(font, text, color, rect.x + rect.w / 2, rect.y + rect.h / 2,
+                 TextCache::Align::CENTER);
 }
 
 } // namespace GreedyTangle
@@ -0,0 +1,541 @@
+#include "AllocationTracker.hpp"
+#include "BacktrackingSolver.hpp"
+#include "CPUController.hpp"
+#include "CrossingTracker.hpp"
+#include "DnCDPSolver.hpp"
+#include "GreedySolver.hpp"
+#include "MathUtils.hpp"
+#include "PuzzleGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * greedy_tangle_microbench - Isolated timings of the geometry, candidate
+ * generation, partitioning and export kernels
+ *
+ * Every kernel runs on fixed seeded inputs at several sizes. A kernel is
+ * repeated until one batch takes at least --min-time, then timed over
+ * several batches; the median batch is reported as ns/op together with
+ * segment pairs tested per second and heap allocations per op.
+ */
+
+// Allocation counter. Only the measuring thread counts, so the logger's
+// drain thread does not leak into the numbers. Builds with allocation
+// tracking already replace operator new, so read the tracker's count.
+namespace {
+
+#if GREEDY_TANGLE_ALLOC_TRACKING
+uint64_t ThreadAllocations() {
+  return GreedyTangle::AllocationTracker::ThreadAllocations();
+}
+#else
+thread_local uint64_t tlsAllocations = 0;
+
+uint64_t ThreadAllocations() { return tlsAllocations; }
+#endif
+
+} // namespace
+
+#if !GREEDY_TANGLE_ALLOC_TRACKING
+void *operator new(std::size_t size) {
+  ++tlsAllocations;
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+#endif
+
+namespace GreedyTangle {
+
+/**
+ * MicrobenchAccess - Friend of the solvers, exposing their private kernels
+ */
+struct MicrobenchAccess {
+  using Partition = DnCDPSolver::Partition;
+
+  // Each call resets the solver's arena, as FindBestMove does, so kernels
+  // return sizes or owned copies rather than arena-backed containers
+
+  // A copy on the default resource; moving or copy-eliding a Partition
+  // keeps its indices in the arena the next call resets
+  static Partition Owned(const Partition &partition) {
+    Partition owned;
+    owned.nodeIndices.assign(partition.nodeIndices.begin(),
+                             partition.nodeIndices.end());
+    owned.xMin = partition.xMin;
+    owned.xMax = partition.xMax;
+    owned.yMin = partition.yMin;
+    owned.yMax = partition.yMax;
+    return owned;
+  }
+
+  static size_t GreedyCandidates(GreedySolver &solver, int nodeId,
+                                 const std::vector<Node> &nodes) {
+    solver.arena_.Reset();
+    std::pmr::vector<Vec2> candidates(&solver.arena_);
+    solver.GenerateCandidatePositions(nodeId, nodes, candidates);
+    return candidates.size();
+  }
+
+  static size_t BacktrackingCandidates(BacktrackingSolver &solver, int nodeId,
+                                       const std::vector<Node> &nodes) {
+    solver.arena_.Reset();
+    std::pmr::vector<Vec2> candidates(&solver.arena_);
+    solver.GenerateCandidatePositions(nodeId, nodes, candidates);
+    return candidates.size();
+  }
+
+  static Partition FullPartition(DnCDPSolver &solver,
+                                 const std::vector<Node> &nodes) {
+    solver.arena_.Reset();
+    std::pmr::vector<int> indices(nodes.size(), &solver.arena_);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      indices[i] = static_cast<int>(i);
+    }
+    return Owned(solver.CreatePartition(std::move(indices), nodes));
+  }
+
+  static size_t DPCandidates(DnCDPSolver &solver,
+                             const Partition &partition) {
+    solver.arena_.Reset();
+    return solver.GenerateDPCandidates(partition).size();
+  }
+
+  static size_t SplitPartition(DnCDPSolver &solver, const Partition &partition,
+                               const std::vector<Node> &nodes) {
+    solver.arena_.Reset();
+    auto halves = solver.SplitPartition(partition, nodes);
+    return halves.first.nodeIndices.size();
+  }
+
+  static Partition LeftHalf(DnCDPSolver &solver, const Partition &partition,
+                            const std::vector<Node> &nodes) {
+    solver.arena_.Reset();
+    return Owned(solver.SplitPartition(partition, nodes).first);
+  }
+
+  static CPUMove SolveDP(DnCDPSolver &solver, std::vector<Node> &nodes,
+                         const std::vector<Edge> &edges,
+                         const Partition &partition) {
+    solver.arena_.Reset();
+    return solver.SolveDP(nodes, edges, partition);
+  }
+};
+
+} // namespace GreedyTangle
+
+using namespace GreedyTangle;
+
+namespace {
+
+// One timed unit: run() performs itemsPerRun ops and returns the number of
+// segment pairs it tested (0 if the kernel tests none)
+struct Workload {
+  std::function<uint64_t()> run;
+  uint64_t itemsPerRun = 1;
+};
+
+struct Kernel {
+  std::string name;
+  std::vector<int> sizes;
+  std::function<Workload(int size)> setup;
+};
+
+struct Result {
+  std::string name;
+  int size = 0;
+  uint64_t iterations = 0; // Runs per timed batch
+  double nsPerOp = 0.0;    // Median batch
+  double nsMin = 0.0;
+  double nsMax = 0.0;
+  double pairsPerSecond = 0.0;
+  double allocsPerOp = 0.0;
+};
+
+struct Options {
+  double minTimeMs = 100.0;
+  int repetitions = 5;
+  std::string filter;
+  std::string format = "table";
+};
+
+volatile uint64_t gSink = 0; // Keeps results observable to the optimizer
+
+constexpr uint32_t SEED = 1;
+constexpr int SEGMENT_POOL = 1024;
+
+Puzzle MakePuzzle(int nodeCount) {
+  return GeneratePuzzle(PuzzleFamily::CYCLE_CHORDS, nodeCount, SEED);
+}
+
+uint64_t PairCount(size_t edges) {
+  return edges > 1 ? static_cast<uint64_t>(edges) * (edges - 1) / 2 : 0;
+}
+
+std::vector<Vec2> RandomPoints(size_t count, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> x(0.0f, 1024.0f);
+  std::uniform_real_distribution<float> y(0.0f, 768.0f);
+  std::vector<Vec2> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    points.emplace_back(x(gen), y(gen));
+  }
+  return points;
+}
+
+std::vector<Kernel> BuildKernels() {
+  const std::vector<int> graphSizes = {16, 64, 256, 1024};
+  std::vector<Kernel> kernels;
+
+  kernels.push_back({"CheckIntersection", {SEGMENT_POOL}, [](int size) {
+    auto points = std::make_shared<std::vector<Vec2>>(
+        RandomPoints(static_cast<size_t>(size) * 4, SEED));
+    Workload w;
+    w.itemsPerRun = static_cast<uint64_t>(size);
+    w.run = [points, size]() {
+      const std::vector<Vec2> &p = *points;
+      uint64_t hits = 0;
+      for (int i = 0; i < size; ++i) {
+        hits += CheckIntersection(p[4 * i], p[4 * i + 1], p[4 * i + 2],
+                                  p[4 * i + 3]);
+      }
+      gSink = gSink + hits;
+      return static_cast<uint64_t>(size);
+    };
+    return w;
+  }});
+
+  kernels.push_back({"PointToSegmentDistance", {SEGMENT_POOL}, [](int size) {
+    auto points = std::make_shared<std::vector<Vec2>>(
+        RandomPoints(static_cast<size_t>(size) * 3, SEED + 1));
+    Workload w;
+    w.itemsPerRun = static_cast<uint64_t>(size);
+    w.run = [points, size]() {
+      const std::vector<Vec2> &p = *points;
+      float total = 0.0f;
+      for (int i = 0; i < size; ++i) {
+        total += PointToSegmentDistance(p[3 * i], p[3 * i + 1], p[3 * i + 2]);
+      }
+      gSink = gSink + static_cast<uint64_t>(total);
+      return uint64_t{0};
+    };
+    return w;
+  }});
+
+  kernels.push_back({"CountIntersections", graphSizes, [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    Workload w;
+    w.run = [puzzle]() {
+      gSink = gSink + CountIntersections(puzzle->nodes, puzzle->edges);
+      return PairCount(puzzle->edges.size());
+    };
+    return w;
+  }});
+
+  // One frame of a drag: a single node moved since the last Update
+  kernels.push_back({"CrossingTracker::Update (drag)", graphSizes,
+                     [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    auto tracker = std::make_shared<CrossingTracker>();
+    tracker->Update(puzzle->nodes, puzzle->edges);
+    Workload w;
+    w.run = [puzzle, tracker, step = 0]() mutable {
+      Vec2 &position = puzzle->nodes[0].position;
+      position.x += (++step % 2) ? 3.0f : -3.0f;
+      gSink = gSink + tracker->Update(puzzle->nodes, puzzle->edges);
+      return tracker->LastPairTests();
+    };
+    return w;
+  }});
+
+  kernels.push_back({"Greedy::GenerateCandidatePositions", graphSizes,
+                     [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    auto solver = std::make_shared<GreedySolver>();
+    Workload w;
+    w.run = [puzzle, solver, next = 0]() mutable {
+      next = (next + 1) % static_cast<int>(puzzle->nodes.size());
+      gSink = gSink +
+              MicrobenchAccess::GreedyCandidates(*solver, next, puzzle->nodes);
+      return uint64_t{0};
+    };
+    return w;
+  }});
+
+  kernels.push_back({"Backtracking::GenerateCandidatePositions", graphSizes,
+                     [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    auto solver = std::make_shared<BacktrackingSolver>();
+    Workload w;
+    w.run = [puzzle, solver, next = 0]() mutable {
+      next = (next + 1) % static_cast<int>(puzzle->nodes.size());
+      gSink = gSink + MicrobenchAccess::BacktrackingCandidates(*solver, next,
+                                                               puzzle->nodes);
+      return uint64_t{0};
+    };
+    return w;
+  }});
+
+  kernels.push_back({"DnCDP::GenerateDPCandidates", graphSizes, [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    auto solver = std::make_shared<DnCDPSolver>();
+    auto partition = std::make_shared<MicrobenchAccess::Partition>(
+        MicrobenchAccess::FullPartition(*solver, puzzle->nodes));
+    Workload w;
+    w.run = [solver, partition]() {
+      gSink = gSink + MicrobenchAccess::DPCandidates(*solver, *partition);
+      return uint64_t{0};
+    };
+    return w;
+  }});
+
+  kernels.push_back({"DnCDP::SplitPartition", graphSizes, [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    auto solver = std::make_shared<DnCDPSolver>();
+    auto partition = std::make_shared<MicrobenchAccess::Partition>(
+        MicrobenchAccess::FullPartition(*solver, puzzle->nodes));
+    Workload w;
+    w.run = [puzzle, solver, partition]() {
+      gSink = gSink + MicrobenchAccess::SplitPartition(*solver, *partition,
+                                                       puzzle->nodes);
+      return uint64_t{0};
+    };
+    return w;
+  }});
+
+  // SolveDP scores every candidate with a full recount, so it is only
+  // sampled on small graphs (the left half of the first split)
+  kernels.push_back({"DnCDP::SolveDP", {16, 64}, [](int size) {
+    auto puzzle = std::make_shared<Puzzle>(MakePuzzle(size));
+    auto solver = std::make_shared<DnCDPSolver>();
+    auto partition = std::make_shared<MicrobenchAccess::Partition>(
+        MicrobenchAccess::LeftHalf(
+            *solver, MicrobenchAccess::FullPartition(*solver, puzzle->nodes),
+            puzzle->nodes));
+    auto nodes = std::make_shared<std::vector<Node>>(puzzle->nodes);
+    Workload w;
+    w.run = [puzzle, solver, partition, nodes]() {
+      uint64_t before = solver->GetStats().Snapshot().pairTests;
+      CPUMove move =
+          MicrobenchAccess::SolveDP(*solver, *nodes, puzzle->edges, *partition);
+      gSink = gSink + static_cast<uint64_t>(move.node_id + 1);
+      return solver->GetStats().Snapshot().pairTests - before;
+    };
+    return w;
+  }});
+
+  // Size is the number of recorded moves on a 64-node match
+  kernels.push_back({"ReplayLogger::ExportJSON", {10, 100, 1000}, [](int size) {
+    Puzzle puzzle = MakePuzzle(64);
+    auto logger = std::make_shared<ReplayLogger>();
+    logger->StartMatch(puzzle.nodes, puzzle.edges,
+                       CountIntersections(puzzle.nodes, puzzle.edges));
+    std::mt19937 gen(SEED);
+    std::uniform_int_distribution<int> nodeDist(0, 63);
+    std::vector<Vec2> targets = RandomPoints(static_cast<size_t>(size), SEED);
+    for (int i = 0; i < size; ++i) {
+      CPUMove move;
+      move.node_id = nodeDist(gen);
+      move.from_position = puzzle.nodes[move.node_id].position;
+      move.to_position = targets[i];
+      move.intersections_before = size - i;
+      move.intersections_after = size - i - 1;
+      move.intersection_reduction = 1;
+      move.computation_time_ms = i % 50;
+      logger->RecordMove(move);
+    }
+    Workload w;
+    w.run = [logger]() {
+      gSink = gSink + logger->ExportJSON().size();
+      return uint64_t{0};
+    };
+    return w;
+  }});
+
+  return kernels;
+}
+
+Result Measure(const Kernel &kernel, int size, const Options &options) {
+  Workload workload = kernel.setup(size);
+  workload.run(); // Warm caches and lazy state
+
+  using Clock = std::chrono::steady_clock;
+  auto timeBatch = [&](uint64_t iterations, uint64_t &pairs,
+                       uint64_t &allocations) {
+    uint64_t allocsBefore = ThreadAllocations();
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      pairs += workload.run();
+    }
+    auto end = Clock::now();
+    allocations += ThreadAllocations() - allocsBefore;
+    return std::chrono::duration<double, std::nano>(end - start).count();
+  };
+
+  // Grow the batch until it runs for at least minTime
+  const double minTimeNs = options.minTimeMs * 1e6;
+  uint64_t iterations = 1;
+  for (;;) {
+    uint64_t pairs = 0, allocations = 0;
+    double ns = timeBatch(iterations, pairs, allocations);
+    if (ns >= minTimeNs || iterations >= (uint64_t{1} << 32)) {
+      break;
+    }
+    double scale = ns > 0.0 ? minTimeNs / ns * 1.2 : 10.0;
+    iterations = std::max(iterations * 2,
+                          static_cast<uint64_t>(iterations * scale));
+  }
+
+  std::vector<double> perOp;
+  uint64_t pairs = 0, allocations = 0;
+  double totalNs = 0.0;
+  for (int r = 0; r < options.repetitions; ++r) {
+    double ns = timeBatch(iterations, pairs, allocations);
+    totalNs += ns;
+    perOp.push_back(ns / (iterations * workload.itemsPerRun));
+  }
+  std::sort(perOp.begin(), perOp.end());
+
+  Result result;
+  result.name = kernel.name;
+  result.size = size;
+  result.iterations = iterations;
+  result.nsPerOp = perOp[perOp.size() / 2];
+  result.nsMin = perOp.front();
+  result.nsMax = perOp.back();
+  double ops = static_cast<double>(iterations) * workload.itemsPerRun *
+               options.repetitions;
+  result.allocsPerOp = allocations / ops;
+  result.pairsPerSecond = totalNs > 0.0 ? pairs * 1e9 / totalNs : 0.0;
+  return result;
+}
+
+void PrintUsage() {
+  std::cout << "Usage: greedy_tangle_microbench [options]\n"
+            << "  --filter TEXT       only kernels whose name contains TEXT\n"
+            << "  --min-time MS       minimum batch duration (default 100)\n"
+            << "  --repetitions R     timed batches per kernel (default 5)\n"
+            << "  --format table|csv|json (default table)\n"
+            << "  --list              print kernel names and sizes\n"
+            << "  --help              show this message\n";
+}
+
+void PrintResult(const Result &r, const std::string &format, bool first) {
+  if (format == "csv") {
+    if (first) {
+      std::cout << "kernel,size,iterations,ns_per_op,ns_min,ns_max,"
+                   "pairs_per_sec,allocs_per_op\n";
+    }
+    std::cout << r.name << ',' << r.size << ',' << r.iterations << ','
+              << std::fixed << std::setprecision(2) << r.nsPerOp << ','
+              << r.nsMin << ',' << r.nsMax << ',' << std::setprecision(0)
+              << r.pairsPerSecond << ',' << std::setprecision(3)
+              << r.allocsPerOp << '\n';
+  } else if (format == "json") {
+    std::cout << (first ? "[\n" : ",\n") << "  {\"kernel\": \"" << r.name
+              << "\", \"size\": " << r.size
+              << ", \"iterations\": " << r.iterations << std::fixed
+              << std::setprecision(2) << ", \"nsPerOp\": " << r.nsPerOp
+              << ", \"nsMin\": " << r.nsMin << ", \"nsMax\": " << r.nsMax
+              << std::setprecision(0)
+              << ", \"pairsPerSecond\": " << r.pairsPerSecond
+              << std::setprecision(3) << ", \"allocsPerOp\": " << r.allocsPerOp
+              << "}";
+  } else {
+    if (first) {
+      std::cout << std::left << std::setw(42) << "kernel" << std::right
+                << std::setw(7) << "size" << std::setw(16) << "ns/op"
+                << std::setw(30) << "min..max" << std::setw(14) << "pairs/s"
+                << std::setw(12) << "allocs/op" << '\n';
+    }
+    std::ostringstream range;
+    range << std::fixed << std::setprecision(1) << r.nsMin << ".." << r.nsMax;
+    std::ostringstream pairs;
+    if (r.pairsPerSecond > 0.0) {
+      pairs << std::scientific << std::setprecision(2) << r.pairsPerSecond;
+    } else {
+      pairs << "-";
+    }
+    std::cout << std::left << std::setw(42) << r.name << std::right
+              << std::setw(7) << r.size << std::setw(16) << std::fixed
+              << std::setprecision(1) << r.nsPerOp << std::setw(30)
+              << range.str() << std::setw(14) << pairs.str() << std::setw(12)
+              << std::setprecision(2) << r.allocsPerOp << '\n';
+  }
+  std::cout.flush();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  bool listOnly = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      PrintUsage();
+      return 0;
+    }
+    if (arg == "--list") {
+      listOnly = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      return 2;
+    }
+    std::string value = argv[++i];
+    if (arg == "--filter") {
+      options.filter = value;
+    } else if (arg == "--min-time") {
+      options.minTimeMs = std::max(1.0, std::atof(value.c_str()));
+    } else if (arg == "--repetitions") {
+      options.repetitions = std::max(1, std::atoi(value.c_str()));
+    } else if (arg == "--format" &&
+               (value == "table" || value == "csv" || value == "json")) {
+      options.format = value;
+    } else {
+      std::cerr << "Unknown option: " << arg << " " << value << std::endl;
+      return 2;
+    }
+  }
+
+  bool first = true;
+  for (const Kernel &kernel : BuildKernels()) {
+    if (!options.filter.empty() &&
+        kernel.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    for (int size : kernel.sizes) {
+      if (listOnly) {
+        std::cout << kernel.name << ' ' << size << '\n';
+        continue;
+      }
+      PrintResult(Measure(kernel, size, options), options.format, first);
+      first = false;
+    }
+  }
+  if (options.format == "json" && !first) {
+    std::cout << "\n]\n";
+  }
+  return 0;
+}
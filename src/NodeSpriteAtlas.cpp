@@ -0,0 +1,235 @@
+#include "NodeSpriteAtlas.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace GreedyTangle {
+
+namespace {
+
+constexpr int GUTTER = 1; // Transparent texels around each sprite
+
+void SetTexel(SDL_Surface *surface, int x, int y) {
+  auto *row = static_cast<uint8_t *>(surface->pixels) + y * surface->pitch;
+  std::memset(row + x * 4, 0xFF, 4); // Opaque white in RGBA32
+}
+
+// Same scanlines as GameEngine::DrawFilledCircle
+void RasterizeDisc(SDL_Surface *surface, int ox, int oy, int radius) {
+  for (int y = -radius; y <= radius; ++y) {
+    int halfWidth = static_cast<int>(std::sqrt(radius * radius - y * y));
+    for (int x = -halfWidth; x <= halfWidth; ++x) {
+      SetTexel(surface, ox + radius + x, oy + radius + y);
+    }
+  }
+}
+
+// Same midpoint points as the border loop DrawNode used
+void RasterizeRing(SDL_Surface *surface, int ox, int oy, int radius) {
+  int cx = ox + radius;
+  int cy = oy + radius;
+  int x = radius, y = 0;
+  int radiusError = 1 - x;
+  while (x >= y) {
+    SetTexel(surface, cx + x, cy + y);
+    SetTexel(surface, cx + y, cy + x);
+    SetTexel(surface, cx - y, cy + x);
+    SetTexel(surface, cx - x, cy + y);
+    SetTexel(surface, cx - x, cy - y);
+    SetTexel(surface, cx - y, cy - x);
+    SetTexel(surface, cx + y, cy - x);
+    SetTexel(surface, cx + x, cy - y);
+
+    ++y;
+    if (radiusError < 0) {
+      radiusError += 2 * y + 1;
+    } else {
+      --x;
+      radiusError += 2 * (y - x + 1);
+    }
+  }
+}
+
+} // namespace
+
+NodeSpriteAtlas::~NodeSpriteAtlas() { Destroy(); }
+
+bool NodeSpriteAtlas::Init(SDL_Renderer *renderer) {
+  renderer_ = renderer;
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+  geometrySupported_ = false;
+#endif
+  return renderer_ != nullptr;
+}
+
+void NodeSpriteAtlas::Destroy() {
+  if (texture_) {
+    SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+  }
+  sprites_.clear();
+  queue_.clear();
+  renderer_ = nullptr;
+}
+
+const NodeSpriteAtlas::Sprite *NodeSpriteAtlas::FindSprite(int radius) {
+  for (const Sprite &sprite : sprites_) {
+    if (sprite.radius == radius) {
+      return &sprite;
+    }
+  }
+  // A new radius: the queue refers to sprites by index, so draw it with
+  // the old texture before that is replaced
+  Flush();
+
+  // Zooming walks through radii; make room by dropping the oldest one
+  if (static_cast<int>(sprites_.size()) >= MAX_RADII) {
+    sprites_.erase(sprites_.begin());
+  }
+  Sprite sprite;
+  sprite.radius = radius;
+  sprites_.push_back(sprite);
+  if (!Rasterize()) {
+    return nullptr;
+  }
+  return &sprites_.back();
+}
+
+bool NodeSpriteAtlas::Rasterize() {
+  // One column per radius: the disc on top, the ring below it
+  int width = 0;
+  int height = 0;
+  for (Sprite &sprite : sprites_) {
+    int size = 2 * sprite.radius + 1;
+    sprite.fill = {width + GUTTER, GUTTER, size, size};
+    sprite.border = {width + GUTTER, size + 3 * GUTTER, size, size};
+    width += size + 2 * GUTTER;
+    height = std::max(height, 2 * size + 4 * GUTTER);
+  }
+
+  SDL_Surface *surface =
+      SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                     SDL_PIXELFORMAT_RGBA32);
+  if (!surface) {
+    GT_LOG_WARN("Render", "Node atlas surface failed: {}", SDL_GetError());
+    failed_ = true;
+    return false;
+  }
+  for (int y = 0; y < height; ++y) {
+    std::memset(static_cast<uint8_t *>(surface->pixels) + y * surface->pitch,
+                0, static_cast<size_t>(width) * 4);
+  }
+  for (const Sprite &sprite : sprites_) {
+    RasterizeDisc(surface, sprite.fill.x, sprite.fill.y, sprite.radius);
+    RasterizeRing(surface, sprite.border.x, sprite.border.y, sprite.radius);
+  }
+
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer_, surface);
+  SDL_FreeSurface(surface);
+  if (!texture) {
+    GT_LOG_WARN("Render", "Node atlas texture failed: {}", SDL_GetError());
+    failed_ = true;
+    return false;
+  }
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+  if (texture_) {
+    SDL_DestroyTexture(texture_);
+  }
+  texture_ = texture;
+  textureWidth_ = width;
+  textureHeight_ = height;
+  return true;
+}
+
+bool NodeSpriteAtlas::Add(int cx, int cy, int radius, SDL_Color fill,
+                          SDL_Color border) {
+  if (!renderer_ || failed_ || radius < 0 || radius > MAX_RADIUS) {
+    return false;
+  }
+  const Sprite *sprite = FindSprite(radius);
+  if (!sprite) {
+    return false;
+  }
+  int index = static_cast<int>(sprite - sprites_.data());
+  queue_.push_back({cx - radius, cy - radius, index, fill, border});
+  return true;
+}
+
+void NodeSpriteAtlas::PushQuad(const SDL_Rect &src, int x, int y,
+                               SDL_Color color) {
+  float u0 = static_cast<float>(src.x) / textureWidth_;
+  float v0 = static_cast<float>(src.y) / textureHeight_;
+  float u1 = static_cast<float>(src.x + src.w) / textureWidth_;
+  float v1 = static_cast<float>(src.y + src.h) / textureHeight_;
+  float x0 = static_cast<float>(x);
+  float y0 = static_cast<float>(y);
+  float x1 = static_cast<float>(x + src.w);
+  float y1 = static_cast<float>(y + src.h);
+
+  vertices_.push_back({{x0, y0}, color, {u0, v0}});
+  vertices_.push_back({{x1, y0}, color, {u1, v0}});
+  vertices_.push_back({{x1, y1}, color, {u1, v1}});
+  vertices_.push_back({{x0, y1}, color, {u0, v1}});
+}
+
+void NodeSpriteAtlas::Flush() {
+  if (queue_.empty()) {
+    return;
+  }
+  if (!texture_) {
+    queue_.clear();
+    return;
+  }
+
+  if (geometrySupported_) {
+    vertices_.clear();
+    for (const Instance &instance : queue_) {
+      const Sprite &sprite = sprites_[instance.sprite];
+      PushQuad(sprite.fill, instance.x, instance.y, instance.fill);
+      PushQuad(sprite.border, instance.x, instance.y, instance.border);
+    }
+
+    size_t quads = vertices_.size() / 4;
+    for (size_t q = indices_.size() / 6; q < quads; ++q) {
+      int base = static_cast<int>(q * 4);
+      indices_.insert(indices_.end(),
+                      {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+
+    if (SDL_RenderGeometry(renderer_, texture_, vertices_.data(),
+                           static_cast<int>(vertices_.size()), indices_.data(),
+                           static_cast<int>(quads * 6)) == 0) {
+      queue_.clear();
+      return;
+    }
+    GT_LOG_WARN("Render", "SDL_RenderGeometry failed ({}), drawing nodes "
+                          "with SDL_RenderCopy",
+                SDL_GetError());
+    geometrySupported_ = false;
+  }
+
+  FlushCopies();
+}
+
+void NodeSpriteAtlas::FlushCopies() {
+  auto copy = [&](const SDL_Rect &src, int x, int y, SDL_Color color) {
+    SDL_SetTextureColorMod(texture_, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(texture_, color.a);
+    SDL_Rect dst = {x, y, src.w, src.h};
+    SDL_RenderCopy(renderer_, texture_, &src, &dst);
+  };
+
+  for (const Instance &instance : queue_) {
+    const Sprite &sprite = sprites_[instance.sprite];
+    copy(sprite.fill, instance.x, instance.y, instance.fill);
+    copy(sprite.border, instance.x, instance.y, instance.border);
+  }
+  SDL_SetTextureColorMod(texture_, 255, 255, 255);
+  SDL_SetTextureAlphaMod(texture_, 255);
+  queue_.clear();
+}
+
+} // namespace GreedyTangle
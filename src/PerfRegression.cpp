@@ -0,0 +1,661 @@
+#include "PerfRegression.hpp"
+#include "AllocationTracker.hpp"
+#include "BenchmarkRunner.hpp"
+#include "CrossingValidator.hpp"
+#include "Logger.hpp"
+#include "SolverFactory.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+// CMake passes the build's settings; other builds record them as unknown
+#ifndef GREEDY_TANGLE_BUILD_TYPE
+#define GREEDY_TANGLE_BUILD_TYPE ""
+#endif
+#ifndef GREEDY_TANGLE_COMPILER
+#define GREEDY_TANGLE_COMPILER "unknown"
+#endif
+#ifndef GREEDY_TANGLE_CXX_FLAGS
+#define GREEDY_TANGLE_CXX_FLAGS ""
+#endif
+
+namespace GreedyTangle {
+
+namespace {
+
+// Scales a MAD to a standard deviation for normally distributed noise
+constexpr double MAD_TO_SIGMA = 1.4826;
+
+double Median(std::vector<double> values) {
+  if (values.empty())
+    return 0.0;
+  std::sort(values.begin(), values.end());
+  size_t mid = values.size() / 2;
+  return values.size() % 2 ? values[mid]
+                           : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+/**
+ * JsonValue - Just enough JSON to read back the baselines we write
+ */
+struct JsonValue {
+  enum class Type { NONE, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+  Type type = Type::NONE;
+  bool boolean = false;
+  double number = 0.0;
+  std::string text;
+  std::vector<std::string> keys; // Objects only, parallel to items
+  std::vector<JsonValue> items;
+
+  const JsonValue *Find(const std::string &key) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] == key)
+        return &items[i];
+    }
+    return nullptr;
+  }
+};
+
+class JsonReader {
+public:
+  explicit JsonReader(std::string text) : text_(std::move(text)) {}
+
+  bool Parse(JsonValue &value, std::string &error) {
+    if (!ParseValue(value, 0)) {
+      error = error_;
+      return false;
+    }
+    SkipSpace();
+    if (pos_ != text_.size()) {
+      error = "Trailing characters at offset " + std::to_string(pos_);
+      return false;
+    }
+    return true;
+  }
+
+private:
+  static constexpr int MAX_DEPTH = 32;
+
+  bool Fail(const std::string &what) {
+    error_ = what + " at offset " + std::to_string(pos_);
+    return false;
+  }
+
+  void SkipSpace() {
+    while (pos_ < text_.size() &&
+           std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipSpace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool ParseValue(JsonValue &value, int depth) {
+    if (depth > MAX_DEPTH)
+      return Fail("Nesting too deep");
+    SkipSpace();
+    if (pos_ >= text_.size())
+      return Fail("Unexpected end of input");
+
+    char c = text_[pos_];
+    if (c == '{')
+      return ParseObject(value, depth);
+    if (c == '[')
+      return ParseArray(value, depth);
+    if (c == '"') {
+      value.type = JsonValue::Type::STRING;
+      return ParseString(value.text);
+    }
+    if (text_.compare(pos_, 4, "true") == 0 ||
+        text_.compare(pos_, 5, "false") == 0) {
+      value.type = JsonValue::Type::BOOLEAN;
+      value.boolean = (c == 't');
+      pos_ += value.boolean ? 4 : 5;
+      return true;
+    }
+    if (text_.compare(pos_, 4, "null") == 0) {
+      pos_ += 4;
+      return true;
+    }
+
+    const char *begin = text_.c_str() + pos_;
+    char *end = nullptr;
+    value.number = std::strtod(begin, &end);
+    if (end == begin)
+      return Fail("Unexpected character");
+    value.type = JsonValue::Type::NUMBER;
+    pos_ += static_cast<size_t>(end - begin);
+    return true;
+  }
+
+  bool ParseString(std::string &out) {
+    ++pos_; // Opening quote
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c == '\\') {
+        if (pos_ >= text_.size())
+          break;
+        char escaped = text_[pos_++];
+        switch (escaped) {
+        case 'n':
+          c = '\n';
+          break;
+        case 't':
+          c = '\t';
+          break;
+        case '"':
+        case '\\':
+        case '/':
+          c = escaped;
+          break;
+        default:
+          return Fail("Unsupported escape");
+        }
+      }
+      out.push_back(c);
+    }
+    if (pos_ >= text_.size())
+      return Fail("Unterminated string");
+    ++pos_; // Closing quote
+    return true;
+  }
+
+  bool ParseArray(JsonValue &value, int depth) {
+    value.type = JsonValue::Type::ARRAY;
+    ++pos_;
+    if (Consume(']'))
+      return true;
+    do {
+      value.items.emplace_back();
+      if (!ParseValue(value.items.back(), depth + 1))
+        return false;
+    } while (Consume(','));
+    return Consume(']') || Fail("Expected ']'");
+  }
+
+  bool ParseObject(JsonValue &value, int depth) {
+    value.type = JsonValue::Type::OBJECT;
+    ++pos_;
+    if (Consume('}'))
+      return true;
+    do {
+      SkipSpace();
+      if (pos_ >= text_.size() || text_[pos_] != '"')
+        return Fail("Expected a key");
+      value.keys.emplace_back();
+      if (!ParseString(value.keys.back()))
+        return false;
+      if (!Consume(':'))
+        return Fail("Expected ':'");
+      value.items.emplace_back();
+      if (!ParseValue(value.items.back(), depth + 1))
+        return false;
+    } while (Consume(','));
+    return Consume('}') || Fail("Expected '}'");
+  }
+
+  std::string text_;
+  size_t pos_ = 0;
+  std::string error_;
+};
+
+bool ReadNumber(const JsonValue &object, const std::string &key, double &out,
+                std::string &error) {
+  const JsonValue *value = object.Find(key);
+  if (!value || value->type != JsonValue::Type::NUMBER) {
+    error = "Missing number \"" + key + "\"";
+    return false;
+  }
+  out = value->number;
+  return true;
+}
+
+bool ReadInt(const JsonValue &object, const std::string &key, int &out,
+             std::string &error) {
+  double number = 0.0;
+  if (!ReadNumber(object, key, number, error))
+    return false;
+  out = static_cast<int>(number);
+  return true;
+}
+
+bool ReadSample(const JsonValue &object, const std::string &key,
+                MetricSample &out, std::string &error) {
+  const JsonValue *value = object.Find(key);
+  if (!value || value->type != JsonValue::Type::OBJECT) {
+    error = "Missing metric \"" + key + "\"";
+    return false;
+  }
+  return ReadNumber(*value, "median", out.median, error) &&
+         ReadNumber(*value, "mad", out.mad, error);
+}
+
+bool ReadString(const JsonValue &object, const std::string &key,
+                std::string &out, std::string &error) {
+  const JsonValue *value = object.Find(key);
+  if (!value || value->type != JsonValue::Type::STRING) {
+    error = "Missing string \"" + key + "\"";
+    return false;
+  }
+  out = value->text;
+  return true;
+}
+
+std::string JsonQuoted(const std::string &text) {
+  std::string quoted = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  return quoted + '"';
+}
+
+const JsonValue *FindArray(const JsonValue &object, const std::string &key,
+                           std::string &error) {
+  const JsonValue *value = object.Find(key);
+  if (!value || value->type != JsonValue::Type::ARRAY) {
+    error = "Missing array \"" + key + "\"";
+    return nullptr;
+  }
+  return value;
+}
+
+RegressionCheck Check(const std::string &solverName, const std::string &metric,
+                      bool higherIsBetter, const MetricSample &baseline,
+                      const MetricSample &current, double tolerance,
+                      double madMultiplier) {
+  RegressionCheck check;
+  check.solverName = solverName;
+  check.metric = metric;
+  check.higherIsBetter = higherIsBetter;
+  check.baseline = baseline.median;
+  check.current = current.median;
+
+  double noise =
+      MAD_TO_SIGMA * std::sqrt(baseline.mad * baseline.mad +
+                               current.mad * current.mad);
+  check.threshold =
+      std::max(tolerance * std::abs(baseline.median), madMultiplier * noise);
+
+  double worsening = higherIsBetter ? baseline.median - current.median
+                                    : current.median - baseline.median;
+  check.regressed = worsening > check.threshold;
+  check.improved = -worsening > check.threshold;
+  return check;
+}
+
+} // namespace
+
+MetricSample MetricSample::From(std::vector<double> values) {
+  MetricSample sample;
+  sample.median = Median(values);
+  for (double &v : values) {
+    v = std::abs(v - sample.median);
+  }
+  sample.mad = Median(std::move(values));
+  return sample;
+}
+
+std::vector<SolverPerf> PerfRegression::Measure(const RegressionCorpus &corpus) {
+  GT_TRACE_SCOPE("PerfRegression", "job");
+
+  size_t modeCount = corpus.entries.size();
+  std::vector<std::vector<Puzzle>> puzzles(modeCount);
+  std::vector<BenchmarkConfig> configs(modeCount);
+  for (size_t m = 0; m < modeCount; ++m) {
+    const CorpusEntry &entry = corpus.entries[m];
+    for (PuzzleFamily family : corpus.families) {
+      for (uint32_t seed : corpus.seeds) {
+        puzzles[m].push_back(GeneratePuzzle(family, entry.nodeCount, seed));
+      }
+    }
+    // Fixed work per trial: the move budget ends it, never the clock
+    configs[m].maxMoves = entry.maxMoves;
+    configs[m].trialTimeLimit = std::numeric_limits<float>::max();
+
+    // Warm caches and the allocator before anything is timed
+    if (!puzzles[m].empty()) {
+      BenchmarkRunner::RunTrial(entry.mode, puzzles[m].front(), configs[m]);
+    }
+  }
+
+  std::vector<SolverPerf> results(modeCount);
+  std::vector<std::vector<double>> latencies(modeCount);
+  std::vector<std::vector<double>> pairRates(modeCount);
+
+  // Repetitions are the outer loop so slow drift hits every solver alike
+  int repetitions = std::max(corpus.repetitions, 1);
+  for (int rep = 0; rep < repetitions; ++rep) {
+    for (size_t m = 0; m < modeCount; ++m) {
+      SolverPerf &perf = results[m];
+      double searchMs = 0.0;
+      uint64_t pairTests = 0;
+      int searches = 0;
+      int moves = 0;
+      int finalIntersections = 0;
+
+      for (const Puzzle &puzzle : puzzles[m]) {
+        BenchmarkTrial trial =
+            BenchmarkRunner::RunTrial(corpus.entries[m].mode, puzzle, configs[m]);
+        perf.solverName = trial.solverName;
+        searchMs += trial.searchMs;
+        pairTests += trial.pairTests;
+        searches += trial.searches;
+        moves += trial.moves;
+        finalIntersections += trial.finalIntersections;
+      }
+
+      perf.mode = corpus.entries[m].mode;
+      perf.searches = searches;
+      perf.moves = moves;
+      perf.finalIntersections = finalIntersections;
+      latencies[m].push_back(searches > 0 ? searchMs / searches : 0.0);
+      pairRates[m].push_back(searchMs > 0.0 ? pairTests / (searchMs / 1000.0)
+                                            : 0.0);
+      GT_LOG_VERBOSE("PerfRegression", "Pass {}/{} {}: {:.3f} ms/move",
+                     rep + 1, repetitions, perf.solverName,
+                     latencies[m].back());
+    }
+    GT_LOG_INFO("PerfRegression", "Corpus pass {}/{} done", rep + 1,
+                repetitions);
+  }
+
+  for (size_t m = 0; m < modeCount; ++m) {
+    results[m].msPerMove = MetricSample::From(std::move(latencies[m]));
+    results[m].pairTestsPerSecond = MetricSample::From(std::move(pairRates[m]));
+  }
+  return results;
+}
+
+RegressionResult PerfRegression::Compare(const PerfBaseline &baseline,
+                                         const std::vector<SolverPerf> &current,
+                                         double tolerance,
+                                         double madMultiplier) {
+  RegressionResult result;
+
+  for (const SolverPerf &base : baseline.solvers) {
+    auto it = std::find_if(current.begin(), current.end(),
+                           [&](const SolverPerf &p) { return p.mode == base.mode; });
+    if (it == current.end()) {
+      result.notes.push_back(base.solverName + ": in the baseline but not measured");
+      continue;
+    }
+
+    result.checks.push_back(Check(base.solverName, "ms/move", false,
+                                  base.msPerMove, it->msPerMove, tolerance,
+                                  madMultiplier));
+    result.checks.push_back(Check(base.solverName, "pair tests/s", true,
+                                  base.pairTestsPerSecond,
+                                  it->pairTestsPerSecond, tolerance,
+                                  madMultiplier));
+
+    if (it->moves != base.moves ||
+        it->finalIntersections != base.finalIntersections) {
+      std::ostringstream note;
+      note << base.solverName << ": corpus now ends at "
+           << it->finalIntersections << " crossings after " << it->moves
+           << " moves (baseline " << base.finalIntersections << " after "
+           << base.moves << "); the solver plays differently, so refresh the "
+           << "baseline if that was intended";
+      result.notes.push_back(note.str());
+    }
+  }
+
+  for (const SolverPerf &perf : current) {
+    bool known = std::any_of(
+        baseline.solvers.begin(), baseline.solvers.end(),
+        [&](const SolverPerf &b) { return b.mode == perf.mode; });
+    if (!known) {
+      result.notes.push_back(perf.solverName + ": no baseline, not checked");
+    }
+  }
+
+  result.passed = std::none_of(
+      result.checks.begin(), result.checks.end(),
+      [](const RegressionCheck &c) { return c.regressed; });
+  return result;
+}
+
+BuildConfig BuildConfig::Current() {
+  BuildConfig build;
+  build.buildType = GREEDY_TANGLE_BUILD_TYPE;
+  if (build.buildType.empty()) {
+    build.buildType = "None";
+  }
+  build.compiler = GREEDY_TANGLE_COMPILER;
+  build.flags = GREEDY_TANGLE_CXX_FLAGS;
+  build.options = std::string("tracing=") +
+                  (GREEDY_TANGLE_TRACING ? "on" : "off") +
+                  " alloc-tracking=" +
+                  (GREEDY_TANGLE_ALLOC_TRACKING ? "on" : "off") +
+                  " crossing-validation=" +
+                  (GREEDY_TANGLE_CROSSING_VALIDATION ? "on" : "off");
+  return build;
+}
+
+std::vector<std::string>
+PerfRegression::BuildMismatches(const BuildConfig &baseline,
+                                const BuildConfig &current) {
+  std::vector<std::string> mismatches;
+  auto compare = [&](const char *field, const std::string &recorded,
+                     const std::string &now) {
+    if (recorded != now) {
+      mismatches.push_back(std::string(field) + ": baseline \"" + recorded +
+                           "\", this build \"" + now + "\"");
+    }
+  };
+  compare("build type", baseline.buildType, current.buildType);
+  compare("compiler", baseline.compiler, current.compiler);
+  compare("flags", baseline.flags, current.flags);
+  compare("options", baseline.options, current.options);
+  return mismatches;
+}
+
+bool PerfRegression::WriteBaseline(const PerfBaseline &baseline,
+                                   std::ostream &out) {
+  const RegressionCorpus &corpus = baseline.corpus;
+  out << std::fixed << std::setprecision(4);
+
+  out << "{\n  \"corpus\": {\"solvers\": [";
+  for (size_t i = 0; i < corpus.entries.size(); ++i) {
+    const CorpusEntry &e = corpus.entries[i];
+    out << (i ? "," : "") << "\n    {\"solver\": \"" << SolverModeKey(e.mode)
+        << "\", \"nodes\": " << e.nodeCount
+        << ", \"maxMoves\": " << e.maxMoves << "}";
+  }
+  out << "],\n    \"families\": [";
+  for (size_t i = 0; i < corpus.families.size(); ++i) {
+    out << (i ? ", " : "") << '"' << PuzzleFamilyKey(corpus.families[i])
+        << '"';
+  }
+  out << "], \"seeds\": [";
+  for (size_t i = 0; i < corpus.seeds.size(); ++i) {
+    out << (i ? ", " : "") << corpus.seeds[i];
+  }
+  out << "], \"repetitions\": " << corpus.repetitions << "},\n";
+
+  const BuildConfig &build = baseline.build;
+  out << "  \"build\": {\"type\": " << JsonQuoted(build.buildType)
+      << ", \"compiler\": " << JsonQuoted(build.compiler)
+      << ",\n    \"flags\": " << JsonQuoted(build.flags)
+      << ", \"options\": " << JsonQuoted(build.options) << "},\n";
+
+  out << "  \"solvers\": [";
+  for (size_t i = 0; i < baseline.solvers.size(); ++i) {
+    const SolverPerf &p = baseline.solvers[i];
+    out << (i ? ",\n" : "\n") << "    {\"solver\": \"" << SolverModeKey(p.mode)
+        << "\", \"name\": \"" << p.solverName
+        << "\", \"searches\": " << p.searches << ", \"moves\": " << p.moves
+        << ", \"finalIntersections\": " << p.finalIntersections
+        << ",\n      \"msPerMove\": {\"median\": " << p.msPerMove.median
+        << ", \"mad\": " << p.msPerMove.mad
+        << "},\n      \"pairTestsPerSecond\": {\"median\": "
+        << p.pairTestsPerSecond.median
+        << ", \"mad\": " << p.pairTestsPerSecond.mad << "}}";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+bool PerfRegression::ReadBaseline(std::istream &in, PerfBaseline &baseline,
+                                  std::string &error) {
+  std::string text((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  JsonValue root;
+  JsonReader reader(std::move(text));
+  if (!reader.Parse(root, error))
+    return false;
+  if (root.type != JsonValue::Type::OBJECT) {
+    error = "Baseline is not a JSON object";
+    return false;
+  }
+
+  const JsonValue *corpusJson = root.Find("corpus");
+  if (!corpusJson || corpusJson->type != JsonValue::Type::OBJECT) {
+    error = "Missing object \"corpus\"";
+    return false;
+  }
+  RegressionCorpus &corpus = baseline.corpus;
+  const JsonValue *entries = FindArray(*corpusJson, "solvers", error);
+  const JsonValue *families = FindArray(*corpusJson, "families", error);
+  const JsonValue *seeds = FindArray(*corpusJson, "seeds", error);
+  if (!entries || !families || !seeds ||
+      !ReadInt(*corpusJson, "repetitions", corpus.repetitions, error)) {
+    return false;
+  }
+
+  corpus.entries.clear();
+  for (const JsonValue &entryJson : entries->items) {
+    CorpusEntry entry;
+    const JsonValue *key = entryJson.Find("solver");
+    if (!key || !SolverModeFromKey(key->text, entry.mode)) {
+      error = "Corpus entry without a known \"solver\" key";
+      return false;
+    }
+    if (!ReadInt(entryJson, "nodes", entry.nodeCount, error) ||
+        !ReadInt(entryJson, "maxMoves", entry.maxMoves, error)) {
+      return false;
+    }
+    corpus.entries.push_back(entry);
+  }
+  corpus.families.clear();
+  for (const JsonValue &key : families->items) {
+    PuzzleFamily family;
+    if (!PuzzleFamilyFromKey(key.text, family)) {
+      error = "Unknown family \"" + key.text + "\"";
+      return false;
+    }
+    corpus.families.push_back(family);
+  }
+  corpus.seeds.clear();
+  for (const JsonValue &seed : seeds->items) {
+    corpus.seeds.push_back(static_cast<uint32_t>(seed.number));
+  }
+
+  const JsonValue *buildJson = root.Find("build");
+  if (!buildJson || buildJson->type != JsonValue::Type::OBJECT) {
+    error = "Missing object \"build\"; record the baseline again with "
+            "--write-baseline";
+    return false;
+  }
+  BuildConfig &build = baseline.build;
+  if (!ReadString(*buildJson, "type", build.buildType, error) ||
+      !ReadString(*buildJson, "compiler", build.compiler, error) ||
+      !ReadString(*buildJson, "flags", build.flags, error) ||
+      !ReadString(*buildJson, "options", build.options, error)) {
+    error = "build: " + error;
+    return false;
+  }
+
+  const JsonValue *solvers = FindArray(root, "solvers", error);
+  if (!solvers)
+    return false;
+  baseline.solvers.clear();
+  for (const JsonValue &entry : solvers->items) {
+    SolverPerf perf;
+    const JsonValue *key = entry.Find("solver");
+    if (!key || !SolverModeFromKey(key->text, perf.mode)) {
+      error = "Solver entry without a known \"solver\" key";
+      return false;
+    }
+    const JsonValue *name = entry.Find("name");
+    perf.solverName = name ? name->text : SolverModeKey(perf.mode);
+    if (!ReadInt(entry, "searches", perf.searches, error) ||
+        !ReadInt(entry, "moves", perf.moves, error) ||
+        !ReadInt(entry, "finalIntersections", perf.finalIntersections,
+                 error) ||
+        !ReadSample(entry, "msPerMove", perf.msPerMove, error) ||
+        !ReadSample(entry, "pairTestsPerSecond", perf.pairTestsPerSecond,
+                    error)) {
+      error = perf.solverName + ": " + error;
+      return false;
+    }
+    baseline.solvers.push_back(perf);
+  }
+  return true;
+}
+
+void PerfRegression::WriteReport(const RegressionResult &result,
+                                 std::ostream &out) {
+  out << std::left << std::setw(14) << "Solver" << std::setw(14) << "Metric"
+      << std::right << std::setw(14) << "Baseline" << std::setw(14)
+      << "Current" << std::setw(10) << "Change" << std::setw(10) << "Allowed"
+      << "  Status\n";
+  out << std::string(84, '-') << '\n';
+
+  int regressions = 0;
+  for (const RegressionCheck &c : result.checks) {
+    double allowed = c.baseline != 0.0 ? 100.0 * c.threshold / c.baseline : 0.0;
+    std::ostringstream change;
+    change << std::fixed << std::setprecision(1) << std::showpos
+           << c.ChangePercent() << '%';
+    std::ostringstream band;
+    band << std::fixed << std::setprecision(1) << allowed << '%';
+
+    const char *status = c.regressed ? "REGRESSED"
+                         : c.improved ? "improved"
+                                      : "ok";
+    if (c.regressed)
+      ++regressions;
+
+    out << std::left << std::setw(14) << c.solverName << std::setw(14)
+        << c.metric << std::right << std::fixed
+        << std::setprecision(c.higherIsBetter ? 0 : 4) << std::setw(14)
+        << c.baseline << std::setw(14) << c.current << std::setw(10)
+        << change.str() << std::setw(10) << band.str() << "  " << status
+        << '\n';
+  }
+
+  if (!result.notes.empty()) {
+    out << '\n';
+    for (const std::string &note : result.notes) {
+      out << "note: " << note << '\n';
+    }
+  }
+
+  out << '\n';
+  if (result.passed) {
+    out << "PASS: no regressions in " << result.checks.size() << " checks\n";
+  } else {
+    out << "FAIL: " << regressions << " of " << result.checks.size()
+        << " checks regressed beyond tolerance and noise\n";
+  }
+}
+
+} // namespace GreedyTangle
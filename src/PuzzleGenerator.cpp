@@ -0,0 +1,240 @@
+#include "PuzzleGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+namespace GreedyTangle {
+
+namespace {
+
+constexpr float PI = 3.14159265358979323846f;
+
+// Normalized (min, max) endpoint pairs of the edges added so far, so the
+// duplicate check stays O(1) on the 10k-node rungs
+using EdgeKeys = std::unordered_set<uint64_t>;
+
+void AddEdgeUnique(Puzzle &puzzle, EdgeKeys &keys, int u, int v) {
+  if (u == v) {
+    return;
+  }
+  uint64_t key = static_cast<uint64_t>(std::min(u, v)) << 32 |
+                 static_cast<uint32_t>(std::max(u, v));
+  if (keys.insert(key).second) {
+    puzzle.edges.emplace_back(u, v);
+  }
+}
+
+void BuildCycleChords(Puzzle &puzzle, int nodeCount, std::mt19937 &gen) {
+  EdgeKeys keys;
+  keys.reserve(nodeCount * 2);
+  for (int i = 0; i < nodeCount; ++i) {
+    AddEdgeUnique(puzzle, keys, i, (i + 1) % nodeCount);
+  }
+
+  // Chords between circle positions, rejected if they would cross another
+  // chord, keep the circle layout planar
+  auto crossOnCircle = [](int a, int b, int c, int d) {
+    if (a > b)
+      std::swap(a, b);
+    if (c > d)
+      std::swap(c, d);
+    bool cBetween = (a < c && c < b);
+    bool dBetween = (a < d && d < b);
+    return cBetween != dBetween;
+  };
+
+  int numChords = std::max(1, nodeCount / 3);
+  std::uniform_int_distribution<int> nodeDist(0, nodeCount - 1);
+  std::vector<std::pair<int, int>> chords;
+  for (int attempts = 0;
+       static_cast<int>(chords.size()) < numChords && attempts < 200;
+       ++attempts) {
+    int u = nodeDist(gen);
+    int v = nodeDist(gen);
+    int diff = std::abs(u - v);
+    if (u == v || diff == 1 || diff == nodeCount - 1)
+      continue;
+
+    bool rejected = false;
+    for (const auto &[a, b] : chords) {
+      if ((a == u && b == v) || (a == v && b == u) ||
+          crossOnCircle(u, v, a, b)) {
+        rejected = true;
+        break;
+      }
+    }
+    if (!rejected) {
+      chords.emplace_back(u, v);
+      AddEdgeUnique(puzzle, keys, u, v);
+    }
+  }
+}
+
+void BuildGridMesh(Puzzle &puzzle, int nodeCount, std::mt19937 &gen) {
+  EdgeKeys keys;
+  keys.reserve(nodeCount * 2);
+  int cols = static_cast<int>(std::ceil(std::sqrt(nodeCount)));
+  int rows = (nodeCount + cols - 1) / cols;
+
+  for (int i = 0; i < nodeCount; ++i) {
+    int row = i / cols;
+    int col = i % cols;
+    if (col < cols - 1 && i + 1 < nodeCount)
+      AddEdgeUnique(puzzle, keys, i, i + 1);
+    if (row < rows - 1 && i + cols < nodeCount)
+      AddEdgeUnique(puzzle, keys, i, i + cols);
+  }
+
+  // Remove ~22% of the edges, never dropping a node below degree 2
+  std::vector<int> degree(nodeCount, 0);
+  for (const Edge &e : puzzle.edges) {
+    degree[e.u_id]++;
+    degree[e.v_id]++;
+  }
+  std::vector<int> order(puzzle.edges.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), gen);
+
+  int toRemove = static_cast<int>(puzzle.edges.size() * 0.22f);
+  std::vector<char> removed(puzzle.edges.size(), 0);
+  for (int idx : order) {
+    if (toRemove == 0)
+      break;
+    const Edge &e = puzzle.edges[idx];
+    if (degree[e.u_id] > 2 && degree[e.v_id] > 2) {
+      degree[e.u_id]--;
+      degree[e.v_id]--;
+      removed[idx] = 1;
+      --toRemove;
+    }
+  }
+
+  std::vector<Edge> kept;
+  for (size_t i = 0; i < puzzle.edges.size(); ++i) {
+    if (!removed[i])
+      kept.push_back(puzzle.edges[i]);
+  }
+  puzzle.edges = std::move(kept);
+}
+
+void BuildTriangulation(Puzzle &puzzle, int nodeCount, std::mt19937 &gen) {
+  EdgeKeys keys;
+  keys.reserve(nodeCount * 3);
+  AddEdgeUnique(puzzle, keys, 0, 1);
+  AddEdgeUnique(puzzle, keys, 1, 2);
+  AddEdgeUnique(puzzle, keys, 2, 0);
+
+  struct Face {
+    int a, b, c;
+  };
+  std::vector<Face> faces = {{0, 1, 2}};
+
+  for (int newNode = 3; newNode < nodeCount; ++newNode) {
+    std::uniform_int_distribution<int> faceDist(
+        0, static_cast<int>(faces.size()) - 1);
+    int faceIdx = faceDist(gen);
+    Face face = faces[faceIdx];
+
+    AddEdgeUnique(puzzle, keys, newNode, face.a);
+    AddEdgeUnique(puzzle, keys, newNode, face.b);
+    AddEdgeUnique(puzzle, keys, newNode, face.c);
+
+    faces.erase(faces.begin() + faceIdx);
+    faces.push_back({face.a, face.b, newNode});
+    faces.push_back({face.b, face.c, newNode});
+    faces.push_back({face.c, face.a, newNode});
+  }
+}
+
+} // namespace
+
+const char *PuzzleFamilyName(PuzzleFamily family) {
+  switch (family) {
+  case PuzzleFamily::CYCLE_CHORDS:
+    return "Cycle+Chords";
+  case PuzzleFamily::GRID_MESH:
+    return "Grid Mesh";
+  case PuzzleFamily::TRIANGULATION:
+    return "Triangulation";
+  }
+  return "Unknown";
+}
+
+const char *PuzzleFamilyKey(PuzzleFamily family) {
+  switch (family) {
+  case PuzzleFamily::CYCLE_CHORDS:
+    return "cycle";
+  case PuzzleFamily::GRID_MESH:
+    return "grid";
+  case PuzzleFamily::TRIANGULATION:
+    return "triangulation";
+  }
+  return "unknown";
+}
+
+bool PuzzleFamilyFromKey(const std::string &key, PuzzleFamily &family) {
+  for (PuzzleFamily candidate : {PuzzleFamily::CYCLE_CHORDS,
+                                 PuzzleFamily::GRID_MESH,
+                                 PuzzleFamily::TRIANGULATION}) {
+    if (key == PuzzleFamilyKey(candidate)) {
+      family = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+Puzzle GeneratePuzzle(PuzzleFamily family, int nodeCount, uint32_t seed,
+                      float width, float height) {
+  nodeCount = std::max(nodeCount, 3);
+
+  Puzzle puzzle;
+  puzzle.family = family;
+  puzzle.seed = seed;
+
+  // Mix the family into the seed so families don't share random streams
+  std::mt19937 gen(seed * 2654435761u + static_cast<uint32_t>(family));
+
+  switch (family) {
+  case PuzzleFamily::CYCLE_CHORDS:
+    BuildCycleChords(puzzle, nodeCount, gen);
+    break;
+  case PuzzleFamily::GRID_MESH:
+    BuildGridMesh(puzzle, nodeCount, gen);
+    break;
+  case PuzzleFamily::TRIANGULATION:
+    BuildTriangulation(puzzle, nodeCount, gen);
+    break;
+  }
+
+  // Scramble: nodes in random order around a circle (the in-game tangle)
+  std::vector<int> order(nodeCount);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), gen);
+
+  float centerX = width / 2.0f;
+  float centerY = height / 2.0f;
+  float radius = std::min(width, height) / 2.5f;
+
+  puzzle.nodes.reserve(nodeCount);
+  for (int i = 0; i < nodeCount; ++i) {
+    puzzle.nodes.emplace_back(i, Vec2());
+  }
+  for (int i = 0; i < nodeCount; ++i) {
+    float angle = 2.0f * PI * static_cast<float>(i) / nodeCount - PI / 2.0f;
+    puzzle.nodes[order[i]].position = Vec2(centerX + radius * std::cos(angle),
+                                           centerY + radius * std::sin(angle));
+  }
+
+  for (const Edge &e : puzzle.edges) {
+    puzzle.nodes[e.u_id].adjacencyList.push_back(e.v_id);
+    puzzle.nodes[e.v_id].adjacencyList.push_back(e.u_id);
+  }
+
+  return puzzle;
+}
+
+} // namespace GreedyTangle
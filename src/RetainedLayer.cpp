@@ -0,0 +1,109 @@
+#include "RetainedLayer.hpp"
+#include "Logger.hpp"
+#include <cstring>
+
+namespace GreedyTangle {
+
+RetainedLayer::Key &RetainedLayer::Key::Add(uint64_t value) {
+  Mix(&value, sizeof(value));
+  return *this;
+}
+
+RetainedLayer::Key &RetainedLayer::Key::Add(double value) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return Add(bits);
+}
+
+RetainedLayer::Key &RetainedLayer::Key::Add(std::string_view text) {
+  Add(static_cast<uint64_t>(text.size())); // "ab"+"c" differs from "a"+"bc"
+  Mix(text.data(), text.size());
+  return *this;
+}
+
+void RetainedLayer::Key::Mix(const void *data, size_t size) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash_ ^= bytes[i];
+    hash_ *= 1099511628211ull;
+  }
+}
+
+RetainedLayer::~RetainedLayer() { Destroy(); }
+
+void RetainedLayer::Destroy() {
+  if (texture_) {
+    SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+  }
+  valid_ = false;
+}
+
+RetainedLayer::Mode RetainedLayer::Prepare(SDL_Renderer *renderer,
+                                           uint64_t key) {
+  if (unsupported_ || !renderer) {
+    return Mode::DIRECT;
+  }
+
+  int width = 0, height = 0;
+  SDL_GetRendererOutputSize(renderer, &width, &height);
+  if (!texture_ || width != width_ || height != height_) {
+    Destroy();
+    if (!SDL_RenderTargetSupported(renderer)) {
+      GT_LOG_WARN("Render", "No render targets, UI panels are redrawn "
+                            "every frame");
+      unsupported_ = true;
+      return Mode::DIRECT;
+    }
+
+    texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                 SDL_TEXTUREACCESS_TARGET, width, height);
+    // Premultiplied "over": the texture already holds color * alpha
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+        SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+        SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (!texture_ || SDL_SetTextureBlendMode(texture_, premultiplied) != 0) {
+      GT_LOG_WARN("Render", "Retained layer unavailable ({}), UI panels are "
+                            "redrawn every frame",
+                  SDL_GetError());
+      Destroy();
+      unsupported_ = true;
+      return Mode::DIRECT;
+    }
+    width_ = width;
+    height_ = height;
+  }
+
+  if (valid_ && key == key_) {
+    return Mode::CACHED;
+  }
+
+  previousTarget_ = SDL_GetRenderTarget(renderer);
+  if (SDL_SetRenderTarget(renderer, texture_) != 0) {
+    GT_LOG_WARN("Render", "SDL_SetRenderTarget failed ({}), UI panels are "
+                          "redrawn every frame",
+                SDL_GetError());
+    Destroy();
+    unsupported_ = true;
+    return Mode::DIRECT;
+  }
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+
+  key_ = key;
+  valid_ = true;
+  ++repaints_;
+  return Mode::REPAINT;
+}
+
+void RetainedLayer::FinishRepaint(SDL_Renderer *renderer) {
+  SDL_SetRenderTarget(renderer, previousTarget_);
+  previousTarget_ = nullptr;
+}
+
+void RetainedLayer::Composite(SDL_Renderer *renderer, const SDL_Rect &bounds) {
+  SDL_RenderCopy(renderer, texture_, &bounds, &bounds);
+}
+
+} // namespace GreedyTangle
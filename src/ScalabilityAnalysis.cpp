@@ -0,0 +1,442 @@
+#include "ScalabilityAnalysis.hpp"
+#include "Logger.hpp"
+#include "SolverFactory.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace GreedyTangle {
+
+namespace {
+
+// How often the watchdog checks running trials against their time limit
+constexpr auto WATCHDOG_POLL = std::chrono::milliseconds(20);
+
+int64_t SteadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Two-sided 95% critical value of Student's t with df degrees of freedom
+double StudentT95(int df) {
+  static constexpr double TABLE[] = {
+      12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+      2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+      2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  constexpr int TABLE_SIZE = sizeof(TABLE) / sizeof(TABLE[0]);
+  if (df < 1)
+    return std::numeric_limits<double>::infinity();
+  if (df <= TABLE_SIZE)
+    return TABLE[df - 1];
+
+  // Cornish-Fisher expansion around the normal quantile
+  const double z = 1.959964;
+  double z3 = z * z * z;
+  double z5 = z3 * z * z;
+  return z + (z3 + z) / (4.0 * df) +
+         (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * df * df);
+}
+
+ScalabilityPoint Summarize(const std::vector<BenchmarkTrial> &trials,
+                           SolverMode mode, int nodeCount) {
+  ScalabilityPoint point;
+  point.mode = mode;
+  point.nodeCount = nodeCount;
+  std::vector<double> times, perMove, moves;
+
+  for (const BenchmarkTrial &t : trials) {
+    if (t.mode != mode || t.nodeCount != nodeCount)
+      continue;
+    if (point.trials == 0) {
+      point.solverName = t.solverName;
+      point.edgeCount = t.edgeCount;
+    }
+    ++point.trials;
+    if (t.solved)
+      ++point.solvedTrials;
+    if (t.cutOff)
+      point.censored = true;
+    if (t.cutOff && t.searches == 0 && t.initialIntersections > 0)
+      point.tooSlow = true;
+    times.push_back(t.timeMs);
+    moves.push_back(t.moves);
+    if (t.searches > 0)
+      perMove.push_back(t.MsPerSearch());
+  }
+
+  point.timeMs = Distribution::From(std::move(times));
+  point.msPerMove = Distribution::From(std::move(perMove));
+  point.moves = Distribution::From(std::move(moves));
+  return point;
+}
+
+} // namespace
+
+double ComplexityFit::Predict(double nodeCount) const {
+  return coefficient * std::pow(nodeCount, exponent);
+}
+
+std::vector<int> ScalabilityAnalysis::SizeLadder(int minNodes, int maxNodes,
+                                                 double growth) {
+  std::vector<int> sizes;
+  minNodes = std::max(minNodes, 3);
+  growth = std::max(growth, 1.1);
+  for (double n = minNodes; n <= maxNodes + 0.5; n *= growth) {
+    int size = static_cast<int>(std::lround(n));
+    if (sizes.empty() || size > sizes.back())
+      sizes.push_back(size);
+  }
+  return sizes;
+}
+
+ComplexityFit
+ScalabilityAnalysis::FitPowerLaw(const std::vector<double> &nodeCounts,
+                                 const std::vector<double> &values) {
+  ComplexityFit fit;
+  std::vector<double> xs, ys;
+  std::set<double> distinct;
+  for (size_t i = 0; i < nodeCounts.size() && i < values.size(); ++i) {
+    if (nodeCounts[i] > 0.0 && values[i] > 0.0) {
+      xs.push_back(std::log(nodeCounts[i]));
+      ys.push_back(std::log(values[i]));
+      distinct.insert(nodeCounts[i]);
+    }
+  }
+  // A slope needs at least three sizes to say anything about its error
+  size_t n = xs.size();
+  if (n < 3 || distinct.size() < 3)
+    return fit;
+
+  double meanX = 0.0, meanY = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    meanX += xs[i];
+    meanY += ys[i];
+  }
+  meanX /= n;
+  meanY /= n;
+
+  double sxx = 0.0, sxy = 0.0, syy = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    double dx = xs[i] - meanX;
+    double dy = ys[i] - meanY;
+    sxx += dx * dx;
+    sxy += dx * dy;
+    syy += dy * dy;
+  }
+
+  double slope = sxy / sxx;
+  double intercept = meanY - slope * meanX;
+  double residual = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    double r = ys[i] - (intercept + slope * xs[i]);
+    residual += r * r;
+  }
+
+  int df = static_cast<int>(n) - 2;
+  double stdErr = std::sqrt(residual / df / sxx);
+  double margin = StudentT95(df) * stdErr;
+
+  fit.samples = static_cast<int>(n);
+  fit.exponent = slope;
+  fit.ciLow = slope - margin;
+  fit.ciHigh = slope + margin;
+  fit.coefficient = std::exp(intercept);
+  fit.rSquared = syy > 0.0 ? 1.0 - residual / syy : 1.0;
+  return fit;
+}
+
+std::vector<BenchmarkTrial>
+ScalabilityAnalysis::RunRung(const ScalabilityConfig &config,
+                             const std::vector<SolverMode> &modes,
+                             int nodeCount, int64_t deadlineNs,
+                             bool &cutShort) {
+  GT_TRACE_SCOPE("ScalabilityRung", "job");
+
+  std::vector<Puzzle> puzzles;
+  for (uint32_t seed : config.seeds) {
+    puzzles.push_back(GeneratePuzzle(config.family, nodeCount, seed));
+  }
+
+  BenchmarkConfig trialConfig;
+  trialConfig.modes = modes;
+  trialConfig.maxMoves = config.maxMoves;
+  trialConfig.trialTimeLimit = config.trialTimeLimit;
+  trialConfig.sweepTimeLimit = 0.0f;
+  trialConfig.solverPool = config.solverPool;
+
+  // Each trial gets its own cancel flag so the watchdog can stop one
+  // oversized search without touching the others. A deque keeps the
+  // addresses stable while the tasks hold them.
+  struct Watch {
+    std::atomic<bool> cancel{false};
+    std::atomic<int64_t> startNs{0};
+  };
+  std::deque<Watch> watches;
+  std::vector<std::future<BenchmarkTrial>> futures;
+  for (const Puzzle &puzzle : puzzles) {
+    for (SolverMode mode : modes) {
+      Watch &watch = watches.emplace_back();
+      futures.push_back(pool_.Submit(
+          [&puzzle, mode, &trialConfig, &watch, deadlineNs]() {
+            watch.startNs.store(SteadyNowNs(), std::memory_order_relaxed);
+            BenchmarkConfig ownConfig = trialConfig;
+            ownConfig.cancelFlag = &watch.cancel;
+            return BenchmarkRunner::RunTrial(mode, puzzle, ownConfig,
+                                             deadlineNs);
+          }));
+    }
+  }
+
+  // Watch rather than help: a trial run inline here could not be cut off
+  const int64_t limitNs =
+      static_cast<int64_t>(static_cast<double>(config.trialTimeLimit) * 1e9);
+  for (;;) {
+    bool pending = false;
+    for (auto &future : futures) {
+      if (future.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+        pending = true;
+        break;
+      }
+    }
+    if (!pending)
+      break;
+
+    int64_t now = SteadyNowNs();
+    bool stopAll = (deadlineNs > 0 && now >= deadlineNs) ||
+                   (config.cancelFlag && config.cancelFlag->load());
+    if (stopAll)
+      cutShort = true;
+    for (Watch &watch : watches) {
+      int64_t start = watch.startNs.load(std::memory_order_relaxed);
+      if (stopAll || (start > 0 && now - start >= limitNs))
+        watch.cancel.store(true, std::memory_order_relaxed);
+    }
+    std::this_thread::sleep_for(WATCHDOG_POLL);
+  }
+
+  std::vector<BenchmarkTrial> trials;
+  trials.reserve(futures.size());
+  for (auto &future : futures) {
+    trials.push_back(future.get());
+  }
+  return trials;
+}
+
+ScalabilityReport ScalabilityAnalysis::Run(const ScalabilityConfig &config) {
+  GT_TRACE_SCOPE("ScalabilitySweep", "job");
+
+  ScalabilityReport report;
+  report.config = config;
+  report.config.cancelFlag = nullptr;
+
+  int64_t startNs = SteadyNowNs();
+  int64_t deadlineNs = 0;
+  if (config.sweepTimeLimit > 0.0f) {
+    deadlineNs = startNs + static_cast<int64_t>(config.sweepTimeLimit * 1e9);
+  }
+
+  std::vector<SolverMode> active = config.modes;
+  for (int nodeCount :
+       SizeLadder(config.minNodes, config.maxNodes, config.growth)) {
+    if (active.empty() || report.cutShort)
+      break;
+
+    GT_LOG_INFO("Complexity", "N={}: {} solver(s) x {} seed(s)...", nodeCount,
+                active.size(), config.seeds.size());
+    report.sizes.push_back(nodeCount);
+    std::vector<BenchmarkTrial> trials =
+        RunRung(config, active, nodeCount, deadlineNs, report.cutShort);
+
+    std::vector<SolverMode> survivors;
+    for (SolverMode mode : active) {
+      ScalabilityPoint point = Summarize(trials, mode, nodeCount);
+      GT_LOG_INFO("Complexity", "{} N={}: median {:.1f}ms, {:.2f}ms/move, solved {}/{}{}",
+                  point.solverName, nodeCount, point.timeMs.median,
+                  point.msPerMove.median, point.solvedTrials, point.trials,
+                  point.censored ? " (time limit)" : "");
+      if (point.tooSlow) {
+        GT_LOG_INFO("Complexity", "{} dropped from sizes above N={}",
+                    point.solverName, nodeCount);
+      } else {
+        survivors.push_back(mode);
+      }
+      report.points.push_back(std::move(point));
+    }
+    active = std::move(survivors);
+
+    for (BenchmarkTrial &trial : trials) {
+      report.trials.push_back(std::move(trial));
+    }
+  }
+
+  // A cut-off total is a lower bound, not a measurement, and would flatten
+  // the slope. Sizes where only the fast seeds managed a search are biased
+  // the same way for the per-move fit.
+  for (SolverMode mode : config.modes) {
+    SolverScaling scaling;
+    scaling.mode = mode;
+    scaling.solverName = CreateSolver(mode)->GetName();
+
+    std::set<int> complete, searchable;
+    for (const ScalabilityPoint &point : report.points) {
+      if (point.mode != mode)
+        continue;
+      if (!point.censored) {
+        complete.insert(point.nodeCount);
+        scaling.largestCompleted =
+            std::max(scaling.largestCompleted, point.nodeCount);
+      }
+      if (!point.tooSlow)
+        searchable.insert(point.nodeCount);
+    }
+
+    std::vector<double> totalN, totalMs, moveN, moveMs;
+    for (const BenchmarkTrial &t : report.trials) {
+      if (t.mode != mode)
+        continue;
+      if (complete.count(t.nodeCount)) {
+        totalN.push_back(t.nodeCount);
+        totalMs.push_back(t.timeMs);
+      }
+      if (t.searches > 0 && searchable.count(t.nodeCount)) {
+        moveN.push_back(t.nodeCount);
+        moveMs.push_back(t.MsPerSearch());
+      }
+    }
+    scaling.totalTime = FitPowerLaw(totalN, totalMs);
+    scaling.perMove = FitPowerLaw(moveN, moveMs);
+
+    if (scaling.perMove.IsValid()) {
+      GT_LOG_INFO("Complexity", "{}: per move ~ N^{:.2f} (95% CI {:.2f}..{:.2f}, R^2={:.3f})",
+                  scaling.solverName, scaling.perMove.exponent,
+                  scaling.perMove.ciLow, scaling.perMove.ciHigh,
+                  scaling.perMove.rSquared);
+    } else {
+      GT_LOG_INFO("Complexity", "{}: too few sizes to fit the per-move cost",
+                  scaling.solverName);
+    }
+    if (scaling.totalTime.IsValid()) {
+      GT_LOG_INFO("Complexity", "{}: total ~ N^{:.2f} (95% CI {:.2f}..{:.2f}) up to N={}",
+                  scaling.solverName, scaling.totalTime.exponent,
+                  scaling.totalTime.ciLow, scaling.totalTime.ciHigh,
+                  scaling.largestCompleted);
+    }
+    report.solvers.push_back(std::move(scaling));
+  }
+
+  report.sweepMs = (SteadyNowNs() - startNs) / 1000000;
+  return report;
+}
+
+bool ScalabilityAnalysis::WriteCSV(const ScalabilityReport &report,
+                                   const std::string &path) {
+  std::ofstream out(path);
+  return out && WriteCSV(report, out);
+}
+
+bool ScalabilityAnalysis::WriteJSON(const ScalabilityReport &report,
+                                    const std::string &path) {
+  std::ofstream out(path);
+  return out && WriteJSON(report, out);
+}
+
+bool ScalabilityAnalysis::WriteCSV(const ScalabilityReport &report,
+                                   std::ostream &out) {
+  out << "solver,family,nodes,edges,seed,moves,searches,time_ms,ms_per_move,"
+         "initial_crossings,final_crossings,solved,cut_off\n";
+  out << std::fixed << std::setprecision(3);
+  for (const BenchmarkTrial &t : report.trials) {
+    out << '"' << t.solverName << "\"," << PuzzleFamilyName(t.family) << ','
+        << t.nodeCount << ',' << t.edgeCount << ',' << t.seed << ','
+        << t.moves << ',' << t.searches << ',' << t.timeMs << ','
+        << t.MsPerSearch() << ',' << t.initialIntersections << ','
+        << t.finalIntersections << ',' << (t.solved ? 1 : 0) << ','
+        << (t.cutOff ? 1 : 0) << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+bool ScalabilityAnalysis::WriteJSON(const ScalabilityReport &report,
+                                    std::ostream &out) {
+  out << std::fixed << std::setprecision(4);
+  auto writeFit = [&out](const ComplexityFit &fit) {
+    if (!fit.IsValid()) {
+      out << "null";
+      return;
+    }
+    out << "{\"samples\": " << fit.samples << ", \"exponent\": "
+        << fit.exponent << ", \"ci95\": [" << fit.ciLow << ", " << fit.ciHigh
+        << "], \"coefficientMs\": " << std::scientific << fit.coefficient
+        << std::fixed << ", \"rSquared\": " << fit.rSquared << "}";
+  };
+
+  const ScalabilityConfig &config = report.config;
+  out << "{\n  \"config\": {\"family\": \"" << PuzzleFamilyName(config.family)
+      << "\", \"minNodes\": " << config.minNodes
+      << ", \"maxNodes\": " << config.maxNodes
+      << ", \"growth\": " << config.growth
+      << ", \"seeds\": " << config.seeds.size()
+      << ", \"maxMoves\": " << config.maxMoves
+      << ", \"trialTimeLimit\": " << config.trialTimeLimit
+      << ", \"sweepTimeLimit\": " << config.sweepTimeLimit << "},\n";
+  out << "  \"sweepMs\": " << report.sweepMs
+      << ", \"cutShort\": " << (report.cutShort ? "true" : "false") << ",\n";
+
+  out << "  \"solvers\": [";
+  for (size_t i = 0; i < report.solvers.size(); ++i) {
+    const SolverScaling &s = report.solvers[i];
+    out << (i ? ",\n" : "\n") << "    {\"solver\": \"" << s.solverName
+        << "\", \"largestCompleted\": " << s.largestCompleted
+        << ", \"perMove\": ";
+    writeFit(s.perMove);
+    out << ", \"totalTime\": ";
+    writeFit(s.totalTime);
+    out << "}";
+  }
+  out << "\n  ],\n";
+
+  out << "  \"points\": [";
+  for (size_t i = 0; i < report.points.size(); ++i) {
+    const ScalabilityPoint &p = report.points[i];
+    out << (i ? ",\n" : "\n") << "    {\"solver\": \"" << p.solverName
+        << "\", \"nodes\": " << p.nodeCount << ", \"edges\": " << p.edgeCount
+        << ", \"trials\": " << p.trials << ", \"solved\": " << p.solvedTrials
+        << ", \"censored\": " << (p.censored ? "true" : "false")
+        << ", \"timeMs\": ";
+    p.timeMs.WriteJSON(out);
+    out << ", \"msPerMove\": ";
+    p.msPerMove.WriteJSON(out);
+    out << ", \"moves\": ";
+    p.moves.WriteJSON(out);
+    out << "}";
+  }
+  out << "\n  ],\n";
+
+  out << "  \"trials\": [";
+  for (size_t i = 0; i < report.trials.size(); ++i) {
+    const BenchmarkTrial &t = report.trials[i];
+    out << (i ? ",\n" : "\n") << "    {\"solver\": \"" << t.solverName
+        << "\", \"nodes\": " << t.nodeCount << ", \"seed\": " << t.seed
+        << ", \"moves\": " << t.moves << ", \"searches\": " << t.searches
+        << ", \"timeMs\": " << t.timeMs
+        << ", \"initial\": " << t.initialIntersections
+        << ", \"final\": " << t.finalIntersections
+        << ", \"solved\": " << (t.solved ? "true" : "false")
+        << ", \"cutOff\": " << (t.cutOff ? "true" : "false") << "}";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out);
+}
+
+} // namespace GreedyTangle
@@ -0,0 +1,163 @@
+#include "SceneIndex.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+
+namespace GreedyTangle {
+
+namespace {
+
+// Liang-Barsky clip of segment ab against box
+bool SegmentIntersectsRect(const Vec2 &a, const Vec2 &b, const Rect &box) {
+  float t0 = 0.0f, t1 = 1.0f;
+  Vec2 d = b - a;
+  auto clip = [&](float p, float q) {
+    if (p == 0.0f) {
+      return q >= 0.0f; // Parallel: inside this slab or never
+    }
+    float t = q / p;
+    if (p < 0.0f) {
+      t0 = std::max(t0, t);
+    } else {
+      t1 = std::min(t1, t);
+    }
+    return t0 <= t1;
+  };
+  return clip(-d.x, a.x - box.minX) && clip(d.x, box.maxX - a.x) &&
+         clip(-d.y, a.y - box.minY) && clip(d.y, box.maxY - a.y);
+}
+
+} // namespace
+
+Rect SceneIndex::NodeBox(const Node &node) {
+  return Rect::Around(node.position, node.position).Expanded(node.radius);
+}
+
+void SceneIndex::Update(const std::vector<Node> &nodes,
+                        const std::vector<Edge> &edges) {
+  if (!valid_ || !SameGraph(nodes, edges)) {
+    Rebuild(nodes, edges);
+    return;
+  }
+
+  movedNodes_.clear();
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const Vec2 &now = nodes[i].position;
+    if (now.x != positions_[i].x || now.y != positions_[i].y) {
+      movedNodes_.push_back(static_cast<int>(i));
+    }
+  }
+  if (movedNodes_.empty()) {
+    return;
+  }
+  if (movedNodes_.size() > nodes.size() * REBUILD_FRACTION) {
+    Rebuild(nodes, edges);
+    return;
+  }
+
+  for (int id : movedNodes_) {
+    Refile(nodes, id);
+  }
+}
+
+void SceneIndex::MoveNode(const std::vector<Node> &nodes, int id) {
+  if (!Tracks(nodes) || id < 0 || id >= static_cast<int>(nodes.size())) {
+    return; // The next Update() files it
+  }
+  Refile(nodes, id);
+}
+
+void SceneIndex::Refile(const std::vector<Node> &nodes, int id) {
+  positions_[id] = nodes[id].position;
+  nodeGrid_.Update(id, NodeBox(nodes[id]));
+  // An edge between two moved nodes is re-filed again with the other one
+  for (int edgeIndex : incident_[id]) {
+    const Edge &edge = endpoints_[edgeIndex];
+    edgeGrid_.Update(edgeIndex, Rect::Around(positions_[edge.u_id],
+                                             positions_[edge.v_id]));
+  }
+}
+
+int SceneIndex::NodeAt(const std::vector<Node> &nodes,
+                       const Vec2 &point) const {
+  nodeGrid_.Query(Rect::Around(point, point), hits_);
+  int topmost = -1;
+  for (int id : hits_) {
+    if (id > topmost && nodes[id].containsPoint(point)) {
+      topmost = id;
+    }
+  }
+  return topmost;
+}
+
+bool SceneIndex::SameGraph(const std::vector<Node> &nodes,
+                           const std::vector<Edge> &edges) const {
+  if (nodes.size() != positions_.size() ||
+      edges.size() != endpoints_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < edges.size(); ++i) {
+    if (edges[i].u_id != endpoints_[i].u_id ||
+        edges[i].v_id != endpoints_[i].v_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SceneIndex::Rebuild(const std::vector<Node> &nodes,
+                         const std::vector<Edge> &edges) {
+  GT_TRACE_SCOPE("SceneIndex::Rebuild", "frame");
+  positions_.resize(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    positions_[i] = nodes[i].position;
+  }
+  endpoints_.assign(edges.begin(), edges.end());
+
+  incident_.assign(nodes.size(), {});
+  for (size_t i = 0; i < edges.size(); ++i) {
+    incident_[edges[i].u_id].push_back(static_cast<int>(i));
+    if (edges[i].v_id != edges[i].u_id) {
+      incident_[edges[i].v_id].push_back(static_cast<int>(i));
+    }
+  }
+
+  Rect area = GraphBounds(nodes).Expanded(CELL_SIZE);
+  nodeGrid_.Reset(area, CELL_SIZE, nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    nodeGrid_.Insert(static_cast<int>(i), NodeBox(nodes[i]));
+  }
+  edgeGrid_.Reset(area, CELL_SIZE, edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edgeGrid_.Insert(static_cast<int>(i),
+                     Rect::Around(positions_[edges[i].u_id],
+                                  positions_[edges[i].v_id]));
+  }
+  valid_ = true;
+}
+
+void SceneIndex::Query(const Rect &area, std::vector<int> &visibleNodes,
+                       std::vector<int> &visibleEdges) const {
+  GT_TRACE_SCOPE("SceneIndex::Query", "frame");
+  nodeGrid_.Query(area, visibleNodes);
+  edgeGrid_.Query(area, visibleEdges);
+
+  // A long diagonal edge's box can reach the area while the edge misses it
+  visibleEdges.erase(
+      std::remove_if(visibleEdges.begin(), visibleEdges.end(),
+                     [&](int i) {
+                       return !SegmentIntersectsRect(
+                           positions_[endpoints_[i].u_id],
+                           positions_[endpoints_[i].v_id], area);
+                     }),
+      visibleEdges.end());
+  std::sort(visibleNodes.begin(), visibleNodes.end());
+  std::sort(visibleEdges.begin(), visibleEdges.end());
+}
+
+void SceneIndex::QueryNodes(const Rect &area,
+                            std::vector<int> &visibleNodes) const {
+  nodeGrid_.Query(area, visibleNodes);
+  std::sort(visibleNodes.begin(), visibleNodes.end());
+}
+
+} // namespace GreedyTangle
@@ -0,0 +1,48 @@
+#include "SolverArena.hpp"
+#include <algorithm>
+
+namespace GreedyTangle {
+
+void *SolverArena::SpillCounter::do_allocate(size_t bytes, size_t alignment) {
+  this->bytes += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void SolverArena::SpillCounter::do_deallocate(void *p, size_t bytes,
+                                              size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+SolverArena::SolverArena(size_t capacity)
+    : buffer_(new std::byte[capacity]), capacity_(capacity) {
+  monotonic_.emplace(buffer_.get(), capacity_, &spill_);
+}
+
+void SolverArena::Reset() {
+  monotonic_.reset(); // Returns any spilled chunks to the heap
+
+  // Grow so the next search of the same size fits in one block
+  if (spill_.bytes > 0 && capacity_ < MAX_CAPACITY) {
+    capacity_ = std::min(MAX_CAPACITY,
+                         std::max(capacity_ * 2, capacity_ + spill_.bytes));
+    buffer_.reset(new std::byte[capacity_]);
+  }
+  spill_.bytes = 0;
+  monotonic_.emplace(buffer_.get(), capacity_, &spill_);
+}
+
+void *SolverArena::do_allocate(size_t bytes, size_t alignment) {
+  while (lock_.test_and_set(std::memory_order_acquire)) {
+  }
+  void *p = nullptr;
+  try {
+    p = monotonic_->allocate(bytes, alignment);
+  } catch (...) {
+    lock_.clear(std::memory_order_release);
+    throw;
+  }
+  lock_.clear(std::memory_order_release);
+  return p;
+}
+
+} // namespace GreedyTangle
@@ -18,4 +18,28 @@ std::unique_ptr<ICPUSolver> CreateSolver(SolverMode mode) {
   }
 }
 
+const char *SolverModeKey(SolverMode mode) {
+  switch (mode) {
+  case SolverMode::GREEDY:
+    return "greedy";
+  case SolverMode::DIVIDE_AND_CONQUER_DP:
+    return "dnc";
+  case SolverMode::BACKTRACKING:
+    return "backtracking";
+  }
+  return "unknown";
+}
+
+bool SolverModeFromKey(const std::string &key, SolverMode &mode) {
+  for (SolverMode candidate :
+       {SolverMode::GREEDY, SolverMode::DIVIDE_AND_CONQUER_DP,
+        SolverMode::BACKTRACKING}) {
+    if (key == SolverModeKey(candidate)) {
+      mode = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
 }
@@ -0,0 +1,143 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace GreedyTangle {
+
+namespace {
+
+void EraseValue(std::vector<int> &values, int value) {
+  auto it = std::find(values.begin(), values.end(), value);
+  if (it != values.end()) {
+    *it = values.back();
+    values.pop_back();
+  }
+}
+
+} // namespace
+
+void SpatialGrid::Reset(const Rect &area, float cellSize, size_t itemCount) {
+  area_ = area;
+  float width = std::max(area.Width(), 1.0f);
+  float height = std::max(area.Height(), 1.0f);
+  cellSize = std::max(cellSize, 1.0f);
+  columns_ = std::clamp(static_cast<int>(std::ceil(width / cellSize)), 1,
+                        MAX_CELLS_PER_AXIS);
+  rows_ = std::clamp(static_cast<int>(std::ceil(height / cellSize)), 1,
+                     MAX_CELLS_PER_AXIS);
+  cellWidth_ = width / static_cast<float>(columns_);
+  cellHeight_ = height / static_cast<float>(rows_);
+
+  cells_.assign(static_cast<size_t>(columns_) * rows_, {});
+  oversized_.clear();
+  items_.assign(itemCount, Item());
+  stamps_.assign(itemCount, 0);
+  stamp_ = 0;
+}
+
+SpatialGrid::CellRange SpatialGrid::RangeFor(const Rect &box) const {
+  auto column = [&](float x) {
+    return std::clamp(static_cast<int>(std::floor((x - area_.minX) /
+                                                  cellWidth_)),
+                      0, columns_ - 1);
+  };
+  auto row = [&](float y) {
+    return std::clamp(static_cast<int>(std::floor((y - area_.minY) /
+                                                  cellHeight_)),
+                      0, rows_ - 1);
+  };
+  CellRange range;
+  range.x0 = column(box.minX);
+  range.x1 = column(box.maxX);
+  range.y0 = row(box.minY);
+  range.y1 = row(box.maxY);
+  return range;
+}
+
+void SpatialGrid::File(int item) {
+  Item &entry = items_[item];
+  entry.filed = true;
+  entry.oversized = CellCount(entry.cells) > MAX_ITEM_CELLS;
+  if (entry.oversized) {
+    oversized_.push_back(item);
+    return;
+  }
+  for (int y = entry.cells.y0; y <= entry.cells.y1; ++y) {
+    for (int x = entry.cells.x0; x <= entry.cells.x1; ++x) {
+      cells_[static_cast<size_t>(y) * columns_ + x].push_back(item);
+    }
+  }
+}
+
+void SpatialGrid::Unfile(int item) {
+  Item &entry = items_[item];
+  if (!entry.filed) {
+    return;
+  }
+  entry.filed = false;
+  if (entry.oversized) {
+    EraseValue(oversized_, item);
+    return;
+  }
+  for (int y = entry.cells.y0; y <= entry.cells.y1; ++y) {
+    for (int x = entry.cells.x0; x <= entry.cells.x1; ++x) {
+      EraseValue(cells_[static_cast<size_t>(y) * columns_ + x], item);
+    }
+  }
+}
+
+void SpatialGrid::Insert(int item, const Rect &box) {
+  Item &entry = items_[item];
+  entry.box = box;
+  entry.cells = RangeFor(box);
+  File(item);
+}
+
+void SpatialGrid::Update(int item, const Rect &box) {
+  Item &entry = items_[item];
+  CellRange cells = RangeFor(box);
+  entry.box = box;
+  if (entry.filed && cells == entry.cells) {
+    return;
+  }
+  Unfile(item);
+  entry.cells = cells;
+  File(item);
+}
+
+void SpatialGrid::Remove(int item) { Unfile(item); }
+
+void SpatialGrid::Query(const Rect &area, std::vector<int> &out) const {
+  out.clear();
+  if (items_.empty()) {
+    return;
+  }
+  if (++stamp_ == 0) {
+    std::fill(stamps_.begin(), stamps_.end(), 0);
+    stamp_ = 1;
+  }
+
+  auto report = [&](int item) {
+    if (stamps_[item] == stamp_) {
+      return;
+    }
+    stamps_[item] = stamp_;
+    if (items_[item].box.Intersects(area)) {
+      out.push_back(item);
+    }
+  };
+
+  CellRange range = RangeFor(area);
+  for (int y = range.y0; y <= range.y1; ++y) {
+    for (int x = range.x0; x <= range.x1; ++x) {
+      for (int item : cells_[static_cast<size_t>(y) * columns_ + x]) {
+        report(item);
+      }
+    }
+  }
+  for (int item : oversized_) {
+    report(item);
+  }
+}
+
+} // namespace GreedyTangle
@@ -0,0 +1,346 @@
+#include "TextCache.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace GreedyTangle {
+
+namespace {
+
+constexpr int ATLAS_ROW_WIDTH = 1024; // Glyph rows wrap at this many texels
+constexpr int GUTTER = 1;
+constexpr SDL_Color WHITE = {255, 255, 255, 255};
+
+} // namespace
+
+size_t TextCache::KeyHash::operator()(const KeyView &key) const {
+  size_t hash = std::hash<std::string_view>{}(key.text);
+  hash ^= std::hash<const void *>{}(key.font) + 0x9e3779b9 + (hash << 6) +
+          (hash >> 2);
+  hash ^= std::hash<uint32_t>{}(key.color) + 0x9e3779b9 + (hash << 6) +
+          (hash >> 2);
+  return hash;
+}
+
+TextCache::~TextCache() { Clear(); }
+
+void TextCache::Init(SDL_Renderer *renderer) {
+  renderer_ = renderer;
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+  geometrySupported_ = false;
+#endif
+}
+
+void TextCache::Clear() {
+  for (Entry &entry : entries_) {
+    SDL_DestroyTexture(entry.texture);
+  }
+  index_.clear();
+  entries_.clear();
+  seen_.clear();
+  textureBytes_ = 0;
+
+  for (auto &[font, atlas] : atlases_) {
+    if (atlas.texture) {
+      SDL_DestroyTexture(atlas.texture);
+    }
+  }
+  atlases_.clear();
+}
+
+uint32_t TextCache::PackColor(SDL_Color color) {
+  return (static_cast<uint32_t>(color.r) << 24) |
+         (static_cast<uint32_t>(color.g) << 16) |
+         (static_cast<uint32_t>(color.b) << 8) | color.a;
+}
+
+bool TextCache::IsAtlasText(const std::string &text) {
+  return std::all_of(text.begin(), text.end(), [](char c) {
+    return c >= FIRST_GLYPH && c <= LAST_GLYPH;
+  });
+}
+
+// ---- Composed strings ----
+
+const TextCache::Entry *TextCache::Find(const KeyView &key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &*it->second;
+}
+
+const TextCache::Entry *TextCache::Compose(TTF_Font *font,
+                                           const std::string &text,
+                                           SDL_Color color) {
+  GT_TRACE_SCOPE("TextCache::Compose", "frame");
+  SDL_Surface *surface = TTF_RenderText_Blended(font, text.c_str(), color);
+  if (!surface) {
+    return nullptr;
+  }
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer_, surface);
+  Extent extent{surface->w, surface->h};
+  SDL_FreeSurface(surface);
+  if (!texture) {
+    return nullptr;
+  }
+
+  entries_.push_front(Entry{Key{font, text, PackColor(color)}, texture,
+                            extent});
+  const Key &key = entries_.front().key;
+  index_.emplace(KeyView{key.font, key.text, key.color}, entries_.begin());
+  textureBytes_ += static_cast<size_t>(extent.w) * extent.h * 4;
+  EvictToBudget();
+  return &entries_.front();
+}
+
+void TextCache::EvictToBudget() {
+  // The newest entry stays even if it alone is over budget
+  while (entries_.size() > 1 && (textureBytes_ > TEXTURE_BUDGET_BYTES ||
+                                 entries_.size() > MAX_ENTRIES)) {
+    Entry &oldest = entries_.back();
+    index_.erase(KeyView{oldest.key.font, oldest.key.text, oldest.key.color});
+    textureBytes_ -=
+        static_cast<size_t>(oldest.extent.w) * oldest.extent.h * 4;
+    SDL_DestroyTexture(oldest.texture);
+    entries_.pop_back();
+  }
+}
+
+// ---- Glyph atlas ----
+
+const TextCache::GlyphAtlas &TextCache::AtlasFor(TTF_Font *font) {
+  auto it = atlases_.find(font);
+  if (it == atlases_.end()) {
+    it = atlases_.emplace(font, GlyphAtlas{}).first;
+    if (!BuildAtlas(font, it->second)) {
+      GT_LOG_WARN("Text", "Glyph atlas unavailable, composing every string");
+    }
+  }
+  return it->second;
+}
+
+bool TextCache::BuildAtlas(TTF_Font *font, GlyphAtlas &atlas) {
+  GT_TRACE_SCOPE("TextCache::BuildAtlas", "frame");
+  std::array<SDL_Surface *, GLYPH_COUNT> glyphs{};
+  atlas.height = TTF_FontHeight(font);
+
+  // Each glyph as TTF_RenderText_Blended draws it alone, so its placement
+  // against the baseline matches composed strings
+  int rowHeight = atlas.height;
+  for (int i = 0; i < GLYPH_COUNT; ++i) {
+    char text[2] = {static_cast<char>(FIRST_GLYPH + i), '\0'};
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+    TTF_GlyphMetrics(font, static_cast<Uint16>(text[0]), &minx, &maxx, &miny,
+                     &maxy, &advance);
+    atlas.advances[i] = advance;
+    atlas.offsets[i] = std::min(minx, 0);
+
+    // Null when there is nothing to draw (a space on some SDL_ttf versions)
+    glyphs[i] = TTF_RenderText_Blended(font, text, WHITE);
+    if (glyphs[i]) {
+      rowHeight = std::max(rowHeight, glyphs[i]->h);
+    }
+  }
+
+  // Shelf-pack into rows of equal height
+  int x = GUTTER;
+  int y = GUTTER;
+  int width = 1;
+  for (int i = 0; i < GLYPH_COUNT; ++i) {
+    if (!glyphs[i]) {
+      continue;
+    }
+    if (x + glyphs[i]->w + GUTTER > ATLAS_ROW_WIDTH) {
+      x = GUTTER;
+      y += rowHeight + GUTTER;
+    }
+    atlas.cells[i] = {x, y, glyphs[i]->w, glyphs[i]->h};
+    x += glyphs[i]->w + GUTTER;
+    width = std::max(width, x);
+  }
+  int height = y + rowHeight + GUTTER;
+
+  bool packed = false;
+  SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                                      SDL_PIXELFORMAT_RGBA32);
+  if (sheet) {
+    for (int row = 0; row < sheet->h; ++row) {
+      std::memset(static_cast<uint8_t *>(sheet->pixels) + row * sheet->pitch,
+                  0, static_cast<size_t>(sheet->w) * 4);
+    }
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+      if (glyphs[i]) {
+        // Copy coverage as is instead of blending it onto the sheet
+        SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+        SDL_Rect dst = atlas.cells[i];
+        SDL_BlitSurface(glyphs[i], nullptr, sheet, &dst);
+      }
+    }
+    atlas.texture = SDL_CreateTextureFromSurface(renderer_, sheet);
+    SDL_FreeSurface(sheet);
+    if (atlas.texture) {
+      SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+      atlas.sheetWidth = width;
+      atlas.sheetHeight = height;
+      packed = true;
+    }
+  }
+
+  for (SDL_Surface *glyph : glyphs) {
+    if (glyph) {
+      SDL_FreeSurface(glyph);
+    }
+  }
+  return packed;
+}
+
+int TextCache::Kerning(TTF_Font *font, char previous, char current) const {
+#ifdef SDL_TTF_VERSION_ATLEAST
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 14)
+  if (previous) {
+    return TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(previous),
+                                        static_cast<Uint16>(current));
+  }
+#endif
+#endif
+  (void)font;
+  (void)previous;
+  (void)current;
+  return 0;
+}
+
+TextCache::Extent TextCache::MeasureGlyphs(TTF_Font *font,
+                                           const GlyphAtlas &atlas,
+                                           const std::string &text) const {
+  int pen = 0;
+  int right = 0;
+  char previous = '\0';
+  for (char c : text) {
+    int i = c - FIRST_GLYPH;
+    pen += Kerning(font, previous, c);
+    right = std::max(right, pen + atlas.offsets[i] + atlas.cells[i].w);
+    pen += atlas.advances[i];
+    previous = c;
+  }
+  return {std::max(pen, right), atlas.height};
+}
+
+void TextCache::DrawGlyphs(TTF_Font *font, const GlyphAtlas &atlas,
+                           const std::string &text, SDL_Color color, int x,
+                           int y) {
+  float invWidth = 1.0f / static_cast<float>(atlas.sheetWidth);
+  float invHeight = 1.0f / static_cast<float>(atlas.sheetHeight);
+
+  vertices_.clear();
+  indices_.clear();
+  int pen = 0;
+  char previous = '\0';
+  for (char c : text) {
+    int i = c - FIRST_GLYPH;
+    pen += Kerning(font, previous, c);
+    const SDL_Rect &cell = atlas.cells[i];
+    if (cell.w > 0) {
+      SDL_Rect dst = {x + pen + atlas.offsets[i], y, cell.w, cell.h};
+      if (geometrySupported_) {
+        float u0 = cell.x * invWidth, u1 = (cell.x + cell.w) * invWidth;
+        float v0 = cell.y * invHeight, v1 = (cell.y + cell.h) * invHeight;
+        float x0 = static_cast<float>(dst.x), x1 = x0 + cell.w;
+        float y0 = static_cast<float>(dst.y), y1 = y0 + cell.h;
+        int base = static_cast<int>(vertices_.size());
+        vertices_.push_back({{x0, y0}, color, {u0, v0}});
+        vertices_.push_back({{x1, y0}, color, {u1, v0}});
+        vertices_.push_back({{x1, y1}, color, {u1, v1}});
+        vertices_.push_back({{x0, y1}, color, {u0, v1}});
+        indices_.insert(indices_.end(),
+                        {base, base + 1, base + 2, base, base + 2, base + 3});
+      } else {
+        SDL_SetTextureColorMod(atlas.texture, color.r, color.g, color.b);
+        SDL_SetTextureAlphaMod(atlas.texture, color.a);
+        SDL_RenderCopy(renderer_, atlas.texture, &cell, &dst);
+      }
+    }
+    pen += atlas.advances[i];
+    previous = c;
+  }
+
+  if (!indices_.empty() &&
+      SDL_RenderGeometry(renderer_, atlas.texture, vertices_.data(),
+                         static_cast<int>(vertices_.size()), indices_.data(),
+                         static_cast<int>(indices_.size())) != 0) {
+    GT_LOG_WARN("Text", "SDL_RenderGeometry failed ({}), drawing glyphs with "
+                        "SDL_RenderCopy",
+                SDL_GetError());
+    geometrySupported_ = false;
+    DrawGlyphs(font, atlas, text, color, x, y);
+  }
+}
+
+// ---- Public ----
+
+TextCache::Extent TextCache::Measure(TTF_Font *font, const std::string &text) {
+  if (!font || text.empty()) {
+    return {};
+  }
+  if (IsAtlasText(text)) {
+    const GlyphAtlas &atlas = AtlasFor(font);
+    if (atlas.texture) {
+      return MeasureGlyphs(font, atlas, text);
+    }
+  }
+  int w = 0, h = 0;
+  TTF_SizeText(font, text.c_str(), &w, &h);
+  return {w, h};
+}
+
+TextCache::Extent TextCache::Draw(TTF_Font *font, const std::string &text,
+                                  SDL_Color color, int x, int y,
+                                  Align align) {
+  if (!font || !renderer_ || text.empty()) {
+    return {};
+  }
+
+  KeyView key{font, text, PackColor(color)};
+  const Entry *entry = Find(key);
+  if (entry) {
+    ++hits_;
+  } else {
+    ++misses_;
+    size_t hash = KeyHash{}(key);
+    if (IsAtlasText(text) && !seen_.count(hash)) {
+      const GlyphAtlas &atlas = AtlasFor(font);
+      if (atlas.texture) {
+        if (seen_.size() >= MAX_SEEN) {
+          seen_.clear();
+        }
+        seen_.insert(hash);
+        Extent extent = MeasureGlyphs(font, atlas, text);
+        if (align == Align::CENTER) {
+          x -= extent.w / 2;
+          y -= extent.h / 2;
+        }
+        DrawGlyphs(font, atlas, text, color, x, y);
+        return extent;
+      }
+    }
+    seen_.erase(hash);
+    entry = Compose(font, text, color);
+    if (!entry) {
+      return {};
+    }
+  }
+
+  Extent extent = entry->extent;
+  if (align == Align::CENTER) {
+    x -= extent.w / 2;
+    y -= extent.h / 2;
+  }
+  SDL_Rect dst = {x, y, extent.w, extent.h};
+  SDL_RenderCopy(renderer_, entry->texture, nullptr, &dst);
+  return extent;
+}
+
+} // namespace GreedyTangle
@@ -0,0 +1,246 @@
+#include "ThreadPool.hpp"
+#include "AllocationTracker.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <string>
+
+namespace GreedyTangle {
+
+namespace {
+// Identifies the pool (and deque) owned by the current thread, if any
+thread_local ThreadPool *tlsPool = nullptr;
+thread_local size_t tlsIndex = 0;
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = DefaultThreadCount();
+  }
+
+  queues_.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  workers_.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    workers_.emplace_back([this, i]() { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    stopping_ = true;
+  }
+  sleepCv_.notify_all();
+
+  // Workers drain every queued task before exiting, so outstanding futures
+  // are always satisfied.
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+size_t ThreadPool::DefaultThreadCount() {
+  // Keep at least two workers so a long background job (benchmark, replay
+  // completion) never blocks the per-move solver tasks.
+  unsigned hw = std::thread::hardware_concurrency();
+  return std::max<size_t>(2, hw);
+}
+
+void ThreadPool::Enqueue(Task task) {
+  size_t index;
+  if (tlsPool == this) {
+    index = tlsIndex;
+  } else {
+    index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  }
+
+  // Count the task before publishing it so a thief can never decrement
+  // the counter past zero.
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    pendingTasks_.fetch_add(1, std::memory_order_release);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  sleepCv_.notify_one();
+}
+
+bool ThreadPool::TryPopLocal(size_t index, Task &out) {
+  WorkerQueue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  out = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::TrySteal(size_t thief, Task &out) {
+  size_t n = queues_.size();
+  for (size_t offset = 1; offset <= n; ++offset) {
+    WorkerQueue &victim = *queues_[(thief + offset) % n];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || victim.tasks.empty()) {
+      continue;
+    }
+    out = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+bool ThreadPool::TakeTask(Task &out) {
+  bool found = TryPopLocal(tlsIndex, out) || TrySteal(tlsIndex, out);
+  if (found) {
+    pendingTasks_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  return found;
+}
+
+size_t ThreadPool::CurrentThreadSlot() const {
+  return tlsPool == this ? tlsIndex : workers_.size();
+}
+
+bool ThreadPool::RunPendingTask() {
+  // Only workers help out; an outside thread (the UI) must never pick up a
+  // long-running job while it waits.
+  if (tlsPool != this) {
+    return false;
+  }
+
+  Task task;
+  if (!TakeTask(task)) {
+    return false;
+  }
+  // Charge the task on its own, not to whatever this thread was waiting on
+  AllocScopeAdopt detach(nullptr);
+  AllocScope jobScope(AllocTag::BACKGROUND_JOB);
+  task();
+  return true;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+  tlsPool = this;
+  tlsIndex = index;
+  GT_TRACE_THREAD_NAME("Worker " + std::to_string(index));
+
+  while (true) {
+    if (RunPendingTask()) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleepCv_.wait(lock, [this]() {
+      return stopping_ || pendingTasks_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_ && pendingTasks_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+void ThreadPool::ParallelFor(size_t begin, size_t end,
+                             const std::function<void(size_t)> &body) {
+  if (begin >= end) {
+    return;
+  }
+
+  size_t count = end - begin;
+  if (count == 1) {
+    body(begin);
+    return;
+  }
+
+  // Shared with the helpers: a helper that only gets scheduled after the
+  // loop has finished sees `closed` and returns without touching `body`,
+  // so the caller never waits on helpers stuck behind long-running jobs.
+  struct LoopState {
+    std::atomic<size_t> next;
+    size_t end = 0;
+    const std::function<void(size_t)> *body = nullptr;
+    std::mutex mutex;
+    std::condition_variable done;
+    int active = 0;
+    bool closed = false;
+    std::exception_ptr error;
+
+    void Drain() {
+      for (size_t i = next.fetch_add(1); i < end; i = next.fetch_add(1)) {
+        (*body)(i);
+      }
+    }
+  };
+
+  auto state = std::make_shared<LoopState>();
+  state->next.store(begin);
+  state->end = end;
+  state->body = &body;
+
+  // Helpers charge their allocations to the caller's scope, which stays
+  // open until every active helper has finished
+  AllocScope *callerScope = AllocScope::Current();
+
+  size_t helpers = std::min(workers_.size(), count - 1);
+  for (size_t h = 0; h < helpers; ++h) {
+    Enqueue([state, callerScope]() {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed) {
+          return;
+        }
+        ++state->active;
+      }
+
+      std::exception_ptr error;
+      try {
+        AllocScopeAdopt adopt(callerScope);
+        state->Drain();
+      } catch (...) {
+        error = std::current_exception();
+        state->next.store(state->end);
+      }
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (error && !state->error) {
+        state->error = error;
+      }
+      if (--state->active == 0) {
+        state->done.notify_all();
+      }
+    });
+  }
+
+  std::exception_ptr error;
+  try {
+    state->Drain();
+  } catch (...) {
+    error = std::current_exception();
+    state->next.store(end);
+  }
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->closed = true;
+  state->done.wait(lock, [&state]() { return state->active == 0; });
+  if (!error) {
+    error = state->error;
+  }
+  lock.unlock();
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace GreedyTangle
@@ -0,0 +1,194 @@
+#include "Trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GreedyTangle {
+
+namespace {
+
+constexpr uint64_t RING_CAPACITY = 1 << 15; // Spans kept per thread
+
+struct SpanSlot {
+  std::atomic<const char *> name{nullptr};
+  std::atomic<const char *> category{nullptr};
+  std::atomic<uint64_t> startNs{0};
+  std::atomic<uint64_t> endNs{0};
+};
+
+// Written only by its owning thread; the dumper validates what it read
+// against head afterwards, seqlock style, and discards overwritten slots.
+// The slots (about 1 MB) are allocated on the thread's first recorded span,
+// so naming a thread or running with tracing off costs only the header.
+struct ThreadRing {
+  uint32_t tid = 0;
+  std::string name;               // Guarded by Registry::mutex
+  std::atomic<uint64_t> head{0};  // Spans ever written on this thread
+  std::atomic<uint64_t> floor{0}; // Spans below this index were cleared
+  std::atomic<SpanSlot *> slots{nullptr}; // Published once allocated
+  std::unique_ptr<SpanSlot[]> storage;    // Owns slots; set by the owner
+};
+
+// Rings outlive their threads so a dump still shows finished workers. The
+// mutex is only taken when a thread first records and when dumping.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadRing>> rings;
+};
+
+Registry &GetRegistry() {
+  // Intentionally leaked: worker threads may still record during shutdown
+  static Registry *registry = new Registry();
+  return *registry;
+}
+
+std::atomic<bool> gEnabled{false};
+const std::chrono::steady_clock::time_point gEpoch =
+    std::chrono::steady_clock::now();
+
+thread_local ThreadRing *tlsRing = nullptr;
+
+ThreadRing &LocalRing() {
+  if (!tlsRing) {
+    auto ring = std::make_unique<ThreadRing>();
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ring->tid = static_cast<uint32_t>(registry.rings.size() + 1);
+    tlsRing = ring.get();
+    registry.rings.push_back(std::move(ring));
+  }
+  return *tlsRing;
+}
+
+struct SpanRecord {
+  const char *name;
+  const char *category;
+  uint64_t startNs;
+  uint64_t endNs;
+};
+
+} // namespace
+
+void Tracer::SetEnabled(bool enabled) {
+  gEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Tracer::IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+uint64_t Tracer::NowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - gEpoch)
+          .count());
+}
+
+void Tracer::SetThreadName(const std::string &name) {
+  ThreadRing &ring = LocalRing();
+  std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+  ring.name = name;
+}
+
+void Tracer::RecordSpan(const char *name, const char *category,
+                        uint64_t startNs, uint64_t endNs) {
+  ThreadRing &ring = LocalRing();
+  if (!ring.storage) {
+    ring.storage = std::make_unique<SpanSlot[]>(RING_CAPACITY);
+    ring.slots.store(ring.storage.get(), std::memory_order_release);
+  }
+  uint64_t index = ring.head.load(std::memory_order_relaxed);
+  SpanSlot &slot = ring.storage[index % RING_CAPACITY];
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.category.store(category, std::memory_order_relaxed);
+  slot.startNs.store(startNs, std::memory_order_relaxed);
+  slot.endNs.store(endNs, std::memory_order_relaxed);
+  ring.head.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::Clear() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto &ring : registry.rings) {
+    ring->floor.store(ring->head.load(std::memory_order_acquire),
+                      std::memory_order_relaxed);
+  }
+}
+
+bool Tracer::WriteJSON(const std::string &path) {
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  out << std::fixed << std::setprecision(3);
+  bool first = true;
+  auto separator = [&]() {
+    if (!first) {
+      out << ",\n";
+    }
+    first = false;
+  };
+
+  std::vector<SpanRecord> spans;
+  for (const auto &ring : registry.rings) {
+    if (!ring->name.empty()) {
+      separator();
+      out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+          << "\"tid\": " << ring->tid << ", \"args\": {\"name\": \""
+          << ring->name << "\"}}";
+    }
+
+    // Copy the live window, then drop anything the owner may have
+    // overwritten while we were reading
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    const SpanSlot *slots = ring->slots.load(std::memory_order_acquire);
+    if (!slots) {
+      continue; // Never recorded
+    }
+    uint64_t begin = ring->floor.load(std::memory_order_relaxed);
+    if (head > RING_CAPACITY && begin < head - RING_CAPACITY) {
+      begin = head - RING_CAPACITY;
+    }
+
+    spans.clear();
+    for (uint64_t i = begin; i < head; ++i) {
+      const SpanSlot &slot = slots[i % RING_CAPACITY];
+      spans.push_back({slot.name.load(std::memory_order_relaxed),
+                       slot.category.load(std::memory_order_relaxed),
+                       slot.startNs.load(std::memory_order_relaxed),
+                       slot.endNs.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t headAfter = ring->head.load(std::memory_order_relaxed);
+    uint64_t validFrom =
+        headAfter + 1 > RING_CAPACITY ? headAfter + 1 - RING_CAPACITY : 0;
+
+    for (uint64_t i = begin; i < head; ++i) {
+      if (i < validFrom) {
+        continue;
+      }
+      const SpanRecord &span = spans[i - begin];
+      if (!span.name) {
+        continue;
+      }
+      separator();
+      out << "{\"name\": \"" << span.name << "\", \"cat\": \""
+          << (span.category ? span.category : "") << "\", \"ph\": \"X\", "
+          << "\"pid\": 1, \"tid\": " << ring->tid
+          << ", \"ts\": " << span.startNs / 1000.0
+          << ", \"dur\": " << (span.endNs - span.startNs) / 1000.0 << "}";
+    }
+  }
+
+  out << "\n]}\n";
+  return static_cast<bool>(out);
+}
+
+} // namespace GreedyTangle